@@ -83,10 +83,11 @@ public:
     Array() = default;
     ~Array() = default;
     constexpr Array(const std::initializer_list<T>& array);
-    constexpr Array(const Array& other);
-    constexpr Array(Array&& other) noexcept;
-    constexpr Array& operator=(const Array& other);
-    constexpr Array& operator=(Array&& other) noexcept;
+    // Копирование по умолчанию: Array<T, N> тривиально копируемый, если T тривиально копируемый (копирование через memcpy)
+    constexpr Array(const Array& other) = default;
+    constexpr Array(Array&& other) noexcept = default;
+    constexpr Array& operator=(const Array& other) = default;
+    constexpr Array& operator=(Array&& other) noexcept = default;
     constexpr bool operator==(const Array& other) const;
     constexpr bool operator!=(const Array& other) const;
     constexpr reference operator[](size_type index);
@@ -130,44 +131,6 @@ constexpr Array<T, N>::Array(const std::initializer_list<T>& array)
     }
 }
 
-template <class T, size_t N>
-constexpr Array<T, N>::Array(const Array& other)
-{
-    for (size_type i = 0; i < N; ++i)
-        _data[i] = other._data[i];
-}
-
-template <class T, size_t N>
-constexpr Array<T, N>::Array(Array&& other) noexcept
-{
-    for (size_type i = 0; i < N; ++i)
-        _data[i] = std::move(other._data[i]);
-}
-
-template <class T, size_t N>
-constexpr Array<T, N>& Array<T, N>::operator=(const Array& other)
-{
-    if (this == &other) // object = object
-        return *this;
-
-    for (size_type i = 0; i < N; ++i)
-        _data[i] = other._data[i];
-    
-    return *this;
-}
-
-template <class T, size_t N>
-constexpr Array<T, N>& Array<T, N>::operator=(Array&& other) noexcept
-{
-    if (this == &other) // object = object
-        return *this;
-    
-    for (size_type i = 0; i < N; ++i)
-        _data[i] = other._data[i];
-    
-    return *this;
-}
-
 template <class T, size_t N>
 constexpr bool Array<T, N>::operator==(const Array& other) const
 {
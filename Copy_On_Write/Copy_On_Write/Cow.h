@@ -0,0 +1,162 @@
+#ifndef Cow_h
+#define Cow_h
+
+#include <atomic>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+/*
+ Cow (copy on write) с интрузивным счетчиком ссылок: счетчик и значение лежат в одном блоке (Control), поэтому одно выделение памяти вместо двух у std::shared_ptr<T>(new T) и указатель 8 байт вместо 16.
+ Чтение (Read, operator*, operator->) доступно только через const и никогда не копирует: читатели в разных потоках работают со своими копиями Cow без блокировок, общий только блок со значением, который не изменяется, пока у него больше одного владельца.
+ Запись только через Write(), который выполняет detach (отделение) и возвращает Writer - доступ на запись, пока Writer жив:
+ - count == 1 (единственный владелец): быстрый путь, одно чтение счетчика без копирования.
+ - count > 1: значение копируется в новый блок, и только потом освобождается ссылка на старый блок.
+ Почему detach корректен в многопоточной среде:
+ - увеличить счетчик можно только копированием Cow, которым уже владеешь, поэтому если этот поток видит count == 1, то никто другой не может стать владельцем блока одновременно (копирование одного и того же объекта Cow при записи в него - гонка данных, как и у std::shared_ptr).
+ - счетчик читается с memory_order_acquire, а освобождение ссылки - fetch_sub с memory_order_acq_rel: все чтения значения бывшими владельцами завершились до того, как этот поток увидит count == 1 и начнет писать.
+ - у copy_on_write из main.cpp use_count() читается без acquire (relaxed), поэтому запись могла начаться раньше, чем завершились чтения другого потока, отпустившего ссылку.
+ - два владельца, одновременно вызвавших Write, оба видят count == 2 и оба копируют: лишняя копия, но не гонка. Последний освободивший старый блок удаляет его.
+ */
+template <typename T>
+class Cow
+{
+    struct Control
+    {
+        std::atomic<size_t> count = 1;
+        size_t writers = 0; // Открытые Writer: блок нельзя разделять, его значение может измениться через выданную ссылку
+        T value;
+        
+        template <typename ...Args>
+        explicit Control(Args&& ...args) : value(std::forward<Args>(args)...) {}
+    };
+
+public:
+    Cow() : _control(new Control()) {}
+    explicit Cow(const T& value) : _control(new Control(value)) {}
+    explicit Cow(T&& value) : _control(new Control(std::move(value))) {}
+    
+    Cow(const Cow& other) : _control(other._control)
+    {
+        if (!_control)
+            return;
+        
+        if (_control->writers > 0) // Значение открыто на запись: копия получает свой снимок, иначе запись через Writer изменила бы и ее
+            _control = new Control(std::as_const(_control->value));
+        else
+            _control->count.fetch_add(1, std::memory_order_relaxed); // Новый владелец появляется только из существующего, поэтому порядок не важен
+    }
+    
+    Cow(Cow&& other) noexcept : _control(std::exchange(other._control, nullptr)) {}
+    
+    ~Cow()
+    {
+        Release(_control);
+    }
+    
+    Cow& operator=(const Cow& other)
+    {
+        if (this == &other) // object = object
+            return *this;
+        
+        Cow tmp(other);
+        Swap(tmp);
+        return *this;
+    }
+    
+    Cow& operator=(Cow&& other) noexcept
+    {
+        if (this == &other) // object = object
+            return *this;
+        
+        Cow tmp(std::move(other));
+        Swap(tmp);
+        return *this;
+    }
+    
+    // Создание значения сразу в блоке Control, без промежуточного T
+    template <typename ...Args>
+    static Cow Make(Args&& ...args)
+    {
+        return Cow(new Control(std::forward<Args>(args)...));
+    }
+    
+    // У Cow, из которого переместили значение (Use_Count() == 0), нет блока Control: чтение и запись бросают исключение, допустимы присваивание и разрушение
+    const T& Read() const
+    {
+        if (!_control)
+            throw std::logic_error("Cow is moved-from");
+        
+        return _control->value;
+    }
+    
+    const T& operator*() const { return Read(); }
+    const T* operator->() const { return &Read(); }
+    
+    /*
+     Доступ на запись на время жизни Writer (как std::lock_guard): пока Writer существует, блок не разделяется - копия Cow получает свой снимок значения, а не ссылку на блок.
+     Ссылки, полученные через Writer, действительны, пока жив Writer и сам Cow; сохранять их дольше нельзя: следующая копия Cow снова разделит блок.
+     */
+    class Writer
+    {
+        friend class Cow;
+        
+        Writer(const Writer&) = delete;
+        Writer(Writer&&) noexcept = delete;
+        Writer& operator=(const Writer&) = delete;
+        Writer& operator=(Writer&&) noexcept = delete;
+        
+        explicit Writer(Control* control) noexcept : _control(control) { ++_control->writers; }
+        
+    public:
+        ~Writer() { --_control->writers; }
+        
+        T& operator*() const noexcept { return _control->value; }
+        T* operator->() const noexcept { return &_control->value; }
+        
+        template <typename Index>
+        decltype(auto) operator[](Index&& index) const { return _control->value[std::forward<Index>(index)]; }
+        
+    private:
+        Control* const _control;
+    };
+    
+    // Доступ на запись: отделение от других владельцев, если они есть. Time: O(1) для единственного владельца, иначе O(копирование T)
+    Writer Write()
+    {
+        if (!_control)
+            throw std::logic_error("Cow is moved-from");
+        
+        if (_control->count.load(std::memory_order_acquire) != 1)
+        {
+            Control* copy = new Control(std::as_const(_control->value)); // Старый блок удерживается нашей ссылкой до конца копирования
+            Release(std::exchange(_control, copy));
+        }
+        return Writer(_control);
+    }
+    
+    bool Unique() const noexcept { return Use_Count() == 1; }
+    size_t Use_Count() const noexcept { return _control ? _control->count.load(std::memory_order_acquire) : 0; }
+    void Swap(Cow& other) noexcept { std::swap(_control, other._control); }
+
+private:
+    explicit Cow(Control* control) noexcept : _control(control) {}
+    
+    static void Release(Control* control) noexcept
+    {
+        if (control && control->count.fetch_sub(1, std::memory_order_acq_rel) == 1)
+            delete control;
+    }
+
+private:
+    Control* _control = nullptr;
+};
+
+using Cow_String = Cow<std::string>;
+
+template <typename T>
+using Cow_Vector = Cow<std::vector<T>>;
+
+#endif /* Cow_h */
@@ -0,0 +1,250 @@
+#ifndef Rcu_Ptr_h
+#define Rcu_Ptr_h
+
+#include <atomic>
+#include <cstdint>
+#include <iostream>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+/*
+ RCU (Read-Copy-Update) - указатель на неизменяемую версию объекта для данных, которые часто читаются и редко изменяются (конфигурация, таблица маршрутов).
+ - Read() - читатель получает Guard и читает текущую версию без блокировок и без счетчика ссылок на объекте.
+ - Update(function) - писатель копирует текущую версию, изменяет копию и атомарно публикует ее (exchange). Читатели, начавшие чтение раньше, дочитывают старую версию.
+ - старая версия удаляется, когда все читатели, которые могли ее видеть, вышли из Guard: epoch-based reclamation (EBR).
+ EBR (Epoch_Domain):
+ - глобальная эпоха увеличивается при каждой публикации, у каждого потока своя запись (Record) с эпохой, в которой он вошел в чтение (0 - не читает).
+ - замененная версия сохраняется в списке retired с номером эпохи публикации и удаляется, когда ни один поток не читает в эпохе <= этого номера.
+ Цена чтения: вход - чтение глобальной эпохи и запись своей эпохи (seq_cst: на x86 одна инструкция xchg), выход - запись 0 (release: обычная запись), в отличии от std::shared_ptr нет атомарного инкремента общей для всех читателей кэш-линии.
+ Писатели сериализуются mutex, т.к. каждый копирует последнюю версию, иначе одно из двух одновременных изменений потеряется.
+ */
+class Epoch_Domain
+{
+    Epoch_Domain(const Epoch_Domain&) = delete;
+    Epoch_Domain(Epoch_Domain&&) noexcept = delete;
+    Epoch_Domain& operator=(const Epoch_Domain&) = delete;
+    Epoch_Domain& operator=(Epoch_Domain&&) noexcept = delete;
+    
+    // Запись потока на отдельной кэш-линии, чтобы читатели разных потоков не мешали друг другу (false sharing)
+    struct alignas(64) Record
+    {
+        std::atomic<uint64_t> epoch = 0; // 0 - поток не читает
+        std::atomic<bool> used = false;  // запись занята живым потоком
+        size_t depth = 0;                // вложенность Guard, доступна только своему потоку
+        Record* next = nullptr;
+    };
+    
+    // Освобождение записи при завершении потока: запись переиспользуется новым потоком
+    struct Local_Record
+    {
+        Record* record = nullptr;
+        
+        ~Local_Record()
+        {
+            if (record)
+                record->used.store(false, std::memory_order_release);
+        }
+    };
+    
+    struct Retired
+    {
+        void* ptr = nullptr;
+        void (*deleter)(void*) = nullptr;
+        uint64_t epoch = 0;
+    };
+    
+    Epoch_Domain() = default;
+
+public:
+    ~Epoch_Domain()
+    {
+        for (auto& retired : _retired) // При завершении программы читателей нет
+            retired.deleter(retired.ptr);
+        
+        for (Record* record = _records.load(); record;)
+        {
+            Record* next = record->next;
+            delete record;
+            record = next;
+        }
+    }
+    
+    static Epoch_Domain& Instance()
+    {
+        static Epoch_Domain domain;
+        return domain;
+    }
+    
+    // Вход в чтение: после этого ни одна видимая версия не будет удалена до Leave
+    void Enter() noexcept
+    {
+        Record* record = Local();
+        if (record->depth++ == 0)
+        {
+            // acquire парный fetch_add в Retire: если прочитана эпоха E + 1, то видна и замена указателя, сделанная до нее, и старая версия (эпоха E) не будет прочитана
+            const uint64_t epoch = _epoch.load(std::memory_order_acquire);
+            record->epoch.store(epoch, std::memory_order_seq_cst); // Запись эпохи должна быть видна писателю раньше, чем поток прочитает указатель
+        }
+    }
+    
+    void Leave() noexcept
+    {
+        Record* record = Local();
+        if (--record->depth == 0)
+            record->epoch.store(0, std::memory_order_release); // Все чтения версии завершены до этой записи
+    }
+    
+    // Отложенное удаление версии, замененной на новую. Вызывается писателем после публикации новой версии
+    template <typename T>
+    void Retire(T* ptr)
+    {
+        std::lock_guard lock(_mutex);
+        _retired.push_back(Retired{ptr, [](void* p) { delete static_cast<T*>(p); }, _epoch.fetch_add(1, std::memory_order_seq_cst)});
+        Reclaim();
+    }
+    
+    // Удаление всех версий, которые уже никто не читает
+    void Reclaim_Now()
+    {
+        std::lock_guard lock(_mutex);
+        Reclaim();
+    }
+    
+    size_t Retired_Count()
+    {
+        std::lock_guard lock(_mutex);
+        return _retired.size();
+    }
+
+private:
+    Record* Local()
+    {
+        thread_local Local_Record local;
+        if (!local.record) [[unlikely]]
+            local.record = Acquire_Record();
+        return local.record;
+    }
+    
+    // Свободная запись из списка или новая запись в начало списка (записи не удаляются до разрушения домена)
+    Record* Acquire_Record()
+    {
+        for (Record* record = _records.load(std::memory_order_acquire); record; record = record->next)
+        {
+            bool used = false;
+            if (!record->used.load(std::memory_order_relaxed) && record->used.compare_exchange_strong(used, true, std::memory_order_acquire))
+                return record;
+        }
+        
+        Record* record = new Record();
+        record->used.store(true, std::memory_order_relaxed);
+        record->next = _records.load(std::memory_order_relaxed);
+        while (!_records.compare_exchange_weak(record->next, record, std::memory_order_release, std::memory_order_relaxed));
+        return record;
+    }
+    
+    // Версия с эпохой публикации e удаляется, если нет читателя, вошедшего в эпоху <= e: такой читатель мог прочитать указатель до публикации
+    void Reclaim()
+    {
+        uint64_t min_epoch = UINT64_MAX;
+        for (Record* record = _records.load(std::memory_order_acquire); record; record = record->next)
+        {
+            const uint64_t epoch = record->epoch.load(std::memory_order_seq_cst);
+            if (epoch != 0 && epoch < min_epoch)
+                min_epoch = epoch;
+        }
+        
+        auto it = _retired.begin();
+        for (; it != _retired.end() && it->epoch < min_epoch; ++it) // Эпохи в _retired возрастают
+            it->deleter(it->ptr);
+        _retired.erase(_retired.begin(), it);
+    }
+
+private:
+    std::atomic<uint64_t> _epoch = 1;
+    std::atomic<Record*> _records = nullptr;
+    std::mutex _mutex; // Защищает _retired
+    std::vector<Retired> _retired;
+};
+
+template <typename T>
+class Rcu_Ptr
+{
+    Rcu_Ptr(const Rcu_Ptr&) = delete;
+    Rcu_Ptr(Rcu_Ptr&&) noexcept = delete;
+    Rcu_Ptr& operator=(const Rcu_Ptr&) = delete;
+    Rcu_Ptr& operator=(Rcu_Ptr&&) noexcept = delete;
+
+public:
+    // Защита версии от удаления на время чтения, должна разрушаться в том же потоке
+    class Guard
+    {
+        friend class Rcu_Ptr;
+        
+        Guard(const Guard&) = delete;
+        Guard& operator=(const Guard&) = delete;
+    
+    public:
+        ~Guard()
+        {
+            Epoch_Domain::Instance().Leave();
+        }
+        
+        const T& operator*() const noexcept { return *_ptr; }
+        const T* operator->() const noexcept { return _ptr; }
+        const T* Get() const noexcept { return _ptr; }
+    
+    private:
+        explicit Guard(const std::atomic<T*>& ptr) noexcept
+        {
+            Epoch_Domain::Instance().Enter();
+            _ptr = ptr.load(std::memory_order_seq_cst);
+        }
+    
+    private:
+        const T* _ptr = nullptr;
+    };
+    
+    template <typename ...Args>
+    explicit Rcu_Ptr(Args&& ...args) : _ptr(new T(std::forward<Args>(args)...)) {}
+    
+    ~Rcu_Ptr()
+    {
+        delete _ptr.load(std::memory_order_acquire); // Читателей уже нет, старые версии удалит Epoch_Domain
+    }
+    
+    Guard Read() const noexcept
+    {
+        return Guard(_ptr);
+    }
+    
+    // Копирование текущей версии, изменение копии function(T&) и публикация
+    template <typename Function>
+    void Update(Function&& function)
+    {
+        std::lock_guard lock(_writer);
+        T* copy = new T(*_ptr.load(std::memory_order_relaxed)); // Писатель один под mutex, версия не изменится
+        std::forward<Function>(function)(*copy);
+        Publish(copy);
+    }
+    
+    // Публикация новой версии без копирования текущей
+    void Store(T value)
+    {
+        std::lock_guard lock(_writer);
+        Publish(new T(std::move(value)));
+    }
+
+private:
+    void Publish(T* ptr)
+    {
+        T* old = _ptr.exchange(ptr, std::memory_order_seq_cst);
+        Epoch_Domain::Instance().Retire(old);
+    }
+
+private:
+    std::atomic<T*> _ptr;
+    std::mutex _writer;
+};
+
+#endif /* Rcu_Ptr_h */
@@ -1,4 +1,13 @@
+#include "Cow.h"
+#include "Rcu_Ptr.h"
+#include "Timer.h"
+
+#include <chrono>
 #include <iostream>
+#include <memory>
+#include <mutex>
+#include <numeric>
+#include <thread>
 
 /*
  Сайты: https://habr.com/ru/companies/oleg-bunin/articles/352280/
@@ -98,6 +107,190 @@ int main()
         
         std::cout << std::endl;
     }
+    // Cow: интрузивный счетчик ссылок, атомарный detach
+    {
+        std::cout << "Cow" << std::endl;
+        std::cout << "sizeof(copy_on_write<std::string>): " << sizeof(copy_on_write<std::string>) << ", sizeof(Cow_String): " << sizeof(Cow_String) << std::endl;
+        
+        const Cow_String cow_string = Cow_String::Make("Test");
+        Cow_String cow_string_copy = cow_string;
+        std::cout << "Use_Count: " << cow_string.Use_Count() << ", same adress: " << (&*cow_string == &*cow_string_copy) << std::endl;
+        
+        cow_string_copy.Write()->append(" text");
+        std::cout << "Content cow_string: " << *cow_string << ", cow_string_copy: " << *cow_string_copy << std::endl;
+        std::cout << "Use_Count: " << cow_string.Use_Count() << ", same adress: " << (&*cow_string == &*cow_string_copy) << std::endl;
+        
+        {
+            auto writer = cow_string_copy.Write();
+            const Cow_String snapshot = cow_string_copy; // Копия во время записи получает свой снимок
+            writer->append("!");
+            std::cout << "Copy during Write: " << *snapshot << ", after write: " << *cow_string_copy << std::endl;
+        }
+        
+        // Рассылка снимка (fan-out): каждый поток-читатель получает свою копию Cow и читает ее без блокировок, пока писатель изменяет свою
+        static constexpr size_t size = 1 << 20;
+        static constexpr size_t readers = 8;
+        static constexpr size_t passes = 8;
+        
+        std::vector<int> data(size);
+        std::iota(data.begin(), data.end(), 0);
+        const Cow_Vector<int> snapshot(data);
+        
+        std::atomic<long long> total = 0;
+        auto Read = [&total](const std::vector<int>& values)
+        {
+            long long sum = 0;
+            for (size_t pass = 0; pass < passes; ++pass)
+                sum += std::accumulate(values.begin(), values.end(), 0LL);
+            total += sum;
+        };
+        
+        Timer timer;
+        timer.start();
+        {
+            std::vector<std::thread> threads;
+            for (size_t i = 0; i < readers; ++i)
+                threads.emplace_back([&]() { const std::vector<int> copy = data; Read(copy); }); // Глубокая копия на каждый поток
+            for (auto& thread : threads)
+                thread.join();
+        }
+        timer.stop();
+        std::cout << "std::vector copy per reader: " << timer.elapsedMilliseconds() << " ms" << std::endl;
+        
+        timer.start();
+        {
+            Cow_Vector<int> writer = snapshot;
+            std::vector<std::thread> threads;
+            for (size_t i = 0; i < readers; ++i)
+                threads.emplace_back([&]() { const Cow_Vector<int> copy = snapshot; Read(*copy); }); // Только ++count
+            
+            writer.Write()[0] = -1; // Один detach, снимки читателей не меняются
+            for (size_t i = 1; i < size; ++i)
+                writer.Write()[i] = -1; // Быстрый путь: writer уже единственный владелец
+            
+            for (auto& thread : threads)
+                thread.join();
+            std::cout << "Writer unique: " << writer.Unique() << ", snapshot[0]: " << (*snapshot)[0] << std::endl;
+        }
+        timer.stop();
+        std::cout << "Cow_Vector snapshot per reader: " << timer.elapsedMilliseconds() << " ms, total: " << total << std::endl;
+        
+        // Быстрый путь записи единственного владельца
+        static constexpr size_t writes = 1 << 24;
+        copy_on_write<std::vector<int>> old_cow(new std::vector<int>(data));
+        timer.start();
+        for (size_t i = 0; i < writes; ++i)
+            (*old_cow)[i & (size - 1)] += 1;
+        timer.stop();
+        std::cout << "copy_on_write writes: " << timer.elapsedMilliseconds() << " ms" << std::endl;
+        
+        Cow_Vector<int> cow(data);
+        timer.start();
+        for (size_t i = 0; i < writes; ++i)
+            cow.Write()[i & (size - 1)] += 1;
+        timer.stop();
+        std::cout << "Cow writes: " << timer.elapsedMilliseconds() << " ms, check: " << ((*old_cow)[0] == (*cow)[0]) << std::endl;
+        
+        std::cout << std::endl;
+    }
+    
+    // Rcu_Ptr: читатели без блокировок, писатель публикует новую версию каждую 1 ms
+    {
+        std::cout << "Rcu_Ptr" << std::endl;
+        
+        struct Config
+        {
+            std::vector<int> values;
+            size_t version = 0;
+        };
+        
+        static constexpr size_t size = 1024;
+        static constexpr size_t readers = 4;
+        static constexpr auto duration = std::chrono::milliseconds(200);
+        static constexpr auto period = std::chrono::milliseconds(1); // 1 kHz
+        
+        Rcu_Ptr<Config> config(Config{std::vector<int>(size, 1), 0});
+        {
+            auto guard = config.Read();
+            config.Update([](Config& value) { value.values[0] = 2; ++value.version; });
+            std::cout << "Guard version: " << guard->version << ", values[0]: " << guard->values[0] << std::endl; // Старая версия жива, пока жив guard
+        }
+        std::cout << "New version: " << config.Read()->version << ", values[0]: " << config.Read()->values[0] << std::endl;
+        
+        std::shared_ptr<const Config> shared = std::make_shared<const Config>(*config.Read());
+        std::mutex shared_mutex;
+        
+        // Чтения в секунду на читателя: без писателя и с писателем
+        auto Run = [&](auto&& read, auto&& write, bool with_writer)
+        {
+            std::atomic<bool> stop = false;
+            std::atomic<size_t> reads = 0;
+            std::atomic<long long> total = 0;
+            std::vector<std::thread> threads;
+            for (size_t i = 0; i < readers; ++i)
+            {
+                threads.emplace_back([&]()
+                {
+                    size_t count = 0;
+                    long long sum = 0;
+                    while (!stop.load(std::memory_order_relaxed))
+                        sum += read(count++ & (size - 1));
+                    reads += count;
+                    total += sum;
+                });
+            }
+            
+            size_t updates = 0;
+            const auto end = std::chrono::steady_clock::now() + duration;
+            while (std::chrono::steady_clock::now() < end)
+            {
+                std::this_thread::sleep_for(period);
+                if (with_writer)
+                {
+                    write();
+                    ++updates;
+                }
+            }
+            stop = true;
+            for (auto& thread : threads)
+                thread.join();
+            
+            const double seconds = std::chrono::duration<double>(duration).count();
+            std::cout << (with_writer ? "  writer 1 kHz: " : "  no writer:    ") << static_cast<long long>(reads / seconds / readers) << " reads/s per reader, updates: " << updates << ", total: " << total << std::endl;
+        };
+        
+        auto rcu_read = [&](size_t index) { return config.Read()->values[index]; };
+        auto rcu_write = [&]() { config.Update([](Config& value) { ++value.values[value.version++ & (size - 1)]; }); };
+        auto shared_read = [&](size_t index)
+        {
+            std::shared_ptr<const Config> copy;
+            {
+                std::lock_guard lock(shared_mutex);
+                copy = shared; // Общий счетчик ссылок и mutex на каждое чтение
+            }
+            return copy->values[index];
+        };
+        auto shared_write = [&]()
+        {
+            auto copy = std::make_shared<Config>(*shared);
+            ++copy->values[copy->version++ & (size - 1)];
+            std::lock_guard lock(shared_mutex);
+            shared = std::move(copy);
+        };
+        
+        std::cout << "Rcu_Ptr:" << std::endl;
+        Run(rcu_read, rcu_write, false);
+        Run(rcu_read, rcu_write, true);
+        std::cout << "Retired versions: " << Epoch_Domain::Instance().Retired_Count();
+        Epoch_Domain::Instance().Reclaim_Now(); // Читатели завершились, все старые версии можно удалить
+        std::cout << ", after Reclaim_Now: " << Epoch_Domain::Instance().Retired_Count() << std::endl;
+        
+        std::cout << "mutex + std::shared_ptr:" << std::endl;
+        Run(shared_read, shared_write, false);
+        Run(shared_read, shared_write, true);
+        
+        std::cout << std::endl;
+    }
     
     return 0;
 }
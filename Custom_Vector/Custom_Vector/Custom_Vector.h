@@ -5,6 +5,7 @@
 
 #include <algorithm>
 #include <iostream>
+#include <span>
 
 
 /*
@@ -57,6 +58,8 @@ public:
     bool Empty() const noexcept;
     size_type Size() const noexcept;
     void Resize(size_type size);
+    void Resize_Default_Init(size_type size); // Resize без заполнения новых элементов тривиальных типов
+    std::span<T> Append_Uninitialized(size_type count); // Добавление count элементов без заполнения, возвращает область для записи
     size_type Capacity() const noexcept;
     void Reserve(size_type capacity);
     void Shrink_To_Fit();
@@ -94,7 +97,7 @@ private:
     }
     
 private:
-    T* _data;
+    T* _data = nullptr;
     size_t _size = 0u;
     size_t _capacity = 0u;
 };
@@ -406,7 +409,7 @@ void Custom_Vector<T>::Resize(size_type size)
 {
     if (size < _size)
     {
-        while (_size < size)
+        while (size < _size)
         {
             _data[_size - 1].~T();
             --_size;
@@ -423,6 +426,42 @@ void Custom_Vector<T>::Resize(size_type size)
     }
 }
 
+// В отличии от Resize новые элементы инициализируются по умолчанию (new (ptr) T, а не new (ptr) T()): для тривиальных типов память не заполняется нулями
+template <class T>
+void Custom_Vector<T>::Resize_Default_Init(size_type size)
+{
+    if (size <= _size)
+    {
+        Resize(size);
+        return;
+    }
+    
+    Reserve(size);
+    if constexpr (std::is_trivially_default_constructible_v<T>)
+    {
+        _size = size;
+    }
+    else
+    {
+        while (_size < size)
+        {
+            new (_data + _size) T;
+            ++_size;
+        }
+    }
+}
+
+// Добавление count элементов в конец без заполнения, емкость растет в 2 раза
+template <class T>
+std::span<T> Custom_Vector<T>::Append_Uninitialized(size_type count)
+{
+    const size_type size = _size;
+    if (_size + count > _capacity)
+        Reserve(std::max(_size + count, _capacity * 2));
+    Resize_Default_Init(_size + count);
+    return std::span<T>(_data + size, count);
+}
+
 template <class T>
 Custom_Vector<T>::size_type Custom_Vector<T>::Capacity() const noexcept
 {
@@ -181,6 +181,13 @@ int main()
         examples_copy[3] = Example(6, "number8");
         auto examples_move = std::move(examples);
         examples_copy.Swap(examples_move);
+        
+        // Буфер под данные, которые будут перезаписаны: без заполнения нулями
+        Custom_Vector<char> buffer;
+        buffer.Resize_Default_Init(16);
+        auto chunk = buffer.Append_Uninitialized(6);
+        std::copy_n("chunk", chunk.size(), chunk.begin());
+        std::cout << "Append_Uninitialized: " << buffer.Data() + 16 << ", size: " << buffer.Size() << std::endl;
     }
     
     // massive
@@ -1,12 +1,21 @@
 #ifndef function_h
 #define function_h
 
+#include <cstddef>
 #include <functional>
 #include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
 
 
 namespace first_implementation
 {
+    /*
+     Small buffer optimization (SBO): функтор размером до buffer_size байт (lambda с 1-3 захваченными указателями/ссылками, bind с парой аргументов) хранится внутри самого function, без выделения памяти в куче.
+     Большие функторы и функторы, перемещение которых может бросить исключение, хранятся в куче.
+     Из-за SBO перемещение function - это перемещение самого функтора (_move), а не обмен указателями.
+     */
     template <typename T>
     class function;
 
@@ -14,45 +23,50 @@ namespace first_implementation
     class function<Result(Args...)>
     {
          using Invoke = Result (*)(void*, Args&&...); // Функтор
-         using Construct = void (*)(void*, void*); // Конструктор
+         using Construct = void (*)(void*, void*); // Конструктор копирования
+         using Move = void (*)(void*, void*); // Конструктор перемещения + деструктор перемещаемого
          using Destroy = void (*)(void*); // Деструктор
         
+        static constexpr size_t buffer_size = 3 * sizeof(void*);
+        
+        template <typename Functor>
+        static constexpr bool is_small = sizeof(Functor) <= buffer_size && alignof(Functor) <= alignof(std::max_align_t) && std::is_nothrow_move_constructible_v<Functor>;
+        
     public:
-        function():
-        _invoke(nullptr),
-        _construct(nullptr),
-        _destroy(nullptr),
-        _data(nullptr),
-        _size(0)
-        {}
+        function() = default;
 
         template <typename Functor>
         function(Functor functor):
         _invoke(reinterpret_cast<Invoke>(invoker<Functor>)),
         _construct(reinterpret_cast<Construct>(constructor<Functor>)),
+        _move(reinterpret_cast<Move>(mover<Functor>)),
         _destroy(reinterpret_cast<Destroy>(destructor<Functor>)),
-        _size(sizeof(Functor)),
-        _data(new char[_size]) // выделение памяти под функтор
+        _size(sizeof(Functor))
         {
-            _construct(_data.get(), reinterpret_cast<char*>(&functor));
+            if constexpr (is_small<Functor>)
+                _data = _buffer;
+            else
+                _data = new char[_size]; // выделение памяти под функтор
+            new (_data) Functor(std::move(functor));
         }
         
         function(const function& other):
         _invoke(other._invoke),
         _construct(other._construct),
+        _move(other._move),
         _destroy(other._destroy),
         _size(other._size)
         {
             if (_invoke)
             {
-                _data.reset(new char[_size]);
-                _construct(_data.get(), other._data.get());
+                _data = other.is_local() ? _buffer : new char[_size];
+                _construct(_data, other._data);
             }
         }
         
         function(function&& other) noexcept
         {
-            other.swap(*this);
+            move_from(other);
         }
 
         function& operator=(const function& other)
@@ -69,43 +83,36 @@ namespace first_implementation
             if (this == &other) // object = object
                 return *this;
             
-            function(std::move(other)).swap(*this);
+            reset();
+            move_from(other);
             return *this;
         }
 
         function& operator=(std::nullptr_t)
         {
-            if (_data)
-            {
-                _size = 0;
-                _destroy(_data.get());
-                _invoke = nullptr;
-                _construct = nullptr;
-                _destroy = nullptr;
-            }
-            
+            reset();
             return *this;
         }
 
         ~function()
         {
-            if (_data)
-                _destroy(_data.get());
+            reset();
         }
         
         void swap(function& other) noexcept
         {
-            std::swap(_invoke, other._invoke);
-            std::swap(_construct, other._construct);
-            std::swap(_destroy, other._destroy);
-            std::swap(_data, other._data);
-            std::swap(_size, other._size);
+            if (this == &other) // object.swap(object)
+                return;
+            
+            function temp(std::move(other));
+            other.move_from(*this);
+            move_from(temp);
         }
 
         Result operator()(Args&&... args)
         {
             if (_invoke)
-                return _invoke(_data.get(), std::forward<Args>(args)...); // Вызов функтора с аргументами
+                return _invoke(_data, std::forward<Args>(args)...); // Вызов функтора с аргументами
             
             return Result();
         }
@@ -113,6 +120,44 @@ namespace first_implementation
         explicit operator bool() const noexcept { return !!_data; }
 
     private:
+        bool is_local() const noexcept { return _data == _buffer; }
+        
+        // Перенос функтора из other (this пустой), other становится пустым
+        void move_from(function& other) noexcept
+        {
+            _invoke = std::exchange(other._invoke, nullptr);
+            _construct = std::exchange(other._construct, nullptr);
+            _move = std::exchange(other._move, nullptr);
+            _destroy = std::exchange(other._destroy, nullptr);
+            _size = std::exchange(other._size, 0);
+            if (other.is_local())
+            {
+                _data = _buffer;
+                _move(_buffer, other._buffer);
+            }
+            else
+            {
+                _data = other._data;
+            }
+            other._data = nullptr;
+        }
+        
+        void reset() noexcept
+        {
+            if (!_data)
+                return;
+            
+            _destroy(_data);
+            if (!is_local())
+                delete[] static_cast<char*>(_data);
+            _invoke = nullptr;
+            _construct = nullptr;
+            _move = nullptr;
+            _destroy = nullptr;
+            _size = 0;
+            _data = nullptr;
+        }
+        
         template <typename Functor>
         static Result invoker(Functor* functor, Args&&... args)
         {
@@ -124,6 +169,13 @@ namespace first_implementation
         {
             new (ptr) Functor(*arg);
         }
+        
+        template <typename Functor>
+        static void mover(Functor* ptr, Functor* arg)
+        {
+            new (ptr) Functor(std::move(*arg));
+            arg->~Functor();
+        }
 
         template <typename Functor>
         static void destructor(Functor* functor)
@@ -133,9 +185,11 @@ namespace first_implementation
 
         Invoke _invoke = nullptr; // Вызов функтора
         Construct _construct = nullptr; // Вызов конструктора
+        Move _move = nullptr; // Перенос функтора из буфера в буфер
         Destroy _destroy = nullptr; // Вызов деструктора вручную, т.к. храним функтор в char[]
         size_t _size = 0;
-        std::unique_ptr<char[]> _data; // Место где будет храниться функтор
+        void* _data = nullptr; // Место где хранится функтор: _buffer или куча
+        alignas(std::max_align_t) char _buffer[buffer_size]; // Место для маленького функтора
     };
 }
 
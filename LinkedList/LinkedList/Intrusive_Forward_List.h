@@ -0,0 +1,356 @@
+#ifndef Intrusive_Forward_List_h
+#define Intrusive_Forward_List_h
+
+#include <cstddef>
+#include <iostream>
+#include <stdexcept>
+#include <utility>
+
+/*
+ Интрузивный односвязный список: связи (Forward_List_Hook) лежат внутри самого объекта T, список не владеет объектами и не выделяет память ни при вставке, ни при удалении.
+ Голова списка - один указатель (8 байт + размер), поэтому список подходит для массивов корзин хэш-таблиц и колес таймеров, где списков много, а большинство пустые.
+ Hook по схеме hlist из ядра Linux: кроме next хранится pprev - адрес указателя, который указывает на этот hook (голова списка или next предыдущего элемента).
+ Поэтому обход только вперед, как у LinkedList, но Erase(T&) - удаление по ссылке на объект за O(1), без поиска предыдущего элемента.
+ Ограничения:
+ - объект должен жить дольше, чем он состоит в списке, и не может быть в двух списках через один hook.
+ - список нельзя копировать (объекты не копируются), можно перемещать.
+ */
+struct Forward_List_Hook
+{
+    Forward_List_Hook* next = nullptr;
+    Forward_List_Hook** pprev = nullptr; // &_head списка или &prev->next
+    
+    bool Is_Linked() const noexcept { return pprev != nullptr; }
+};
+
+template <class T, Forward_List_Hook T::*Hook>
+class Intrusive_Forward_List
+{
+    Intrusive_Forward_List(const Intrusive_Forward_List&) = delete;
+    Intrusive_Forward_List& operator=(const Intrusive_Forward_List&) = delete;
+
+public:
+    class Iterator;
+    friend class Iterator;
+    using Const_Iterator = const Iterator;
+    
+    Intrusive_Forward_List() = default;
+    Intrusive_Forward_List(Intrusive_Forward_List&& other) noexcept;
+    ~Intrusive_Forward_List();
+    Intrusive_Forward_List& operator=(Intrusive_Forward_List&& other) noexcept;
+    void Push_Front(T& value) noexcept;
+    void Pop_Front();
+    T& Front();
+    const T& Front() const;
+    void Swap(Intrusive_Forward_List& other) noexcept;
+    bool Empty() const noexcept;
+    size_t Size() const noexcept;
+    void Reverse() noexcept;
+    void Clear() noexcept; // Отвязывает все объекты, сами объекты не удаляются
+    
+    Iterator Begin() noexcept;
+    Iterator End() noexcept;
+    Const_Iterator Begin() const noexcept;
+    Const_Iterator End() const noexcept;
+    Const_Iterator CBegin() const noexcept;
+    Const_Iterator CEnd() const noexcept;
+    Iterator Iterator_To(T& value) noexcept; // Итератор на объект, который состоит в списке
+    Iterator Insert_After(const Iterator& it, T& value);
+    Iterator Erase_After(const Iterator& it);
+    void Erase(T& value) noexcept; // O(1) по ссылке на объект
+    
+    template <typename U, Forward_List_Hook U::*H>
+    friend std::ostream& operator<<(std::ostream& os, const Intrusive_Forward_List<U, H>& list);
+
+private:
+    // Смещение hook внутри T: переход от hook к объекту (container_of)
+    static T* Owner(Forward_List_Hook* hook) noexcept
+    {
+        return reinterpret_cast<T*>(reinterpret_cast<char*>(hook) - Offset());
+    }
+    
+    static std::ptrdiff_t Offset() noexcept
+    {
+        alignas(T) static const char storage[sizeof(T)] = {};
+        const T* object = reinterpret_cast<const T*>(storage);
+        return reinterpret_cast<const char*>(&(object->*Hook)) - storage;
+    }
+    
+    // Вставка hook на место *link (link - &_head или &prev->next)
+    static void Link(Forward_List_Hook* hook, Forward_List_Hook** link) noexcept
+    {
+        hook->next = *link;
+        hook->pprev = link;
+        if (hook->next)
+            hook->next->pprev = &hook->next;
+        *link = hook;
+    }
+    
+    static void Unlink(Forward_List_Hook* hook) noexcept
+    {
+        *hook->pprev = hook->next;
+        if (hook->next)
+            hook->next->pprev = hook->pprev;
+        hook->next = nullptr;
+        hook->pprev = nullptr; // Is_Linked() == false
+    }
+
+private:
+    Forward_List_Hook* _head = nullptr;
+    size_t _size = 0;
+};
+
+
+template <class T, Forward_List_Hook T::*Hook>
+class Intrusive_Forward_List<T, Hook>::Iterator
+{
+    friend class Intrusive_Forward_List;
+public:
+    Iterator(const Intrusive_Forward_List& list, Forward_List_Hook* hook) :
+    _list(&list),
+    _hook(hook)
+    {
+        
+    }
+    
+    inline Iterator& operator++()
+    {
+        _hook = _hook ? _hook->next : nullptr;
+        return *this;
+    }
+    
+    inline Iterator operator++(int)
+    {
+        Iterator temp = *this;
+        ++(*this);
+        return temp;
+    }
+    
+    inline T& operator*() const
+    {
+        if (!_hook)
+            throw std::runtime_error("iterator is null");
+        return *Owner(_hook);
+    }
+    
+    inline T* operator->() const
+    {
+        return &**this;
+    }
+    
+    inline bool operator==(const Iterator& other) const
+    {
+        return _list == other._list && _hook == other._hook;
+    }
+    
+    inline bool operator!=(const Iterator& other) const
+    {
+        return !(*this == other);
+    }
+
+private:
+    const Intrusive_Forward_List* _list = nullptr;
+    Forward_List_Hook* _hook = nullptr;
+};
+
+
+template <class T, Forward_List_Hook T::*Hook>
+Intrusive_Forward_List<T, Hook>::Intrusive_Forward_List(Intrusive_Forward_List&& other) noexcept
+{
+    Swap(other);
+}
+
+template <class T, Forward_List_Hook T::*Hook>
+Intrusive_Forward_List<T, Hook>::~Intrusive_Forward_List()
+{
+    Clear();
+}
+
+template <class T, Forward_List_Hook T::*Hook>
+Intrusive_Forward_List<T, Hook>& Intrusive_Forward_List<T, Hook>::operator=(Intrusive_Forward_List&& other) noexcept
+{
+    if (this == &other) // object = object
+        return *this;
+    
+    Clear();
+    Swap(other);
+    
+    return *this;
+}
+
+template <class T, Forward_List_Hook T::*Hook>
+void Intrusive_Forward_List<T, Hook>::Push_Front(T& value) noexcept
+{
+    Link(&(value.*Hook), &_head);
+    ++_size;
+}
+
+template <class T, Forward_List_Hook T::*Hook>
+void Intrusive_Forward_List<T, Hook>::Pop_Front()
+{
+    if (Empty())
+        throw std::runtime_error("LinkedList is empty");
+    
+    Unlink(_head);
+    --_size;
+}
+
+template <class T, Forward_List_Hook T::*Hook>
+T& Intrusive_Forward_List<T, Hook>::Front()
+{
+    if (!_head)
+        throw std::runtime_error("LinkedList is null");
+    return *Owner(_head);
+}
+
+template <class T, Forward_List_Hook T::*Hook>
+const T& Intrusive_Forward_List<T, Hook>::Front() const
+{
+    if (!_head)
+        throw std::runtime_error("LinkedList is null");
+    return *Owner(_head);
+}
+
+// pprev первого элемента указывает на _head списка, поэтому после обмена его нужно перенаправить
+template <class T, Forward_List_Hook T::*Hook>
+void Intrusive_Forward_List<T, Hook>::Swap(Intrusive_Forward_List& other) noexcept
+{
+    if (this == &other) // object.Swap(object)
+        return;
+    
+    std::swap(_head, other._head);
+    std::swap(_size, other._size);
+    if (_head)
+        _head->pprev = &_head;
+    if (other._head)
+        other._head->pprev = &other._head;
+}
+
+template <class T, Forward_List_Hook T::*Hook>
+bool Intrusive_Forward_List<T, Hook>::Empty() const noexcept
+{
+    return Size() == 0;
+}
+
+template <class T, Forward_List_Hook T::*Hook>
+size_t Intrusive_Forward_List<T, Hook>::Size() const noexcept
+{
+    return _size;
+}
+
+template <class T, Forward_List_Hook T::*Hook>
+void Intrusive_Forward_List<T, Hook>::Reverse() noexcept
+{
+    Forward_List_Hook* current = _head;
+    Forward_List_Hook* prev = nullptr;
+    while (current)
+    {
+        Forward_List_Hook* next = current->next;
+        current->next = prev;
+        if (prev)
+            prev->pprev = &current->next;
+        prev = current;
+        current = next;
+    }
+    
+    _head = prev;
+    if (_head)
+        _head->pprev = &_head;
+}
+
+template <class T, Forward_List_Hook T::*Hook>
+void Intrusive_Forward_List<T, Hook>::Clear() noexcept
+{
+    while (_head)
+    {
+        Forward_List_Hook* next = _head->next;
+        _head->next = nullptr;
+        _head->pprev = nullptr;
+        _head = next;
+    }
+    
+    _size = 0;
+}
+
+template <class T, Forward_List_Hook T::*Hook>
+Intrusive_Forward_List<T, Hook>::Iterator Intrusive_Forward_List<T, Hook>::Begin() noexcept
+{
+    return Iterator(*this, _head);
+}
+
+template <class T, Forward_List_Hook T::*Hook>
+Intrusive_Forward_List<T, Hook>::Iterator Intrusive_Forward_List<T, Hook>::End() noexcept
+{
+    return Iterator(*this, nullptr);
+}
+
+template <class T, Forward_List_Hook T::*Hook>
+Intrusive_Forward_List<T, Hook>::Const_Iterator Intrusive_Forward_List<T, Hook>::Begin() const noexcept
+{
+    return Const_Iterator(*this, _head);
+}
+
+template <class T, Forward_List_Hook T::*Hook>
+Intrusive_Forward_List<T, Hook>::Const_Iterator Intrusive_Forward_List<T, Hook>::End() const noexcept
+{
+    return Const_Iterator(*this, nullptr);
+}
+
+template <class T, Forward_List_Hook T::*Hook>
+Intrusive_Forward_List<T, Hook>::Const_Iterator Intrusive_Forward_List<T, Hook>::CBegin() const noexcept
+{
+    return Begin();
+}
+
+template <class T, Forward_List_Hook T::*Hook>
+Intrusive_Forward_List<T, Hook>::Const_Iterator Intrusive_Forward_List<T, Hook>::CEnd() const noexcept
+{
+    return End();
+}
+
+template <class T, Forward_List_Hook T::*Hook>
+Intrusive_Forward_List<T, Hook>::Iterator Intrusive_Forward_List<T, Hook>::Iterator_To(T& value) noexcept
+{
+    return Iterator(*this, &(value.*Hook));
+}
+
+template <class T, Forward_List_Hook T::*Hook>
+Intrusive_Forward_List<T, Hook>::Iterator Intrusive_Forward_List<T, Hook>::Insert_After(const Iterator& it, T& value)
+{
+    if (!it._hook)
+        throw std::runtime_error("iterator is empty");
+    
+    Forward_List_Hook* hook = &(value.*Hook);
+    Link(hook, &it._hook->next);
+    ++_size;
+    return Iterator(*this, hook);
+}
+
+template <class T, Forward_List_Hook T::*Hook>
+Intrusive_Forward_List<T, Hook>::Iterator Intrusive_Forward_List<T, Hook>::Erase_After(const Iterator& it)
+{
+    if (!it._hook || !it._hook->next)
+        throw std::runtime_error("iterator is empty");
+    
+    Unlink(it._hook->next);
+    --_size;
+    return Iterator(*this, it._hook->next);
+}
+
+template <class T, Forward_List_Hook T::*Hook>
+void Intrusive_Forward_List<T, Hook>::Erase(T& value) noexcept
+{
+    Unlink(&(value.*Hook));
+    --_size;
+}
+
+template <class U, Forward_List_Hook U::*H>
+std::ostream& operator<<(std::ostream& os, const Intrusive_Forward_List<U, H>& list)
+{
+    for (auto it = list.Begin(); it != list.End(); ++it)
+        os << *it << " ";
+    
+    return os;
+}
+
+#endif /* Intrusive_Forward_List_h */
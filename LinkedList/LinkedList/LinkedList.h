@@ -1,6 +1,7 @@
 #ifndef LinkedList_h
 #define LinkedList_h
 
+#include <functional>
 #include <iostream>
 
 
@@ -61,10 +62,26 @@ public:
     Iterator Insert_After(const Iterator& it, const T& value);
     Iterator Erase_After(const Iterator& it);
     
+    // Алгоритмы перестановкой указателей узлов: без выделения памяти и без копирования T
+    template <class Compare = std::less<>>
+    void Sort(Compare compare = Compare()); // Устойчивая сортировка слиянием снизу вверх (Time: O(n log n), Memory: O(1))
+    template <class Compare = std::less<>>
+    void Merge(LinkedList& other, Compare compare = Compare()); // Слияние двух отсортированных списков, other становится пустым (Time: O(n + m))
+    void Splice_After(const Iterator& pos, LinkedList& other); // Перенос всего other после pos (Time: O(m) - поиск последнего узла other)
+    void Splice_After(const Iterator& pos, LinkedList& other, const Iterator& it); // Перенос узла, следующего за it (Time: O(1))
+    void Splice_After(const Iterator& pos, LinkedList& other, const Iterator& first, const Iterator& last); // Перенос (first, last) (Time: O(last - first) - поиск последнего узла диапазона)
+    size_t Unique(); // Удаление подряд идущих равных элементов, возвращает количество удаленных
+    template <class Predicate>
+    size_t Remove_If(Predicate predicate);
+    
     template <typename U>
     friend std::ostream& operator<<(std::ostream &os, const LinkedList<U>& list);
     
 private:
+    template <class Compare>
+    static Node* Merge_Chains(Node* first, Node* second, Compare& compare);
+    void Link_After(Node* pos, Node* first, Node* last) noexcept;
+    
     void Copy(const LinkedList& other)
     {
         Node* top_other = other._node;
@@ -420,6 +437,188 @@ LinkedList<T>::Iterator LinkedList<T>::Erase_After(const Iterator& it)
     return Iterator(*this, it._node->next);
 }
 
+// Двоичный счетчик из отсортированных цепочек: в bins[i] цепочка из 2^i узлов или пусто. Каждый узел отцепляется и сливается с bins[0], bins[1], ... как перенос разряда при инкременте.
+template <class T>
+template <class Compare>
+void LinkedList<T>::Sort(Compare compare)
+{
+    if (_size < 2)
+        return;
+    
+    Node* bins[64] = {};
+    size_t fill = 0;
+    for (Node* node = _node; node;)
+    {
+        Node* carry = node;
+        node = node->next;
+        carry->next = nullptr;
+        
+        size_t i = 0;
+        for (; i < fill && bins[i]; ++i)
+        {
+            carry = Merge_Chains(bins[i], carry, compare); // В bins[i] более ранние элементы, поэтому он первый: устойчивость
+            bins[i] = nullptr;
+        }
+        bins[i] = carry;
+        if (i == fill)
+            ++fill;
+    }
+    
+    Node* result = nullptr;
+    for (size_t i = 0; i < fill; ++i)
+    {
+        if (bins[i])
+            result = result ? Merge_Chains(bins[i], result, compare) : bins[i];
+    }
+    _node = result;
+}
+
+template <class T>
+template <class Compare>
+void LinkedList<T>::Merge(LinkedList& other, Compare compare)
+{
+    if (this == &other || other.Empty())
+        return;
+    
+    _node = Merge_Chains(_node, std::exchange(other._node, nullptr), compare);
+    _size += std::exchange(other._size, 0);
+}
+
+template <class T>
+void LinkedList<T>::Splice_After(const Iterator& pos, LinkedList& other)
+{
+    if (this == &other || other.Empty())
+        return;
+    
+    Node* last = other._node;
+    while (last->next)
+        last = last->next;
+    
+    Link_After(pos._node, std::exchange(other._node, nullptr), last);
+    _size += std::exchange(other._size, 0);
+}
+
+template <class T>
+void LinkedList<T>::Splice_After(const Iterator& pos, LinkedList& other, const Iterator& it)
+{
+    if (!it._node || !it._node->next)
+        throw std::runtime_error("iterator is empty");
+    
+    Node* node = it._node->next;
+    if (pos._node == it._node || pos._node == node) // Узел уже на месте
+        return;
+    
+    it._node->next = node->next;
+    --other._size;
+    Link_After(pos._node, node, node);
+    ++_size;
+}
+
+template <class T>
+void LinkedList<T>::Splice_After(const Iterator& pos, LinkedList& other, const Iterator& first, const Iterator& last)
+{
+    if (!first._node)
+        throw std::runtime_error("iterator is empty");
+    
+    Node* begin = first._node->next;
+    if (begin == last._node)
+        return;
+    
+    size_t count = 1;
+    Node* end = begin; // Последний переносимый узел
+    for (; end->next != last._node; end = end->next)
+        ++count;
+    
+    first._node->next = last._node;
+    other._size -= count;
+    Link_After(pos._node, begin, end);
+    _size += count;
+}
+
+template <class T>
+size_t LinkedList<T>::Unique()
+{
+    if (!_node)
+        return 0;
+    
+    size_t removed = 0;
+    for (Node* node = _node; node->next;)
+    {
+        Node* next = node->next;
+        if (next->value == node->value)
+        {
+            node->next = next->next;
+            delete next;
+            ++removed;
+        }
+        else
+        {
+            node = next;
+        }
+    }
+    
+    _size -= removed;
+    return removed;
+}
+
+template <class T>
+template <class Predicate>
+size_t LinkedList<T>::Remove_If(Predicate predicate)
+{
+    size_t removed = 0;
+    for (Node** link = &_node; *link;) // link - указатель на поле next предыдущего узла (или на _node), поэтому у начала списка нет отдельной ветки
+    {
+        Node* node = *link;
+        if (predicate(node->value))
+        {
+            *link = node->next;
+            delete node;
+            ++removed;
+        }
+        else
+        {
+            link = &node->next;
+        }
+    }
+    
+    _size -= removed;
+    return removed;
+}
+
+// Слияние двух отсортированных цепочек, при равенстве первым идет узел из first
+template <class T>
+template <class Compare>
+LinkedList<T>::Node* LinkedList<T>::Merge_Chains(Node* first, Node* second, Compare& compare)
+{
+    Node* result = nullptr;
+    Node** tail = &result;
+    while (first && second)
+    {
+        if (compare(second->value, first->value))
+        {
+            *tail = second;
+            second = second->next;
+        }
+        else
+        {
+            *tail = first;
+            first = first->next;
+        }
+        tail = &(*tail)->next;
+    }
+    *tail = first ? first : second;
+    return result;
+}
+
+// Вставка цепочки [first, last] после pos, pos == nullptr - в начало
+template <class T>
+void LinkedList<T>::Link_After(Node* pos, Node* first, Node* last) noexcept
+{
+    Node*& link = pos ? pos->next : _node;
+    last->next = link;
+    link = first;
+}
+
 template <class U>
 std::ostream& operator<<(std::ostream &os, const LinkedList<U>& list)
 {
@@ -1,6 +1,11 @@
+#include "Intrusive_Forward_List.h"
 #include "LinkedList.h"
+#include "Timer.h"
 
+#include <algorithm>
+#include <random>
 #include <string>
+#include <vector>
 
 /*
  Сайты:
@@ -37,6 +42,18 @@ private:
     std::string _str;
 };
 
+// Таймер живет в пуле, в колесе таймеров состоит в списке своей корзины
+struct Timer_Task
+{
+    int id = 0;
+    long long deadline = 0;
+    Forward_List_Hook hook;
+    
+    friend std::ostream& operator<<(std::ostream& os, const Timer_Task& task) { return os << task.id; }
+};
+
+using Timer_Bucket = Intrusive_Forward_List<Timer_Task, &Timer_Task::hook>;
+
 
 int main()
 {
@@ -113,5 +130,172 @@ int main()
         std::cout << *it;
     std::cout << std::endl;
     
+    // Intrusive_Forward_List: связи внутри объекта, без выделения памяти
+    {
+        std::vector<Timer_Task> tasks(5);
+        Timer_Bucket bucket;
+        for (size_t i = 0; i < tasks.size(); ++i)
+        {
+            tasks[i].id = static_cast<int>(i);
+            bucket.Push_Front(tasks[i]);
+        }
+        
+        bucket.Erase(tasks[2]); // Отмена таймера за O(1) по ссылке, без поиска предыдущего
+        bucket.Insert_After(bucket.Iterator_To(tasks[0]), tasks[2]);
+        std::cout << "Intrusive_Forward_List: " << bucket << "sizeof: " << sizeof(Timer_Bucket) << std::endl;
+        bucket.Reverse();
+        std::cout << "reverse: " << bucket << std::endl;
+        bucket.Clear();
+        
+        // Оборот стека: LinkedList выделяет и освобождает узел на каждую операцию, Intrusive_Forward_List только переставляет указатели
+        static constexpr size_t window = 1024;
+        static constexpr size_t operations = 1 << 22;
+        
+        std::vector<Timer_Task> pool(window);
+        LinkedList<Timer_Task*> linked_list;
+        for (auto& task : pool)
+        {
+            linked_list.Push_Front(&task);
+            bucket.Push_Front(task);
+        }
+        
+        Timer timer;
+        timer.start();
+        for (size_t i = 0; i < operations; ++i)
+        {
+            Timer_Task* task = linked_list.Front();
+            linked_list.Pop_Front();
+            ++task->deadline;
+            linked_list.Push_Front(task);
+        }
+        timer.stop();
+        std::cout << "LinkedList<Timer_Task*> churn: " << timer.elapsedMilliseconds() << " ms" << std::endl;
+        
+        timer.start();
+        for (size_t i = 0; i < operations; ++i)
+        {
+            Timer_Task& task = bucket.Front();
+            bucket.Pop_Front();
+            ++task.deadline;
+            bucket.Push_Front(task);
+        }
+        timer.stop();
+        std::cout << "Intrusive_Forward_List churn: " << timer.elapsedMilliseconds() << " ms" << std::endl;
+        
+        // Отмена произвольного таймера: в LinkedList нужен поиск предыдущего узла
+        timer.start();
+        for (size_t i = 0; i < operations; ++i)
+        {
+            Timer_Task& task = pool[(i * 7919) % window];
+            bucket.Erase(task);
+            bucket.Push_Front(task);
+        }
+        timer.stop();
+        std::cout << "Intrusive_Forward_List Erase(T&) + Push_Front: " << timer.elapsedMilliseconds() << " ms, size: " << bucket.Size() << std::endl;        bucket.Clear(); // pool разрушается раньше bucket: объекты нужно отсоединить заранее
+    }
+    
+    // Sort, Merge, Splice_After, Unique, Remove_If: перестановка узлов против копирования в вектор и пересборки списка
+    {
+        LinkedList<int> small = {5, 1, 4, 1, 3, 5, 2};
+        small.Sort();
+        std::cout << "Sort: " << small << std::endl;
+        small.Unique();
+        std::cout << "Unique: " << small << std::endl;
+        LinkedList<int> other = {6, 0}; // Конструктор из initializer_list добавляет через Push_Front: список 0 6
+        small.Merge(other);
+        std::cout << "Merge: " << small << std::endl;
+        small.Remove_If([](int value) { return value % 2 == 0; });
+        std::cout << "Remove_If(even): " << small << std::endl;
+        other.Push_Front(-1);
+        other.Splice_After(other.Begin(), small, small.Begin(), small.End());
+        std::cout << "Splice_After: " << small << "| " << other << std::endl;
+        
+        static constexpr size_t count = 10'000'000;
+        std::mt19937 random(42);
+        std::vector<int> values(count);
+        for (auto& value : values)
+            value = static_cast<int>(random() % (count / 4)); // Есть повторы для Unique
+        
+        // Push_Front добавляет в начало, поэтому список собирается с конца source
+        auto Fill = [](LinkedList<int>& list, const std::vector<int>& source)
+        {
+            list.Clear();
+            for (auto it = source.rbegin(); it != source.rend(); ++it)
+                list.Push_Front(*it);
+        };
+        
+        // Узлы двух списков выделяются по очереди, чтобы раскладка в памяти (и промахи кэша при обходе) была одинаковой
+        auto Fill_Both = [](LinkedList<int>& first, LinkedList<int>& second, const std::vector<int>& source)
+        {
+            first.Clear();
+            second.Clear();
+            for (auto it = source.rbegin(); it != source.rend(); ++it)
+            {
+                first.Push_Front(*it);
+                second.Push_Front(*it);
+            }
+        };
+        
+        // Старый способ: копия в вектор, алгоритм над вектором, пересборка списка (освобождение и выделение каждого узла)
+        auto To_Vector = [](const LinkedList<int>& list)
+        {
+            std::vector<int> result;
+            for (auto it = list.Begin(); it != list.End(); ++it)
+                result.push_back(*it);
+            return result;
+        };
+        
+        Timer timer;
+        auto Measure = [&timer](const char* name, auto&& rebuild, auto&& in_place)
+        {
+            timer.start();
+            rebuild();
+            timer.stop();
+            const double copy = timer.elapsedMilliseconds();
+            
+            timer.start();
+            in_place();
+            timer.stop();
+            std::cout << name << ": copy + rebuild " << copy << " ms, in place " << timer.elapsedMilliseconds() << " ms" << std::endl;
+        };
+        
+        std::vector<int> sorted_values = values;
+        std::sort(sorted_values.begin(), sorted_values.end());
+        
+        LinkedList<int> list, expected;
+        Fill_Both(list, expected, values);
+        Measure("Sort", [&]() { auto copy = To_Vector(expected); std::stable_sort(copy.begin(), copy.end()); Fill(expected, copy); }, [&]() { list.Sort(); });
+        std::cout << "equal: " << (list == expected) << std::endl;
+        
+        // После Sort узлы list разбросаны по памяти, а expected собран заново подряд: для честного сравнения остальные алгоритмы начинают с одинаково собранных списков
+        Fill_Both(list, expected, sorted_values);
+        Measure("Unique", [&]() { auto copy = To_Vector(expected); copy.erase(std::unique(copy.begin(), copy.end()), copy.end()); Fill(expected, copy); }, [&]() { list.Unique(); });
+        Measure("Remove_If", [&]() { auto copy = To_Vector(expected); copy.erase(std::remove_if(copy.begin(), copy.end(), [](int value) { return value % 3 == 0; }), copy.end()); Fill(expected, copy); },
+                [&]() { list.Remove_If([](int value) { return value % 3 == 0; }); });
+        std::cout << "equal: " << (list == expected) << ", size: " << list.Size() << std::endl;
+        
+        LinkedList<int> second, expected_second;
+        Fill_Both(list, expected, sorted_values);
+        Fill_Both(second, expected_second, sorted_values);
+        Measure("Merge", [&]() { auto copy = To_Vector(expected); auto copy_second = To_Vector(expected_second); std::vector<int> merged(copy.size() + copy_second.size());
+                                 std::merge(copy.begin(), copy.end(), copy_second.begin(), copy_second.end(), merged.begin()); Fill(expected, merged); expected_second.Clear(); },
+                [&]() { list.Merge(second); });
+        std::cout << "equal: " << (list == expected) << ", size: " << list.Size() << std::endl;
+        
+        // Перенос второй половины в другой список: у односвязного списка диапазон (first, last) и поиск его последнего узла - O(длины диапазона)
+        Fill_Both(list, expected, sorted_values);
+        second.Clear();
+        expected_second.Clear();
+        second.Push_Front(-1);
+        expected_second.Push_Front(-1);
+        auto middle = list.Begin();
+        auto expected_middle = expected.Begin();
+        for (size_t i = 1; i < count / 2; ++i, ++middle, ++expected_middle);
+        Measure("Splice_After", [&]() { auto copy = To_Vector(expected); Fill(expected, std::vector<int>(copy.begin(), copy.begin() + count / 2));
+                                        copy.erase(copy.begin(), copy.begin() + count / 2); copy.insert(copy.begin(), -1); Fill(expected_second, copy); },
+                [&]() { second.Splice_After(second.Begin(), list, middle, list.End()); });
+        std::cout << "equal: " << (list == expected && second == expected_second) << ", sizes: " << list.Size() << " " << second.Size() << std::endl;
+    }
+    
     return 0;
 }
@@ -0,0 +1,406 @@
+#ifndef Intrusive_List_h
+#define Intrusive_List_h
+
+#include <cstddef>
+#include <iostream>
+#include <stdexcept>
+#include <utility>
+
+/*
+ Интрузивный двусвязный список: связи (List_Hook) лежат внутри самого объекта T, список не владеет объектами и не выделяет память ни при вставке, ни при удалении.
+ Объект может одновременно состоять в нескольких списках, если у него несколько hook (например, соединение в списке всех соединений и в списке ожидающих таймаута).
+ Список кольцевой с фиктивным узлом (_head) внутри самого списка, поэтому у вставки и удаления нет веток для начала/конца списка, а End() - это &_head.
+ Erase(T&) - удаление по ссылке на объект за O(1): соседи берутся из его hook, искать объект в списке не нужно.
+ Ограничения:
+ - объект должен жить дольше, чем он состоит в списке, и не может быть в двух списках через один hook.
+ - список нельзя копировать (объекты не копируются), можно перемещать.
+ */
+struct List_Hook
+{
+    List_Hook* prev = nullptr;
+    List_Hook* next = nullptr;
+    
+    bool Is_Linked() const noexcept { return next != nullptr; }
+};
+
+template <class T, List_Hook T::*Hook>
+class Intrusive_List
+{
+    Intrusive_List(const Intrusive_List&) = delete;
+    Intrusive_List& operator=(const Intrusive_List&) = delete;
+
+public:
+    class Iterator;
+    friend class Iterator;
+    using Const_Iterator = const Iterator;
+    
+    Intrusive_List() noexcept;
+    Intrusive_List(Intrusive_List&& other) noexcept;
+    ~Intrusive_List();
+    Intrusive_List& operator=(Intrusive_List&& other) noexcept;
+    void Push_Front(T& value) noexcept;
+    void Push_Back(T& value) noexcept;
+    void Pop_Front();
+    void Pop_Back();
+    T& Front();
+    T& Back();
+    const T& Front() const;
+    const T& Back() const;
+    void Swap(Intrusive_List& other) noexcept;
+    bool Empty() const noexcept;
+    size_t Size() const noexcept;
+    void Reverse() noexcept;
+    void Clear() noexcept; // Отвязывает все объекты, сами объекты не удаляются
+    
+    Iterator Begin() noexcept;
+    Iterator End() noexcept;
+    Const_Iterator Begin() const noexcept;
+    Const_Iterator End() const noexcept;
+    Const_Iterator CBegin() const noexcept;
+    Const_Iterator CEnd() const noexcept;
+    Iterator Iterator_To(T& value) noexcept; // Итератор на объект, который состоит в списке
+    Iterator Insert(const Iterator& it, T& value) noexcept; // Вставка перед it
+    Iterator Erase(const Iterator& it);
+    Iterator Erase(T& value) noexcept; // O(1) по ссылке на объект
+    
+    template <typename U, List_Hook U::*H>
+    friend std::ostream& operator<<(std::ostream& os, const Intrusive_List<U, H>& list);
+
+private:
+    // Смещение hook внутри T: переход от hook к объекту (container_of)
+    static T* Owner(List_Hook* hook) noexcept
+    {
+        return reinterpret_cast<T*>(reinterpret_cast<char*>(hook) - Offset());
+    }
+    
+    static std::ptrdiff_t Offset() noexcept
+    {
+        alignas(T) static const char storage[sizeof(T)] = {};
+        const T* object = reinterpret_cast<const T*>(storage);
+        return reinterpret_cast<const char*>(&(object->*Hook)) - storage;
+    }
+    
+    static void Link(List_Hook* hook, List_Hook* next) noexcept;
+    static void Unlink(List_Hook* hook) noexcept;
+
+private:
+    List_Hook _head; // Фиктивный узел: _head.next - первый элемент, _head.prev - последний
+    size_t _size = 0;
+};
+
+
+template <class T, List_Hook T::*Hook>
+class Intrusive_List<T, Hook>::Iterator
+{
+    friend class Intrusive_List;
+public:
+    Iterator(const Intrusive_List& list, List_Hook* hook) :
+    _list(&list),
+    _hook(hook)
+    {
+        
+    }
+    
+    inline Iterator& operator++()
+    {
+        _hook = _hook->next;
+        return *this;
+    }
+    
+    inline Iterator operator++(int)
+    {
+        Iterator temp = *this;
+        ++(*this);
+        return temp;
+    }
+    
+    inline Iterator& operator--()
+    {
+        _hook = _hook->prev;
+        return *this;
+    }
+    
+    inline Iterator operator--(int)
+    {
+        Iterator temp = *this;
+        --(*this);
+        return temp;
+    }
+    
+    inline T& operator*() const
+    {
+        if (_hook == &_list->_head)
+            throw std::runtime_error("iterator is end");
+        return *Owner(_hook);
+    }
+    
+    inline T* operator->() const
+    {
+        return &**this;
+    }
+    
+    inline bool operator==(const Iterator& other) const
+    {
+        return _hook == other._hook;
+    }
+    
+    inline bool operator!=(const Iterator& other) const
+    {
+        return _hook != other._hook;
+    }
+
+private:
+    const Intrusive_List* _list = nullptr;
+    List_Hook* _hook = nullptr;
+};
+
+
+template <class T, List_Hook T::*Hook>
+Intrusive_List<T, Hook>::Intrusive_List() noexcept
+{
+    _head.prev = _head.next = &_head;
+}
+
+template <class T, List_Hook T::*Hook>
+Intrusive_List<T, Hook>::Intrusive_List(Intrusive_List&& other) noexcept : Intrusive_List()
+{
+    Swap(other);
+}
+
+template <class T, List_Hook T::*Hook>
+Intrusive_List<T, Hook>::~Intrusive_List()
+{
+    Clear();
+}
+
+template <class T, List_Hook T::*Hook>
+Intrusive_List<T, Hook>& Intrusive_List<T, Hook>::operator=(Intrusive_List&& other) noexcept
+{
+    if (this == &other) // object = object
+        return *this;
+    
+    Clear();
+    Swap(other);
+    
+    return *this;
+}
+
+template <class T, List_Hook T::*Hook>
+void Intrusive_List<T, Hook>::Push_Front(T& value) noexcept
+{
+    Link(&(value.*Hook), _head.next);
+    ++_size;
+}
+
+template <class T, List_Hook T::*Hook>
+void Intrusive_List<T, Hook>::Push_Back(T& value) noexcept
+{
+    Link(&(value.*Hook), &_head);
+    ++_size;
+}
+
+template <class T, List_Hook T::*Hook>
+void Intrusive_List<T, Hook>::Pop_Front()
+{
+    if (Empty())
+        throw std::runtime_error("List is empty");
+    
+    Unlink(_head.next);
+    --_size;
+}
+
+template <class T, List_Hook T::*Hook>
+void Intrusive_List<T, Hook>::Pop_Back()
+{
+    if (Empty())
+        throw std::runtime_error("List is empty");
+    
+    Unlink(_head.prev);
+    --_size;
+}
+
+template <class T, List_Hook T::*Hook>
+T& Intrusive_List<T, Hook>::Front()
+{
+    if (Empty())
+        throw std::runtime_error("List is empty");
+    return *Owner(_head.next);
+}
+
+template <class T, List_Hook T::*Hook>
+T& Intrusive_List<T, Hook>::Back()
+{
+    if (Empty())
+        throw std::runtime_error("List is empty");
+    return *Owner(_head.prev);
+}
+
+template <class T, List_Hook T::*Hook>
+const T& Intrusive_List<T, Hook>::Front() const
+{
+    if (Empty())
+        throw std::runtime_error("List is empty");
+    return *Owner(_head.next);
+}
+
+template <class T, List_Hook T::*Hook>
+const T& Intrusive_List<T, Hook>::Back() const
+{
+    if (Empty())
+        throw std::runtime_error("List is empty");
+    return *Owner(_head.prev);
+}
+
+// Соседи первого и последнего элемента указывают на _head, поэтому после обмена их нужно перенаправить
+template <class T, List_Hook T::*Hook>
+void Intrusive_List<T, Hook>::Swap(Intrusive_List& other) noexcept
+{
+    if (this == &other) // object.Swap(object)
+        return;
+    
+    std::swap(_head, other._head);
+    std::swap(_size, other._size);
+    for (Intrusive_List* list : {this, &other})
+    {
+        if (list->_size == 0)
+            list->_head.prev = list->_head.next = &list->_head;
+        else
+            list->_head.next->prev = list->_head.prev->next = &list->_head;
+    }
+}
+
+template <class T, List_Hook T::*Hook>
+bool Intrusive_List<T, Hook>::Empty() const noexcept
+{
+    return Size() == 0;
+}
+
+template <class T, List_Hook T::*Hook>
+size_t Intrusive_List<T, Hook>::Size() const noexcept
+{
+    return _size;
+}
+
+template <class T, List_Hook T::*Hook>
+void Intrusive_List<T, Hook>::Reverse() noexcept
+{
+    List_Hook* hook = &_head;
+    do
+    {
+        std::swap(hook->prev, hook->next);
+        hook = hook->prev; // Бывший next
+    } while (hook != &_head);
+}
+
+template <class T, List_Hook T::*Hook>
+void Intrusive_List<T, Hook>::Clear() noexcept
+{
+    for (List_Hook* hook = _head.next; hook != &_head;)
+    {
+        List_Hook* next = hook->next;
+        hook->prev = hook->next = nullptr;
+        hook = next;
+    }
+    
+    _head.prev = _head.next = &_head;
+    _size = 0;
+}
+
+template <class T, List_Hook T::*Hook>
+Intrusive_List<T, Hook>::Iterator Intrusive_List<T, Hook>::Begin() noexcept
+{
+    return Iterator(*this, _head.next);
+}
+
+template <class T, List_Hook T::*Hook>
+Intrusive_List<T, Hook>::Iterator Intrusive_List<T, Hook>::End() noexcept
+{
+    return Iterator(*this, &_head);
+}
+
+template <class T, List_Hook T::*Hook>
+Intrusive_List<T, Hook>::Const_Iterator Intrusive_List<T, Hook>::Begin() const noexcept
+{
+    return Const_Iterator(*this, _head.next);
+}
+
+template <class T, List_Hook T::*Hook>
+Intrusive_List<T, Hook>::Const_Iterator Intrusive_List<T, Hook>::End() const noexcept
+{
+    return Const_Iterator(*this, const_cast<List_Hook*>(&_head));
+}
+
+template <class T, List_Hook T::*Hook>
+Intrusive_List<T, Hook>::Const_Iterator Intrusive_List<T, Hook>::CBegin() const noexcept
+{
+    return Begin();
+}
+
+template <class T, List_Hook T::*Hook>
+Intrusive_List<T, Hook>::Const_Iterator Intrusive_List<T, Hook>::CEnd() const noexcept
+{
+    return End();
+}
+
+template <class T, List_Hook T::*Hook>
+Intrusive_List<T, Hook>::Iterator Intrusive_List<T, Hook>::Iterator_To(T& value) noexcept
+{
+    return Iterator(*this, &(value.*Hook));
+}
+
+template <class T, List_Hook T::*Hook>
+Intrusive_List<T, Hook>::Iterator Intrusive_List<T, Hook>::Insert(const Iterator& it, T& value) noexcept
+{
+    List_Hook* hook = &(value.*Hook);
+    Link(hook, it._hook);
+    ++_size;
+    return Iterator(*this, hook);
+}
+
+template <class T, List_Hook T::*Hook>
+Intrusive_List<T, Hook>::Iterator Intrusive_List<T, Hook>::Erase(const Iterator& it)
+{
+    if (it._hook == &_head)
+        throw std::runtime_error("iterator is end");
+    
+    return Erase(*Owner(it._hook));
+}
+
+template <class T, List_Hook T::*Hook>
+Intrusive_List<T, Hook>::Iterator Intrusive_List<T, Hook>::Erase(T& value) noexcept
+{
+    List_Hook* hook = &(value.*Hook);
+    List_Hook* next = hook->next;
+    Unlink(hook);
+    --_size;
+    return Iterator(*this, next);
+}
+
+// Вставка hook перед next
+template <class T, List_Hook T::*Hook>
+void Intrusive_List<T, Hook>::Link(List_Hook* hook, List_Hook* next) noexcept
+{
+    hook->next = next;
+    hook->prev = next->prev;
+    next->prev->next = hook;
+    next->prev = hook;
+}
+
+template <class T, List_Hook T::*Hook>
+void Intrusive_List<T, Hook>::Unlink(List_Hook* hook) noexcept
+{
+    hook->prev->next = hook->next;
+    hook->next->prev = hook->prev;
+    hook->prev = hook->next = nullptr; // Is_Linked() == false
+}
+
+template <class U, List_Hook U::*H>
+std::ostream& operator<<(std::ostream& os, const Intrusive_List<U, H>& list)
+{
+    for (auto it = list.Begin(); it != list.End(); ++it)
+        os << *it << " ";
+    
+    return os;
+}
+
+#endif /* Intrusive_List_h */
@@ -1,6 +1,7 @@
 #ifndef List_h
 #define List_h
 
+#include <functional>
 #include <iostream>
 
 /*
@@ -72,10 +73,29 @@ public:
     Iterator Erase(const Iterator& it);
     Iterator Erase(const Iterator& begin, const Iterator& end);
     
+    // Алгоритмы перестановкой указателей узлов: без выделения памяти и без копирования T
+    template <class Compare = std::less<>>
+    void Sort(Compare compare = Compare()); // Устойчивая сортировка слиянием снизу вверх (Time: O(n log n), Memory: O(1))
+    template <class Compare = std::less<>>
+    void Merge(List& other, Compare compare = Compare()); // Слияние двух отсортированных списков, other становится пустым (Time: O(n + m))
+    void Splice(const Iterator& pos, List& other); // Перенос всего other перед pos (Time: O(1))
+    void Splice(const Iterator& pos, List& other, const Iterator& it); // Перенос одного узла (Time: O(1))
+    void Splice(const Iterator& pos, List& other, const Iterator& first, const Iterator& last); // Перенос [first, last): O(1) перестановка указателей + O(last - first) подсчет размера, если other - другой список
+    void Splice(const Iterator& pos, List& other, const Iterator& first, const Iterator& last, size_t count); // Перенос [first, last), count = distance(first, last) известен заранее (Time: O(1))
+    size_t Unique(); // Удаление подряд идущих равных элементов, возвращает количество удаленных
+    template <class Predicate>
+    size_t Remove_If(Predicate predicate);
+    
     template <typename U>
     friend std::ostream& operator<<(std::ostream &os, const List<U>& list);
     
 private:
+    template <class Compare>
+    static Node* Merge_Chains(Node* first, Node* second, Compare& compare);
+    void Relink() noexcept;
+    void Link_Before(Node* pos, Node* first, Node* last) noexcept;
+    void Unlink_Range(Node* first, Node* last) noexcept;
+    
     void Copy(const List& other)
     {
         Node* begin_other = other._begin;
@@ -375,6 +395,10 @@ void List<T>::Pop_Front()
     
     Node* tmp = _begin;
     _begin = _begin->next;
+    if (_begin)
+        _begin->prev = nullptr;
+    else
+        _end = nullptr;
     delete tmp;
     --_size;
 }
@@ -386,7 +410,11 @@ void List<T>::Pop_Back()
         throw std::runtime_error("List is empty");
     
     Node* tmp = _end;
-    _end = _begin->prev;
+    _end = _end->prev;
+    if (_end)
+        _end->next = nullptr;
+    else
+        _begin = nullptr;
     delete tmp;
     --_size;
 }
@@ -562,18 +590,12 @@ List<T>::Iterator List<T>::Erase(const Iterator& it)
         throw std::runtime_error("iterator is empty");
     else if (it._node == _begin)
     {
-        Node* tmp = _begin;
-        _begin = _begin->next;
-        delete tmp;
-        --_size;
+        Pop_Front();
         return Begin();
     }
     else if (it._node == _end)
     {
-        Node* tmp = _end;
-        _end = _begin->prev;
-        delete tmp;
-        --_size;
+        Pop_Back();
         return End();
     }
     
@@ -597,6 +619,217 @@ List<T>::Iterator List<T>::Erase(const Iterator& begin, const Iterator& end)
     return it;
 }
 
+// Двоичный счетчик из отсортированных цепочек: в bins[i] цепочка из 2^i узлов или пусто. Каждый узел отцепляется и сливается с bins[0], bins[1], ... как перенос разряда при инкременте.
+template <class T>
+template <class Compare>
+void List<T>::Sort(Compare compare)
+{
+    if (_size < 2)
+        return;
+    
+    Node* bins[64] = {};
+    size_t fill = 0;
+    for (Node* node = _begin; node;)
+    {
+        Node* carry = node;
+        node = node->next;
+        carry->next = nullptr;
+        
+        size_t i = 0;
+        for (; i < fill && bins[i]; ++i)
+        {
+            carry = Merge_Chains(bins[i], carry, compare); // В bins[i] более ранние элементы, поэтому он первый: устойчивость
+            bins[i] = nullptr;
+        }
+        bins[i] = carry;
+        if (i == fill)
+            ++fill;
+    }
+    
+    Node* result = nullptr;
+    for (size_t i = 0; i < fill; ++i)
+    {
+        if (bins[i])
+            result = result ? Merge_Chains(bins[i], result, compare) : bins[i];
+    }
+    
+    _begin = result;
+    Relink(); // Сортировка шла только по next
+}
+
+template <class T>
+template <class Compare>
+void List<T>::Merge(List& other, Compare compare)
+{
+    if (this == &other || other.Empty())
+        return;
+    
+    _begin = Merge_Chains(_begin, other._begin, compare);
+    _size += std::exchange(other._size, 0);
+    other._begin = other._end = nullptr;
+    Relink();
+}
+
+template <class T>
+void List<T>::Splice(const Iterator& pos, List& other)
+{
+    if (this == &other || other.Empty())
+        return;
+    
+    Link_Before(pos._node, other._begin, other._end);
+    _size += std::exchange(other._size, 0);
+    other._begin = other._end = nullptr;
+}
+
+template <class T>
+void List<T>::Splice(const Iterator& pos, List& other, const Iterator& it)
+{
+    Node* node = it._node;
+    if (!node)
+        throw std::runtime_error("iterator is null");
+    if (this == &other && (node == pos._node || node->next == pos._node)) // Узел уже на месте (только в том же списке: у последнего узла другого списка тоже next == End())
+        return;
+    
+    other.Unlink_Range(node, node);
+    --other._size;
+    Link_Before(pos._node, node, node);
+    ++_size;
+}
+
+template <class T>
+void List<T>::Splice(const Iterator& pos, List& other, const Iterator& first, const Iterator& last)
+{
+    size_t count = 0;
+    if (this != &other)
+    {
+        for (auto it = first; it != last; ++it)
+            ++count;
+    }
+    Splice(pos, other, first, last, count);
+}
+
+template <class T>
+void List<T>::Splice(const Iterator& pos, List& other, const Iterator& first, const Iterator& last, size_t count)
+{
+    if (first == last)
+        return;
+    
+    Node* begin = first._node;
+    Node* end = last._node ? last._node->prev : other._end; // Последний переносимый узел
+    if (this != &other)
+    {
+        other._size -= count;
+        _size += count;
+    }
+    
+    other.Unlink_Range(begin, end);
+    Link_Before(pos._node, begin, end);
+}
+
+template <class T>
+size_t List<T>::Unique()
+{
+    if (!_begin)
+        return 0;
+    
+    size_t removed = 0;
+    for (Node* node = _begin; node->next;)
+    {
+        Node* next = node->next;
+        if (next->value == node->value)
+        {
+            Unlink_Range(next, next);
+            delete next;
+            ++removed;
+        }
+        else
+        {
+            node = next;
+        }
+    }
+    
+    _size -= removed;
+    return removed;
+}
+
+template <class T>
+template <class Predicate>
+size_t List<T>::Remove_If(Predicate predicate)
+{
+    size_t removed = 0;
+    for (Node* node = _begin; node;)
+    {
+        Node* next = node->next;
+        if (predicate(node->value))
+        {
+            Unlink_Range(node, node);
+            delete node;
+            ++removed;
+        }
+        node = next;
+    }
+    
+    _size -= removed;
+    return removed;
+}
+
+// Слияние двух отсортированных цепочек по next (prev не восстанавливается), при равенстве первым идет узел из first
+template <class T>
+template <class Compare>
+List<T>::Node* List<T>::Merge_Chains(Node* first, Node* second, Compare& compare)
+{
+    Node* result = nullptr;
+    Node** tail = &result;
+    while (first && second)
+    {
+        if (compare(second->value, first->value))
+        {
+            *tail = second;
+            second = second->next;
+        }
+        else
+        {
+            *tail = first;
+            first = first->next;
+        }
+        tail = &(*tail)->next;
+    }
+    *tail = first ? first : second;
+    return result;
+}
+
+// Восстановление prev и _end по цепочке next от _begin
+template <class T>
+void List<T>::Relink() noexcept
+{
+    Node* prev = nullptr;
+    for (Node* node = _begin; node; node = node->next)
+    {
+        node->prev = prev;
+        prev = node;
+    }
+    _end = prev;
+}
+
+// Вставка цепочки [first, last] перед pos, pos == nullptr - в конец
+template <class T>
+void List<T>::Link_Before(Node* pos, Node* first, Node* last) noexcept
+{
+    Node* prev = pos ? pos->prev : _end;
+    first->prev = prev;
+    last->next = pos;
+    (prev ? prev->next : _begin) = first;
+    (pos ? pos->prev : _end) = last;
+}
+
+// Исключение цепочки [first, last] из списка, размер не меняется
+template <class T>
+void List<T>::Unlink_Range(Node* first, Node* last) noexcept
+{
+    (first->prev ? first->prev->next : _begin) = last->next;
+    (last->next ? last->next->prev : _end) = first->prev;
+}
+
 template <class U>
 std::ostream& operator<<(std::ostream &os, const List<U>& list)
 {
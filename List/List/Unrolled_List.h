@@ -0,0 +1,652 @@
+#ifndef Unrolled_List_h
+#define Unrolled_List_h
+
+#include <algorithm>
+#include <iostream>
+#include <memory>
+#include <new>
+#include <utility>
+
+/*
+ Развернутый список (unrolled linked list): в каждом узле до K элементов подряд, поэтому при обходе переход по указателю (и возможный промах кэша) один на K элементов, а не на каждый элемент, как в List.
+ Накладные расходы: 2 указателя + счетчик на K элементов вместо 2 указателей на каждый элемент.
+ K по умолчанию - сколько элементов помещается в ~256 байт (4 кэш-линии), но не меньше 4.
+ Операции:
+ - Push_Back/Pop_Back: Time: O(1) без сдвига элементов, новый узел выделяется только когда последний узел заполнен.
+ - Push_Front/Pop_Front: Time: O(K) - элементы хранятся с начала узла, поэтому вставка и удаление в начале первого узла сдвигают его элементы (новый узел выделяется только когда первый узел заполнен).
+ - Insert(it)/Erase(it): Time: O(K) - сдвиг элементов внутри одного узла. Полный узел делится пополам, узел с количеством элементов меньше K/4 сливается со следующим, если они помещаются в половину узла.
+ Стабильность итераторов: итератор - это узел + индекс, поэтому сдвиг элементов узла инвалидирует итераторы на этот узел (они указывают на другие элементы), итераторы на элементы других узлов остаются действительными.
+ - Push_Back/Pop_Back не инвалидируют итераторы на другие элементы.
+ - Push_Front/Pop_Front инвалидируют итераторы на первый узел.
+ - Insert/Erase инвалидируют итераторы на свой узел и на соседний при делении/слиянии.
+ */
+template <class T, size_t K = std::max<size_t>(4, 256 / sizeof(T))>
+class Unrolled_List
+{
+    static_assert(K >= 2, "Unrolled_List: node must hold at least 2 elements");
+    
+    struct Node
+    {
+        T* Data() noexcept { return std::launder(reinterpret_cast<T*>(storage)); }
+        const T* Data() const noexcept { return std::launder(reinterpret_cast<const T*>(storage)); }
+        
+        Node* prev = nullptr;
+        Node* next = nullptr;
+        size_t count = 0;
+        alignas(T) unsigned char storage[sizeof(T) * K]; // Элементы [0, count) сконструированы
+    };
+
+public:
+    class Iterator;
+    friend class Iterator;
+    using Const_Iterator = const Iterator;
+    
+    Unrolled_List() = default;
+    Unrolled_List(const std::initializer_list<T>& list);
+    Unrolled_List(const Unrolled_List& other);
+    Unrolled_List(Unrolled_List&& other) noexcept;
+    ~Unrolled_List();
+    Unrolled_List& operator=(const Unrolled_List& other);
+    Unrolled_List& operator=(Unrolled_List&& other) noexcept;
+    bool operator==(const Unrolled_List& other) const;
+    template <typename ...Args>
+    T& Emplace_Front(Args&& ...args);
+    template <typename ...Args>
+    T& Emplace_Back(Args&& ...args);
+    void Push_Front(const T& value);
+    void Push_Front(T&& value);
+    void Push_Back(const T& value);
+    void Push_Back(T&& value);
+    void Pop_Front();
+    void Pop_Back();
+    T& Front();
+    T& Back();
+    const T& Front() const;
+    const T& Back() const;
+    void Swap(Unrolled_List& other) noexcept;
+    bool Empty() const noexcept;
+    size_t Size() const noexcept;
+    size_t Nodes() const noexcept;
+    void Reverse();
+    void Clear();
+    
+    Iterator Begin();
+    Iterator End();
+    Const_Iterator Begin() const noexcept;
+    Const_Iterator End() const noexcept;
+    Const_Iterator CBegin() const noexcept;
+    Const_Iterator CEnd() const noexcept;
+    // Вставка перед it, возвращает итератор на вставленный элемент
+    template <typename ...Args>
+    Iterator Emplace(const Iterator& it, Args&& ...args);
+    Iterator Insert(const Iterator& it, const T& value);
+    Iterator Insert(const Iterator& it, T&& value);
+    // Возвращает итератор на элемент после удаленного
+    Iterator Erase(const Iterator& it);
+    Iterator Erase(const Iterator& begin, const Iterator& end);
+    
+    template <typename U, size_t N>
+    friend std::ostream& operator<<(std::ostream& os, const Unrolled_List<U, N>& list);
+
+private:
+    Node* Insert_Node(Node* prev, Node* next);
+    void Remove_Node(Node* node) noexcept;
+    Node* Split(Node* node);
+    void Merge_Next(Node* node);
+    
+    template <typename ...Args>
+    T& Construct(Node* node, size_t index, Args&& ...args);
+    void Destroy(Node* node, size_t index) noexcept;
+    void Copy(const Unrolled_List& other);
+
+private:
+    Node* _begin = nullptr;
+    Node* _end = nullptr;
+    size_t _size = 0;
+    size_t _nodes = 0;
+};
+
+
+// Итератор: узел + индекс в узле, End() - nullptr
+template <class T, size_t K>
+class Unrolled_List<T, K>::Iterator
+{
+    friend class Unrolled_List;
+public:
+    Iterator(const Unrolled_List& list, Node* node, size_t index = 0) :
+    _list(&list),
+    _node(node),
+    _index(index)
+    {
+        
+    }
+    
+    inline Iterator& operator++()
+    {
+        if (_node && ++_index == _node->count)
+        {
+            _node = _node->next;
+            _index = 0;
+        }
+        return *this;
+    }
+    
+    inline Iterator operator++(int)
+    {
+        Iterator temp = *this;
+        ++(*this);
+        return temp;
+    }
+    
+    inline Iterator& operator--()
+    {
+        if (!_node) // --End() - последний элемент
+        {
+            _node = _list->_end;
+            _index = _node ? _node->count - 1 : 0;
+        }
+        else if (_index == 0)
+        {
+            _node = _node->prev;
+            _index = _node ? _node->count - 1 : 0;
+        }
+        else
+        {
+            --_index;
+        }
+        return *this;
+    }
+    
+    inline Iterator operator--(int)
+    {
+        Iterator temp = *this;
+        --(*this);
+        return temp;
+    }
+    
+    inline T& operator*()
+    {
+        if (!_node)
+            throw std::runtime_error("iterator is null");
+        return _node->Data()[_index];
+    }
+    
+    inline const T& operator*() const
+    {
+        if (!_node)
+            throw std::runtime_error("iterator is null");
+        return _node->Data()[_index];
+    }
+    
+    inline T* operator->()
+    {
+        return &**this;
+    }
+    
+    inline const T* operator->() const
+    {
+        return &**this;
+    }
+    
+    inline bool operator==(const Iterator& other) const
+    {
+        return _list == other._list && _node == other._node && _index == other._index;
+    }
+    
+    inline bool operator!=(const Iterator& other) const
+    {
+        return !(*this == other);
+    }
+
+private:
+    const Unrolled_List* _list = nullptr;
+    Node* _node = nullptr;
+    size_t _index = 0;
+};
+
+
+template <class T, size_t K>
+Unrolled_List<T, K>::Unrolled_List(const std::initializer_list<T>& list)
+{
+    for (const auto& value : list)
+        Push_Back(value);
+}
+
+template <class T, size_t K>
+Unrolled_List<T, K>::Unrolled_List(const Unrolled_List& other)
+{
+    Copy(other);
+}
+
+template <class T, size_t K>
+Unrolled_List<T, K>::Unrolled_List(Unrolled_List&& other) noexcept
+{
+    _begin = std::exchange(other._begin, nullptr);
+    _end = std::exchange(other._end, nullptr);
+    _size = std::exchange(other._size, 0);
+    _nodes = std::exchange(other._nodes, 0);
+}
+
+template <class T, size_t K>
+Unrolled_List<T, K>::~Unrolled_List()
+{
+    Clear();
+}
+
+template <class T, size_t K>
+Unrolled_List<T, K>& Unrolled_List<T, K>::operator=(const Unrolled_List& other)
+{
+    if (this == &other) // object = object
+        return *this;
+    
+    Clear();
+    Copy(other);
+    
+    return *this;
+}
+
+template <class T, size_t K>
+Unrolled_List<T, K>& Unrolled_List<T, K>::operator=(Unrolled_List&& other) noexcept
+{
+    if (this == &other) // object = object
+        return *this;
+    
+    Clear();
+    _begin = std::exchange(other._begin, nullptr);
+    _end = std::exchange(other._end, nullptr);
+    _size = std::exchange(other._size, 0);
+    _nodes = std::exchange(other._nodes, 0);
+    
+    return *this;
+}
+
+template <class T, size_t K>
+bool Unrolled_List<T, K>::operator==(const Unrolled_List& other) const
+{
+    if (this == &other) // object = object
+        return true;
+    
+    if (Size() != other.Size())
+        return false;
+    
+    for (auto it = Begin(), it_other = other.Begin(); it != End(); ++it, ++it_other)
+    {
+        if (!(*it == *it_other))
+            return false;
+    }
+    
+    return true;
+}
+
+template <class T, size_t K>
+template <typename ...Args>
+T& Unrolled_List<T, K>::Emplace_Front(Args&& ...args)
+{
+    if (!_begin || _begin->count == K)
+        Insert_Node(nullptr, _begin);
+    
+    return Construct(_begin, 0, std::forward<Args>(args)...);
+}
+
+template <class T, size_t K>
+template <typename ...Args>
+T& Unrolled_List<T, K>::Emplace_Back(Args&& ...args)
+{
+    if (!_end || _end->count == K)
+        Insert_Node(_end, nullptr);
+    
+    return Construct(_end, _end->count, std::forward<Args>(args)...);
+}
+
+template <class T, size_t K>
+void Unrolled_List<T, K>::Push_Front(const T& value)
+{
+    Emplace_Front(value);
+}
+
+template <class T, size_t K>
+void Unrolled_List<T, K>::Push_Front(T&& value)
+{
+    Emplace_Front(std::move(value));
+}
+
+template <class T, size_t K>
+void Unrolled_List<T, K>::Push_Back(const T& value)
+{
+    Emplace_Back(value);
+}
+
+template <class T, size_t K>
+void Unrolled_List<T, K>::Push_Back(T&& value)
+{
+    Emplace_Back(std::move(value));
+}
+
+template <class T, size_t K>
+void Unrolled_List<T, K>::Pop_Front()
+{
+    if (Empty())
+        throw std::runtime_error("List is empty");
+    
+    Destroy(_begin, 0);
+    if (_begin->count == 0)
+        Remove_Node(_begin);
+}
+
+template <class T, size_t K>
+void Unrolled_List<T, K>::Pop_Back()
+{
+    if (Empty())
+        throw std::runtime_error("List is empty");
+    
+    Destroy(_end, _end->count - 1);
+    if (_end->count == 0)
+        Remove_Node(_end);
+}
+
+template <class T, size_t K>
+T& Unrolled_List<T, K>::Front()
+{
+    if (!_begin)
+        throw std::runtime_error("begin is null");
+    return _begin->Data()[0];
+}
+
+template <class T, size_t K>
+T& Unrolled_List<T, K>::Back()
+{
+    if (!_end)
+        throw std::runtime_error("end is null");
+    return _end->Data()[_end->count - 1];
+}
+
+template <class T, size_t K>
+const T& Unrolled_List<T, K>::Front() const
+{
+    if (!_begin)
+        throw std::runtime_error("begin is null");
+    return _begin->Data()[0];
+}
+
+template <class T, size_t K>
+const T& Unrolled_List<T, K>::Back() const
+{
+    if (!_end)
+        throw std::runtime_error("end is null");
+    return _end->Data()[_end->count - 1];
+}
+
+template <class T, size_t K>
+void Unrolled_List<T, K>::Swap(Unrolled_List& other) noexcept
+{
+    if (this == &other) // object.Swap(object)
+        return;
+    
+    std::swap(_begin, other._begin);
+    std::swap(_end, other._end);
+    std::swap(_size, other._size);
+    std::swap(_nodes, other._nodes);
+}
+
+template <class T, size_t K>
+bool Unrolled_List<T, K>::Empty() const noexcept
+{
+    return Size() == 0;
+}
+
+template <class T, size_t K>
+size_t Unrolled_List<T, K>::Size() const noexcept
+{
+    return _size;
+}
+
+template <class T, size_t K>
+size_t Unrolled_List<T, K>::Nodes() const noexcept
+{
+    return _nodes;
+}
+
+// Разворот порядка узлов и элементов внутри каждого узла (Time: O(n))
+template <class T, size_t K>
+void Unrolled_List<T, K>::Reverse()
+{
+    for (Node* node = _begin; node; node = node->prev) // После обмена prev указывает на следующий узел
+    {
+        std::reverse(node->Data(), node->Data() + node->count);
+        std::swap(node->prev, node->next);
+    }
+    std::swap(_begin, _end);
+}
+
+template <class T, size_t K>
+void Unrolled_List<T, K>::Clear()
+{
+    while (_begin)
+    {
+        Node* next = _begin->next;
+        std::destroy_n(_begin->Data(), _begin->count);
+        delete _begin;
+        _begin = next;
+    }
+    
+    _end = nullptr;
+    _size = 0;
+    _nodes = 0;
+}
+
+template <class T, size_t K>
+Unrolled_List<T, K>::Iterator Unrolled_List<T, K>::Begin()
+{
+    return Iterator(*this, _begin);
+}
+
+template <class T, size_t K>
+Unrolled_List<T, K>::Iterator Unrolled_List<T, K>::End()
+{
+    return Iterator(*this, nullptr);
+}
+
+template <class T, size_t K>
+Unrolled_List<T, K>::Const_Iterator Unrolled_List<T, K>::Begin() const noexcept
+{
+    return Const_Iterator(*this, _begin);
+}
+
+template <class T, size_t K>
+Unrolled_List<T, K>::Const_Iterator Unrolled_List<T, K>::End() const noexcept
+{
+    return Const_Iterator(*this, nullptr);
+}
+
+template <class T, size_t K>
+Unrolled_List<T, K>::Const_Iterator Unrolled_List<T, K>::CBegin() const noexcept
+{
+    return Begin();
+}
+
+template <class T, size_t K>
+Unrolled_List<T, K>::Const_Iterator Unrolled_List<T, K>::CEnd() const noexcept
+{
+    return End();
+}
+
+// Вставка перед it: сдвиг хвоста узла на 1, полный узел предварительно делится пополам (Time: O(K))
+template <class T, size_t K>
+template <typename ...Args>
+Unrolled_List<T, K>::Iterator Unrolled_List<T, K>::Emplace(const Iterator& it, Args&& ...args)
+{
+    if (!it._node)
+    {
+        Emplace_Back(std::forward<Args>(args)...);
+        return Iterator(*this, _end, _end->count - 1);
+    }
+    
+    Node* node = it._node;
+    size_t index = it._index;
+    if (node->count < K)
+    {
+        Construct(node, index, std::forward<Args>(args)...);
+        return Iterator(*this, node, index);
+    }
+    
+    T value(std::forward<Args>(args)...); // До Split: args могут ссылаться на элемент верхней половины, который Split перенесет и разрушит
+    Node* next = Split(node);
+    if (index > node->count)
+    {
+        index -= node->count;
+        node = next;
+    }
+    
+    Construct(node, index, std::move(value));
+    return Iterator(*this, node, index);
+}
+
+template <class T, size_t K>
+Unrolled_List<T, K>::Iterator Unrolled_List<T, K>::Insert(const Iterator& it, const T& value)
+{
+    return Emplace(it, value);
+}
+
+template <class T, size_t K>
+Unrolled_List<T, K>::Iterator Unrolled_List<T, K>::Insert(const Iterator& it, T&& value)
+{
+    return Emplace(it, std::move(value));
+}
+
+// Удаление со сдвигом хвоста узла, пустой узел удаляется, почти пустой сливается со следующим (Time: O(K))
+template <class T, size_t K>
+Unrolled_List<T, K>::Iterator Unrolled_List<T, K>::Erase(const Iterator& it)
+{
+    if (!it._node)
+        throw std::runtime_error("iterator is empty");
+    
+    Node* node = it._node;
+    const size_t index = it._index;
+    Destroy(node, index);
+    if (node->count == 0)
+    {
+        Node* next = node->next;
+        Remove_Node(node);
+        return Iterator(*this, next);
+    }
+    
+    if (node->count < K / 4 && node->next && node->count + node->next->count <= K / 2)
+        Merge_Next(node);
+    
+    return index < node->count ? Iterator(*this, node, index) : Iterator(*this, node->next);
+}
+
+// Erase(it) сдвигает элементы и сливает узлы, поэтому end после первого удаления недействителен: сначала считается количество удаляемых элементов
+template <class T, size_t K>
+Unrolled_List<T, K>::Iterator Unrolled_List<T, K>::Erase(const Iterator& begin, const Iterator& end)
+{
+    size_t count = 0;
+    for (auto it = begin; it != end; ++it)
+        ++count;
+    
+    auto it = begin;
+    for (; count > 0; --count)
+        it = Erase(it);
+    return it;
+}
+
+template <class T, size_t K>
+Unrolled_List<T, K>::Node* Unrolled_List<T, K>::Insert_Node(Node* prev, Node* next)
+{
+    Node* node = new Node; // Без () - storage не обнуляется
+    node->prev = prev;
+    node->next = next;
+    (prev ? prev->next : _begin) = node;
+    (next ? next->prev : _end) = node;
+    ++_nodes;
+    return node;
+}
+
+template <class T, size_t K>
+void Unrolled_List<T, K>::Remove_Node(Node* node) noexcept
+{
+    (node->prev ? node->prev->next : _begin) = node->next;
+    (node->next ? node->next->prev : _end) = node->prev;
+    delete node;
+    --_nodes;
+}
+
+// Верхняя половина полного узла переносится в новый узел после него, возвращает новый узел
+template <class T, size_t K>
+Unrolled_List<T, K>::Node* Unrolled_List<T, K>::Split(Node* node)
+{
+    Node* next = Insert_Node(node, node->next);
+    const size_t half = node->count / 2;
+    std::uninitialized_move(node->Data() + half, node->Data() + node->count, next->Data());
+    std::destroy(node->Data() + half, node->Data() + node->count);
+    next->count = node->count - half;
+    node->count = half;
+    return next;
+}
+
+template <class T, size_t K>
+void Unrolled_List<T, K>::Merge_Next(Node* node)
+{
+    Node* next = node->next;
+    std::uninitialized_move(next->Data(), next->Data() + next->count, node->Data() + node->count);
+    std::destroy_n(next->Data(), next->count);
+    node->count += next->count;
+    Remove_Node(next);
+}
+
+// Конструирование элемента на позиции index со сдвигом [index, count) вправо, в узле должно быть свободное место
+template <class T, size_t K>
+template <typename ...Args>
+T& Unrolled_List<T, K>::Construct(Node* node, size_t index, Args&& ...args)
+{
+    T* data = node->Data();
+    if (index == node->count)
+    {
+        new (data + index) T(std::forward<Args>(args)...);
+    }
+    else
+    {
+        T value(std::forward<Args>(args)...); // args могут ссылаться на элемент этого узла, который будет сдвинут (при делении узла - см. Emplace)
+        new (data + node->count) T(std::move(data[node->count - 1]));
+        std::move_backward(data + index, data + node->count - 1, data + node->count);
+        data[index] = std::move(value);
+    }
+    
+    ++node->count;
+    ++_size;
+    return data[index];
+}
+
+// Удаление элемента на позиции index со сдвигом (index, count) влево
+template <class T, size_t K>
+void Unrolled_List<T, K>::Destroy(Node* node, size_t index) noexcept
+{
+    T* data = node->Data();
+    std::move(data + index + 1, data + node->count, data + index);
+    data[node->count - 1].~T();
+    --node->count;
+    --_size;
+}
+
+template <class T, size_t K>
+void Unrolled_List<T, K>::Copy(const Unrolled_List& other)
+{
+    for (Node* node = other._begin; node; node = node->next)
+    {
+        Node* copy = Insert_Node(_end, nullptr);
+        std::uninitialized_copy(node->Data(), node->Data() + node->count, copy->Data());
+        copy->count = node->count;
+        _size += node->count;
+    }
+}
+
+template <class U, size_t N>
+std::ostream& operator<<(std::ostream& os, const Unrolled_List<U, N>& list)
+{
+    for (auto it = list.Begin(); it != list.End(); ++it)
+        os << *it << " ";
+    
+    return os;
+}
+
+#endif /* Unrolled_List_h */
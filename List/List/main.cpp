@@ -1,6 +1,13 @@
+#include "Intrusive_List.h"
 #include "List.h"
+#include "Timer.h"
+#include "Unrolled_List.h"
 
+#include <algorithm>
+#include <cstdint>
+#include <random>
 #include <string>
+#include <vector>
 
 /*
  Сайты:
@@ -37,6 +44,80 @@ private:
     std::string _str;
 };
 
+// Элемент размером Size байт для сравнения List и Unrolled_List
+template <size_t Size>
+struct Payload
+{
+    uint32_t data[Size / sizeof(uint32_t)] = {};
+};
+
+// Обход, вставка через итераторы (перед каждым 8-м элементом) и повторный обход
+template <template <class> class ListType, size_t Size>
+void Benchmark(const char* name)
+{
+    static constexpr size_t count = 1 << 20;
+    
+    Timer timer;
+    timer.start();
+    ListType<Payload<Size>> list;
+    for (size_t i = 0; i < count; ++i)
+    {
+        Payload<Size> value;
+        value.data[0] = static_cast<uint32_t>(i);
+        list.Emplace_Back(value);
+    }
+    timer.stop();
+    const double push = timer.elapsedMilliseconds();
+    
+    uint64_t sum = 0;
+    timer.start();
+    for (auto it = list.Begin(); it != list.End(); ++it)
+        sum += it->data[0];
+    timer.stop();
+    const double iterate = timer.elapsedMilliseconds();
+    
+    timer.start();
+    size_t index = 1;
+    for (auto it = ++list.Begin(); it != list.End(); ++it, ++index) // Со второго элемента: List::Insert в начало не обновляет _begin
+    {
+        if (index % 8 == 0)
+        {
+            it = list.Insert(it, Payload<Size>());
+            ++it; // Возвращаемся к элементу, перед которым вставили
+        }
+    }
+    timer.stop();
+    const double insert = timer.elapsedMilliseconds();
+    
+    timer.start();
+    for (auto it = list.Begin(); it != list.End(); ++it)
+        sum += it->data[0];
+    timer.stop();
+    
+    std::cout << name << " " << Size << " bytes: Push_Back " << push << " ms, iterate " << iterate << " ms, Insert " << insert << " ms, iterate after insert " << timer.elapsedMilliseconds() << " ms, sum: " << sum << std::endl;
+}
+
+template <class T>
+using Unrolled = Unrolled_List<T>;
+
+// Соединение живет в пуле и одновременно состоит в двух интрузивных списках
+struct Connection
+{
+    int id = 0;
+    char payload[48] = {};
+    List_Hook all_hook; // Все соединения
+    List_Hook idle_hook; // Соединения без активности, проверяются по таймауту
+    
+    friend std::ostream& operator<<(std::ostream& os, const Connection& connection) { return os << connection.id; }
+};
+
+template <size_t ...Sizes>
+void Benchmarks()
+{
+    (Benchmark<List, Sizes>("List"), ...);
+    (Benchmark<Unrolled, Sizes>("Unrolled_List"), ...);
+}
+
 
 int main()
 {
@@ -109,5 +190,215 @@ int main()
         std::cout << *it;
     std::cout << std::endl;
     
+    // Unrolled_List: K элементов в узле
+    {
+        Unrolled_List<int, 4> unrolled = {1, 2, 3, 4, 5, 6};
+        unrolled.Push_Front(0);
+        auto it = unrolled.Begin();
+        for (int i = 0; i < 3; ++i)
+            ++it;
+        unrolled.Insert(it, 100); // Полный узел делится пополам
+        std::cout << "Unrolled_List: " << unrolled << "nodes: " << unrolled.Nodes() << std::endl;
+        
+        unrolled.Erase(unrolled.Begin());
+        unrolled.Pop_Back();
+        unrolled.Reverse();
+        std::cout << "Unrolled_List reverse: " << unrolled << "front: " << unrolled.Front() << ", back: " << unrolled.Back() << std::endl;
+        
+        std::cout << "reverse iteration: ";
+        for (auto rit = unrolled.End(); rit != unrolled.Begin();)
+            std::cout << *--rit << " ";
+        std::cout << std::endl;
+        
+        Unrolled_List<int, 8> range;
+        for (int i = 0; i < 20; ++i)
+            range.Push_Back(i);
+        auto first = ++range.Begin();
+        auto last = first;
+        for (int i = 0; i < 3; ++i)
+            ++last;
+        range.Erase(first, last); // Диапазон [1, 4) заканчивается в середине узла
+        std::cout << "Unrolled_List Erase [1, 4): " << range << "size: " << range.Size() << std::endl;
+        
+        Unrolled_List<std::string, 4> words = {"a", "b", "c", "d"};
+        auto word = words.Begin();
+        for (int i = 0; i < 3; ++i)
+            ++word;
+        words.Insert(words.Begin(), *word); // Ссылка на элемент верхней половины полного узла, который делится
+        std::cout << "Unrolled_List Insert from the same node: " << words << std::endl;
+        
+        Benchmarks<4, 16, 64>();
+    }
+    
+    // Intrusive_List: связи внутри объекта, без выделения памяти
+    {
+        std::vector<Connection> pool(6);
+        Intrusive_List<Connection, &Connection::all_hook> all;
+        Intrusive_List<Connection, &Connection::idle_hook> idle;
+        for (size_t i = 0; i < pool.size(); ++i)
+        {
+            pool[i].id = static_cast<int>(i);
+            all.Push_Back(pool[i]);
+            idle.Push_Back(pool[i]);
+        }
+        
+        idle.Erase(pool[2]); // O(1) по ссылке: соединение стало активным
+        idle.Erase(pool[4]);
+        idle.Push_Back(pool[2]); // И снова простаивает - в конец очереди таймаута
+        std::cout << "Intrusive_List all: " << all << "idle: " << idle << "linked: " << pool[4].idle_hook.Is_Linked() << std::endl;
+        idle.Reverse();
+        std::cout << "idle reverse: " << idle << std::endl;
+        
+        // Оборот очереди (FIFO): List выделяет и освобождает узел на каждую операцию, Intrusive_List только переставляет указатели
+        static constexpr size_t window = 1024;
+        static constexpr size_t operations = 1 << 22;
+        
+        std::vector<Connection> connections(window);
+        List<Connection*> list;
+        all.Clear();
+        for (auto& connection : connections)
+        {
+            list.Emplace_Back(&connection);
+            all.Push_Back(connection);
+        }
+        
+        Timer timer;
+        timer.start();
+        for (size_t i = 0; i < operations; ++i)
+        {
+            Connection* connection = list.Front();
+            list.Pop_Front();
+            ++connection->id;
+            list.Emplace_Back(connection);
+        }
+        timer.stop();
+        std::cout << "List<Connection*> churn: " << timer.elapsedMilliseconds() << " ms" << std::endl;
+        
+        timer.start();
+        for (size_t i = 0; i < operations; ++i)
+        {
+            Connection& connection = all.Front();
+            all.Pop_Front();
+            ++connection.id;
+            all.Push_Back(connection);
+        }
+        timer.stop();
+        std::cout << "Intrusive_List churn: " << timer.elapsedMilliseconds() << " ms" << std::endl;
+        
+        // LRU: перенос произвольного соединения в конец, в List для этого нужен поиск
+        timer.start();
+        for (size_t i = 0; i < operations; ++i)
+        {
+            Connection& connection = connections[(i * 7919) % window];
+            all.Erase(connection);
+            all.Push_Back(connection);
+        }
+        timer.stop();
+        std::cout << "Intrusive_List Erase(T&) + Push_Back: " << timer.elapsedMilliseconds() << " ms, size: " << all.Size() << std::endl;
+        all.Clear(); // connections разрушается раньше all: объекты нужно отсоединить заранее
+    }
+    
+    // Sort, Merge, Splice, Unique, Remove_If: перестановка узлов против копирования в вектор и пересборки списка
+    {
+        List<int> small = {5, 1, 4, 1, 3, 5, 2};
+        small.Sort();
+        std::cout << "Sort: " << small;
+        small.Unique();
+        std::cout << "Unique: " << small;
+        List<int> other = {0, 6};
+        small.Merge(other);
+        std::cout << "Merge: " << small;
+        small.Remove_If([](int value) { return value % 2 == 0; });
+        std::cout << "Remove_If(even): " << small;
+        other.Splice(other.End(), small, ++small.Begin(), small.End());
+        std::cout << "Splice: " << small << "| " << other << std::endl;
+        List<int> left = {1, 2};
+        List<int> right = {3, 4};
+        left.Splice(left.End(), right, ++right.Begin()); // Последний узел другого списка в конец
+        std::cout << "Splice last node: " << left << "| " << right << "sizes: " << left.Size() << " " << right.Size() << std::endl;
+        
+        static constexpr size_t count = 10'000'000;
+        std::mt19937 random(42);
+        std::vector<int> values(count);
+        for (auto& value : values)
+            value = static_cast<int>(random() % (count / 4)); // Есть повторы для Unique
+        
+        auto Fill = [](List<int>& list, const std::vector<int>& source)
+        {
+            list.Clear();
+            for (int value : source)
+                list.Emplace_Back(value);
+        };
+        
+        // Узлы двух списков выделяются по очереди, чтобы раскладка в памяти (и промахи кэша при обходе) была одинаковой
+        auto Fill_Both = [](List<int>& first, List<int>& second, const std::vector<int>& source)
+        {
+            first.Clear();
+            second.Clear();
+            for (int value : source)
+            {
+                first.Emplace_Back(value);
+                second.Emplace_Back(value);
+            }
+        };
+        
+        // Старый способ: копия в вектор, алгоритм над вектором, пересборка списка (освобождение и выделение каждого узла)
+        auto To_Vector = [](const List<int>& list)
+        {
+            std::vector<int> result;
+            for (auto it = list.Begin(); it != list.End(); ++it)
+                result.push_back(*it);
+            return result;
+        };
+        
+        Timer timer;
+        auto Measure = [&timer](const char* name, auto&& rebuild, auto&& in_place)
+        {
+            timer.start();
+            rebuild();
+            timer.stop();
+            const double copy = timer.elapsedMilliseconds();
+            
+            timer.start();
+            in_place();
+            timer.stop();
+            std::cout << name << ": copy + rebuild " << copy << " ms, in place " << timer.elapsedMilliseconds() << " ms" << std::endl;
+        };
+        
+        std::vector<int> sorted_values = values;
+        std::sort(sorted_values.begin(), sorted_values.end());
+        
+        List<int> list, expected;
+        Fill_Both(list, expected, values);
+        Measure("Sort", [&]() { auto copy = To_Vector(expected); std::stable_sort(copy.begin(), copy.end()); Fill(expected, copy); }, [&]() { list.Sort(); });
+        std::cout << "equal: " << (list == expected) << std::endl;
+        
+        // После Sort узлы list разбросаны по памяти, а expected собран заново подряд: для честного сравнения остальные алгоритмы начинают с одинаково собранных списков
+        Fill_Both(list, expected, sorted_values);
+        Measure("Unique", [&]() { auto copy = To_Vector(expected); copy.erase(std::unique(copy.begin(), copy.end()), copy.end()); Fill(expected, copy); }, [&]() { list.Unique(); });
+        Measure("Remove_If", [&]() { auto copy = To_Vector(expected); copy.erase(std::remove_if(copy.begin(), copy.end(), [](int value) { return value % 3 == 0; }), copy.end()); Fill(expected, copy); },
+                [&]() { list.Remove_If([](int value) { return value % 3 == 0; }); });
+        std::cout << "equal: " << (list == expected) << ", size: " << list.Size() << std::endl;
+        
+        List<int> second, expected_second;
+        Fill_Both(list, expected, sorted_values);
+        Fill_Both(second, expected_second, sorted_values);
+        Measure("Merge", [&]() { auto copy = To_Vector(expected); auto copy_second = To_Vector(expected_second); std::vector<int> merged(copy.size() + copy_second.size());
+                                 std::merge(copy.begin(), copy.end(), copy_second.begin(), copy_second.end(), merged.begin()); Fill(expected, merged); expected_second.Clear(); },
+                [&]() { list.Merge(second); });
+        std::cout << "equal: " << (list == expected) << ", size: " << list.Size() << std::endl;
+        
+        // Перенос второй половины в другой список
+        Fill_Both(list, expected, sorted_values);
+        second.Clear();
+        expected_second.Clear();
+        auto middle = list.Begin();
+        auto expected_middle = expected.Begin();
+        for (size_t i = 0; i < count / 2; ++i, ++middle, ++expected_middle);
+        Measure("Splice", [&]() { for (auto it = expected_middle; it != expected.End(); ++it) expected_second.Emplace_Back(*it); expected.Erase(expected_middle, expected.End()); },
+                [&]() { second.Splice(second.End(), list, middle, list.End(), count - count / 2); });
+        std::cout << "equal: " << (list == expected && second == expected_second) << ", sizes: " << list.Size() << " " << second.Size() << std::endl;
+    }
+    
     return 0;
 }
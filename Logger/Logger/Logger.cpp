@@ -1,4 +1,5 @@
 #include "Logger.h"
+#include "String_Builder.h"
 
 #include <filesystem>
 #include <fstream>
@@ -65,69 +66,78 @@ Logger::Streamer::StringBuffer::~StringBuffer()
 
 int Logger::Streamer::StringBuffer::sync()
 {
-    std::string text(str()); // Получение текста из буфера
+    const std::string_view text = view(); // Текст буфера без копирования
     if (text.empty())
     {
         return 0;
     }
-    str(""); // Очищение буфера
-    switch (_logLevel)
+    Logger::Write(_logLevel, text);
+    str(""); // Очищение буфера после записи, т.к. text указывает в буфер
+    
+    return 0;
+};
+
+void Logger::Write(LogLevel iLogLevel, std::string_view iMessage)
+{
+    switch (iLogLevel)
     {
         case INFO:
-            Logger::_logger->WriteInfo(text);
+            Logger::_logger->WriteInfo(iMessage);
             break;
             
         case WARNING:
-            Logger::_logger->WriteWarning(text);
+            Logger::_logger->WriteWarning(iMessage);
             break;
             
         case ERROR:
-            Logger::_logger->WriteError(text);
+            Logger::_logger->WriteError(iMessage);
+            break;
+            
+        default:
             break;
     }
-    
-    return 0;
-};
+}
 
-void Logger::WriteInfo(const std::string& iMessage)
+void Logger::WriteInfo(std::string_view iMessage)
 {
     if (_logLevel >= INFO)
     {
-        const std::string localTime = "[" + LocalTime() + "] ";
-        const std::string str = localTime + iMessage;
+        String_Builder line; // Строка собирается в арене потока без промежуточных std::string
+        line << '[' << String_Builder::Local_Time() << "] " << iMessage;
+        const std::string_view str = line.View();
         auto thread = std::thread([this, &str]() { this->WriteToFile(str); }); // Отдельный поток, в котром осуществляется запись в файл
         WriteToBuffer(str, INFO);
         thread.join();
     }
 }
 
-void Logger::WriteWarning(const std::string& iMessage)
+void Logger::WriteWarning(std::string_view iMessage)
 {
     if (_logLevel >= WARNING)
     {
-        const std::string localTime = "[" + LocalTime() + "] ";
-        const std::string type = "[Warning] ";
-        const std::string str = localTime + type + iMessage;
+        String_Builder line;
+        line << '[' << String_Builder::Local_Time() << "] " << "[Warning] " << iMessage;
+        const std::string_view str = line.View();
         auto thread = std::thread([this, &str]() { this->WriteToFile(str); }); // Отдельный поток, в котром осуществляется запись в файл
         WriteToBuffer(str, WARNING);
         thread.join();
     }
 }
 
-void Logger::WriteError(const std::string& iMessage)
+void Logger::WriteError(std::string_view iMessage)
 {
     if (_logLevel >= ERROR)
     {
-        const std::string localTime = "[" + LocalTime() + "] ";
-        const std::string type = "[Error] ";
-        const std::string str = localTime + type + iMessage;
+        String_Builder line;
+        line << '[' << String_Builder::Local_Time() << "] " << "[Error] " << iMessage;
+        const std::string_view str = line.View();
         auto thread = std::thread([this, &str]() { this->WriteToFile(str); }); // Отдельный поток, в котром осуществляется запись в файл
         WriteToBuffer(str, ERROR);
         thread.join();
     }
 }
 
-void Logger::WriteToBuffer(const std::string& message, LogLevel iLogLevel)
+void Logger::WriteToBuffer(std::string_view message, LogLevel iLogLevel)
 {
     _allMessagesBuffer += message;
     switch (iLogLevel)
@@ -146,7 +156,7 @@ void Logger::WriteToBuffer(const std::string& message, LogLevel iLogLevel)
     }
 }
 
-void Logger::WriteToFile(const std::string& iMessage)
+void Logger::WriteToFile(std::string_view iMessage)
 {
     _logFile << iMessage << std::flush; // Принудительный сброс буфера
 }
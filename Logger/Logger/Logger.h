@@ -3,6 +3,7 @@
 
 #include <iostream>
 #include <sstream>
+#include <string_view>
 
 /*
  Сайты:  https://stackoverflow.com/questions/26143930/xcode-how-to-set-current-working-directory-to-a-relative-path-for-an-executable
@@ -120,26 +121,34 @@ public:
      */
     Logger& operator=(Logger&) = delete;
     
+    /*!
+     * @brief Запись сообщения заданного уровня без копирования.
+     * Сообщение, собранное в String_Builder, передается как std::string_view
+     * @param iLogLevel - Уровень лога
+     * @param iMessage - Записываемое сообщение
+     */
+    static void Write(LogLevel iLogLevel, std::string_view iMessage);
+    
     /*!
      * @brief Запись информационных сообщений.
      * Запись производится одновременно в файл и буфер в двух потоках
      * @param iMessage - Записываемое сообщение
      */
-    void WriteInfo(const std::string& iMessage);
+    void WriteInfo(std::string_view iMessage);
     
     /*!
      * @brief Запись предупреждений.
      * Запись производится одновременно в файл и буфер в двух потоках
      * @param iMessage - Записываемое сообщение
      */
-    void WriteWarning(const std::string& iMessage);
+    void WriteWarning(std::string_view iMessage);
     
     /*!
      * @brief Запись ошибок.
      * Запись производится одновременно в файл и буфер в двух потоках
      * @param iMessage - Записываемое сообщение
      */
-    void WriteError(const std::string& iMessage);
+    void WriteError(std::string_view iMessage);
     
     /*!
      * @brief Запись в буфер.
@@ -147,13 +156,13 @@ public:
      * @param iMessage - Записываемое сообщение
      * @param iLogLevel - Уровень лога
      */
-    static void WriteToBuffer(const std::string& iMessage, LogLevel iLogLevel);
+    static void WriteToBuffer(std::string_view iMessage, LogLevel iLogLevel);
     
     /*!
      * @brief Запись в файл
      * @param iMessage - Записываемое сообщение
      */
-    void WriteToFile(const std::string& iMessage);
+    void WriteToFile(std::string_view iMessage);
     
     /*!
      * @brief Вывод информационных сообщений на экран
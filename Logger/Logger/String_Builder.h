@@ -0,0 +1,251 @@
+#ifndef String_Builder_h
+#define String_Builder_h
+
+#include "Arena_Allocator.h"
+
+#include <charconv>
+#include <concepts>
+#include <cstring>
+#include <ctime>
+#include <iostream>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+/*
+ String_Builder - построение строки (сообщения лога) в арене текущего потока без выделения памяти в куче.
+ В отличии от std::stringstream + std::string:
+ - буфер берется сдвигом указателя из thread_local Arena, после прогрева блоки арены переиспользуются: 0 вызовов operator new на сообщение.
+ - целые числа форматируются по 2 цифры за шаг через таблицу "00".."99" (в 2 раза меньше делений, чем по одной цифре), без locale и виртуальных вызовов ostream.
+ - числа с плавающей точкой форматируются std::to_chars (кратчайшее представление, в libstdc++ и MSVC - алгоритм Ryu).
+ - время форматируется один раз в секунду: строка "дд.мм.гггг_чч:мм:сс" кэшируется в потоке, localtime вызывается только при смене секунды.
+ - готовая строка отдается потребителю (Logger::Write) как std::string_view без копирования.
+ Каждый String_Builder запоминает позицию арены при создании (Arena::Save) и откатывает арену к ней при разрушении (Arena::Rollback), поэтому долгоживущий String_Builder (например, член объекта) не мешает переиспользовать память короткоживущих:
+ - живые String_Builder потока образуют стек (_previous), откат выполняет только последний созданный.
+ - если растет не последний String_Builder, позиции более новых сдвигаются за его новый буфер, чтобы их откат не освободил его.
+ - при разрушении не в порядке стека позиция переходит к следующему более новому String_Builder: его откат освободит и эту память.
+ - когда в потоке разрушается последний String_Builder, арена сбрасывается целиком (Arena::Reset).
+ Поэтому:
+ - View() действителен до разрушения String_Builder.
+ - String_Builder должен разрушаться в том же потоке, в котором создан.
+ - при росте старый буфер остается в арене до отката (рост в 2 раза, поэтому потери не больше размера строки).
+ */
+class String_Builder
+{
+    String_Builder(const String_Builder&) = delete;
+    String_Builder(String_Builder&&) noexcept = delete;
+    String_Builder& operator=(const String_Builder&) = delete;
+    String_Builder& operator=(String_Builder&&) noexcept = delete;
+    
+    static constexpr size_t initial_capacity = 256;
+    
+    // Арена потока, количество живых String_Builder в потоке и последний созданный из них
+    struct Local_Arena
+    {
+        Arena arena;
+        size_t builders = 0;
+        String_Builder* top = nullptr;
+    };
+    
+    static Local_Arena& Local() noexcept
+    {
+        thread_local Local_Arena local;
+        return local;
+    }
+
+public:
+    String_Builder() noexcept
+    {
+        Local_Arena& local = Local();
+        ++local.builders;
+        _previous = std::exchange(local.top, this);
+        _mark = local.arena.Save();
+    }
+    
+    ~String_Builder()
+    {
+        Local_Arena& local = Local();
+        if (local.top == this)
+        {
+            local.top = _previous;
+            local.arena.Rollback(_mark);
+        }
+        else
+        {
+            String_Builder* newer = local.top; // Разрушение не в порядке стека: более новый String_Builder наследует позицию
+            while (newer->_previous != this)
+                newer = newer->_previous;
+            newer->_previous = _previous;
+            newer->_mark = _mark;
+        }
+        
+        if (--local.builders == 0)
+            local.arena.Reset(); // Блоки остаются для следующих сообщений
+    }
+    
+    String_Builder& Append(std::string_view view)
+    {
+        std::memcpy(Grow(view.size()), view.data(), view.size());
+        return *this;
+    }
+    
+    String_Builder& Append(const char* data)
+    {
+        return Append(std::string_view(data));
+    }
+    
+    String_Builder& Append(char ch)
+    {
+        *Grow(1) = ch;
+        return *this;
+    }
+    
+    String_Builder& Append(bool value)
+    {
+        return Append(value ? std::string_view("true") : std::string_view("false"));
+    }
+    
+    template <std::integral T>
+    String_Builder& Append(T value)
+    {
+        char buffer[24]; // 20 цифр uint64_t + знак
+        char* end = buffer + sizeof(buffer);
+        char* begin = Format_Integer(value, end);
+        return Append(std::string_view(begin, static_cast<size_t>(end - begin)));
+    }
+    
+    template <std::floating_point T>
+    String_Builder& Append(T value)
+    {
+        char buffer[32];
+        auto [end, error] = std::to_chars(buffer, buffer + sizeof(buffer), value);
+        return Append(std::string_view(buffer, static_cast<size_t>(end - buffer)));
+    }
+    
+    // Локальное время в формате "дд.мм.гггг_чч:мм:сс": строка кэшируется в потоке и пересчитывается только при смене секунды
+    static std::string_view Local_Time()
+    {
+        const std::time_t time = std::time(nullptr);
+        thread_local std::time_t cached_time = -1;
+        thread_local char cached_text[sizeof("dd.mm.yyyy_hh:mm:ss") - 1];
+        if (time != cached_time)
+        {
+            std::tm tm{};
+#if defined(_WIN32)
+            localtime_s(&tm, &time);
+#else
+            localtime_r(&time, &tm);
+#endif
+            const int fields[] = {tm.tm_mday, tm.tm_mon + 1, (tm.tm_year + 1900) / 100, (tm.tm_year + 1900) % 100, tm.tm_hour, tm.tm_min, tm.tm_sec};
+            const char separators[] = {'.', '.', '\0', '_', ':', ':', '\0'};
+            char* ptr = cached_text;
+            for (size_t i = 0; i < std::size(fields); ++i)
+            {
+                *ptr++ = static_cast<char>('0' + fields[i] / 10);
+                *ptr++ = static_cast<char>('0' + fields[i] % 10);
+                if (separators[i])
+                    *ptr++ = separators[i];
+            }
+            cached_time = time;
+        }
+        return std::string_view(cached_text, sizeof(cached_text));
+    }
+    
+    template <typename T>
+    String_Builder& operator<<(const T& value)
+    {
+        return Append(value);
+    }
+    
+    std::string_view View() const noexcept { return std::string_view(_data, _size); }
+    const char* Data() const noexcept { return _data; }
+    size_t Size() const noexcept { return _size; }
+    bool Empty() const noexcept { return _size == 0; }
+    void Clear() noexcept { _size = 0; }
+    
+    operator std::string_view() const noexcept { return View(); }
+    friend std::ostream& operator<<(std::ostream& os, const String_Builder& builder) { return os << builder.View(); }
+
+private:
+    // Место под count символов в конце строки, при нехватке - новый буфер в арене в 2 раза больше
+    char* Grow(size_t count)
+    {
+        if (_size + count > _capacity)
+        {
+            const size_t capacity = std::max(_size + count, std::max(_capacity * 2, initial_capacity));
+            Local_Arena& local = Local();
+            char* data = static_cast<char*>(local.arena.Allocate(capacity, 1));
+            for (String_Builder* newer = local.top; newer != this; newer = newer->_previous) // Новый буфер не должен освободиться откатом более новых String_Builder
+                newer->_mark = local.arena.Save();
+            if (_size > 0)
+                std::memcpy(data, _data, _size);
+            _data = data;
+            _capacity = capacity;
+        }
+        
+        char* ptr = _data + _size;
+        _size += count;
+        return ptr;
+    }
+    
+    // Запись числа справа налево, начиная с end, возвращает указатель на первый символ
+    template <std::integral T>
+    static char* Format_Integer(T value, char* end) noexcept
+    {
+        static constexpr char digits[] =
+            "00010203040506070809"
+            "10111213141516171819"
+            "20212223242526272829"
+            "30313233343536373839"
+            "40414243444546474849"
+            "50515253545556575859"
+            "60616263646566676869"
+            "70717273747576777879"
+            "80818283848586878889"
+            "90919293949596979899";
+        
+        using Unsigned = std::make_unsigned_t<T>;
+        Unsigned number = static_cast<Unsigned>(value);
+        bool negative = false;
+        if constexpr (std::is_signed_v<T>)
+        {
+            if (value < 0)
+            {
+                negative = true;
+                number = Unsigned(0) - number; // Без переполнения для минимального значения
+            }
+        }
+        
+        while (number >= 100)
+        {
+            const size_t pair = static_cast<size_t>(number % 100) * 2;
+            number /= 100;
+            *--end = digits[pair + 1];
+            *--end = digits[pair];
+        }
+        
+        if (number >= 10)
+        {
+            const size_t pair = static_cast<size_t>(number) * 2;
+            *--end = digits[pair + 1];
+            *--end = digits[pair];
+        }
+        else
+        {
+            *--end = static_cast<char>('0' + number);
+        }
+        
+        if (negative)
+            *--end = '-';
+        return end;
+    }
+
+private:
+    char* _data = nullptr;
+    size_t _size = 0;
+    size_t _capacity = 0;
+    String_Builder* _previous = nullptr; // Предыдущий живой String_Builder потока
+    Arena::Mark _mark; // Позиция арены при создании
+};
+
+#endif /* String_Builder_h */
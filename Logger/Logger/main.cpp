@@ -1,4 +1,11 @@
 #include "Logger.h"
+#include "String_Builder.h"
+#include "Timer.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <ctime>
+#include <iomanip>
 
 /*
  Сайты:  https://stackoverflow.com/questions/26143930/xcode-how-to-set-current-working-directory-to-a-relative-path-for-an-executable
@@ -11,10 +18,84 @@ inline unsigned constexpr Hash(const char *iSource) noexcept
     return *iSource ? static_cast<unsigned int>(*iSource) + 33 * Hash(iSource + 1) : 5381;
 }
 
+static std::atomic<size_t> allocations = 0; // Счетчик вызовов operator new для бенчмарка
+
+void* operator new(size_t size)
+{
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* ptr = std::malloc(size))
+        return ptr;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, size_t) noexcept
+{
+    std::free(ptr);
+}
+
+// Прежний способ формирования строки лога: std::stringstream + LocalTime через put_time + конкатенация std::string
+std::string Old_Line(int order, double price)
+{
+    std::stringstream message;
+    message << "Order " << order << " price " << price << " filled";
+    
+    std::stringstream ss;
+    time_t t = std::time(nullptr);
+    auto tm = *localtime(&t);
+    ss << std::put_time(&tm, "%d.%m.%Y_%H:%M:%S");
+    
+    const std::string localTime = "[" + ss.str() + "] ";
+    const std::string type = "[Warning] ";
+    return localTime + type + message.str();
+}
+
+void Benchmark()
+{
+    static constexpr int messages = 200000;
+    
+    Timer timer;
+    size_t bytes = 0;
+    size_t before = allocations.load();
+    timer.start();
+    for (int i = 0; i < messages; ++i)
+        bytes += Old_Line(i, i * 0.25).size();
+    timer.stop();
+    std::cout << "stringstream + std::string: " << timer.elapsedMilliseconds() * 1e6 / messages << " ns/message, "
+              << double(allocations.load() - before) / messages << " allocations/message" << std::endl;
+    
+    String_Builder session; // Долгоживущий String_Builder: сообщения все равно откатывают арену к своей позиции, и она не растет
+    session << "session " << 1;
+    before = allocations.load();
+    timer.start();
+    for (int i = 0; i < messages; ++i)
+    {
+        String_Builder line;
+        line << '[' << String_Builder::Local_Time() << "] [Warning] " << "Order " << i << " price " << i * 0.25 << " filled";
+        bytes += line.Size();
+    }
+    timer.stop();
+    std::cout << "String_Builder: " << timer.elapsedMilliseconds() * 1e6 / messages << " ns/message, "
+              << double(allocations.load() - before) / messages << " allocations/message" << std::endl;
+    std::cout << "Bytes: " << bytes << std::endl;
+}
+
 int main(int argc, char *argv[])
 {
+    Benchmark();
     Logger::Instance();
     
+    // Сообщение собирается в арене потока и передается в Logger без копирования
+    {
+        String_Builder message;
+        message << "String_Builder: " << 42 << ' ' << -7 << ' ' << 3.5 << ' ' << true << '\n';
+        Logger::Write(Logger::INFO, message.View());
+    }
+    
     Logger::error << "Ошибка" << std::endl;
     Logger::warning << "Предупреждение" << std::endl;
     Logger::info << "Сообщение" << std::endl;
@@ -0,0 +1,233 @@
+#ifndef Blocking_Queue_h
+#define Blocking_Queue_h
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <utility>
+
+#include "Mpmc_Queue.h"
+
+/*
+ Блокирующая ограниченная очередь для нескольких писателей и читателей поверх кольцевого буфера Mpmc_Queue.
+ Pop на пустой очереди (и Push на полной) сначала коротко крутится (spin_count попыток), затем поток засыпает на C++20 atomic::wait, как atomic_flag::Spinlock20.
+ atomic::wait/notify_one - это futex в Linux (WaitOnAddress в Windows): поток спит в ядре по адресу atomic, без mutex и condition_variable, а пробуждение - один системный вызов.
+ Ожидание (Waiters):
+ - epoch - счетчик событий, на котором спят потоки: поток читает epoch, еще раз пробует операцию и засыпает, только если epoch не изменился.
+ - count - количество спящих (или собирающихся спать) потоков: если никто не спит, Push/Pop не увеличивает epoch и не делает системный вызов notify.
+ - notified - пробуждение уже отправлено, но разбуженный поток еще не проснулся: остальные Push/Pop не повторяют системный вызов (иначе, пока поток ждет планировщика, каждая операция делала бы notify).
+ Разбуженный поток сбрасывает notified и, если после его операции в очереди остались элементы (место), будит следующего.
+ Потерянное пробуждение исключено seq_cst барьерами по схеме Деккера: писатель (данные в буфер, барьер, чтение count) и читатель (count + 1, барьер, чтение буфера) - хотя бы один из них увидит запись другого.
+ Pop_Batch(out, max) - забирает до max элементов за одно пробуждение, пробуждает писателей один раз на пакет.
+ Close() - пробуждает всех: Pop возвращает false, когда очередь закрыта и пуста, Push в закрытую очередь - исключение.
+ */
+template <class T>
+class Blocking_Queue
+{
+    Blocking_Queue(const Blocking_Queue&) = delete;
+    Blocking_Queue(Blocking_Queue&&) noexcept = delete;
+    Blocking_Queue& operator=(const Blocking_Queue&) = delete;
+    Blocking_Queue& operator=(Blocking_Queue&&) noexcept = delete;
+    
+    // Потоки, ожидающие одного события (появления элементов или свободного места), на отдельной кэш-линии
+    struct alignas(64) Waiters
+    {
+        std::atomic<uint32_t> epoch = 0;
+        std::atomic<uint32_t> count = 0;
+        std::atomic<bool> notified = false;
+    };
+    
+    static constexpr int spin_count = 128;
+
+public:
+    explicit Blocking_Queue(size_t capacity) : _queue(capacity) {}
+    void Push(const T& value);
+    void Push(T&& value);
+    bool Try_Push(const T& value);
+    bool Try_Push(T&& value);
+    bool Pop(T& value); // Ждет элемент, false - очередь закрыта и пуста
+    bool Try_Pop(T& value);
+    size_t Pop_Batch(T* values, size_t max_count); // Ждет хотя бы один элемент, возвращает количество, 0 - очередь закрыта и пуста
+    void Close();
+    bool Closed() const noexcept;
+    bool Empty() const noexcept;
+    size_t Size() const noexcept;
+    size_t Capacity() const noexcept;
+
+private:
+    template <class Operation>
+    bool Wait(Waiters& waiters, Operation&& operation);
+    void Notify(Waiters& waiters, bool all = false);
+    bool Ready(const Waiters& waiters) const noexcept; // Есть элементы для _consumers или место для _producers
+
+private:
+    Mpmc_Queue<T> _queue;
+    Waiters _consumers; // Ждут элементы
+    Waiters _producers; // Ждут свободное место
+    std::atomic<bool> _closed = false;
+};
+
+template <class T>
+void Blocking_Queue<T>::Push(const T& value)
+{
+    if (!Wait(_producers, [&]() { return _queue.Try_Push(value); }))
+        throw std::runtime_error("Queue is closed");
+    Notify(_consumers);
+}
+
+template <class T>
+void Blocking_Queue<T>::Push(T&& value)
+{
+    if (!Wait(_producers, [&]() { return _queue.Try_Push(std::move(value)); })) // Try_Push перемещает только при успехе
+        throw std::runtime_error("Queue is closed");
+    Notify(_consumers);
+}
+
+template <class T>
+bool Blocking_Queue<T>::Try_Push(const T& value)
+{
+    if (Closed() || !_queue.Try_Push(value))
+        return false;
+    
+    Notify(_consumers);
+    return true;
+}
+
+template <class T>
+bool Blocking_Queue<T>::Try_Push(T&& value)
+{
+    if (Closed() || !_queue.Try_Push(std::move(value)))
+        return false;
+    
+    Notify(_consumers);
+    return true;
+}
+
+template <class T>
+bool Blocking_Queue<T>::Pop(T& value)
+{
+    if (!Wait(_consumers, [&]() { return _queue.Try_Pop(value); }) && !_queue.Try_Pop(value)) // Закрыта: оставшиеся элементы дочитываются
+        return false;
+    
+    Notify(_producers);
+    return true;
+}
+
+template <class T>
+bool Blocking_Queue<T>::Try_Pop(T& value)
+{
+    if (!_queue.Try_Pop(value))
+        return false;
+    
+    Notify(_producers);
+    return true;
+}
+
+template <class T>
+size_t Blocking_Queue<T>::Pop_Batch(T* values, size_t max_count)
+{
+    size_t count = 0;
+    if (!Wait(_consumers, [&]() { return (count = _queue.Try_Pop_Batch(values, max_count)) > 0; }))
+        count = _queue.Try_Pop_Batch(values, max_count);
+    
+    if (count > 0)
+        Notify(_producers, count > 1); // Освободилось несколько мест - может продолжить несколько писателей
+    return count;
+}
+
+template <class T>
+void Blocking_Queue<T>::Close()
+{
+    _closed.store(true, std::memory_order_seq_cst);
+    for (Waiters* waiters : {&_consumers, &_producers})
+    {
+        waiters->epoch.fetch_add(1, std::memory_order_seq_cst);
+        waiters->epoch.notify_all();
+    }
+}
+
+template <class T>
+bool Blocking_Queue<T>::Closed() const noexcept
+{
+    return _closed.load(std::memory_order_acquire);
+}
+
+template <class T>
+bool Blocking_Queue<T>::Empty() const noexcept
+{
+    return _queue.Empty();
+}
+
+template <class T>
+size_t Blocking_Queue<T>::Size() const noexcept
+{
+    return _queue.Size();
+}
+
+template <class T>
+size_t Blocking_Queue<T>::Capacity() const noexcept
+{
+    return _queue.Capacity();
+}
+
+// Повтор operation, пока она не выполнится (true) или очередь не закроют (false): короткий spin, затем сон до изменения epoch
+template <class T>
+template <class Operation>
+bool Blocking_Queue<T>::Wait(Waiters& waiters, Operation&& operation)
+{
+    for (int i = 0; i < spin_count; ++i)
+    {
+        if (Closed())
+            return false;
+        if (operation())
+            return true;
+    }
+    
+    while (!Closed())
+    {
+        waiters.count.fetch_add(1, std::memory_order_seq_cst);
+        const uint32_t epoch = waiters.epoch.load(std::memory_order_acquire);
+        waiters.notified.store(false, std::memory_order_relaxed); // После чтения epoch: следующее изменение epoch разбудит этот поток
+        std::atomic_thread_fence(std::memory_order_seq_cst); // Парный барьеру в Notify
+        bool done = operation();
+        if (!done && !Closed())
+        {
+            waiters.epoch.wait(epoch, std::memory_order_acquire); // Не засыпает, если epoch уже изменился
+            waiters.notified.store(false, std::memory_order_seq_cst);
+            done = operation(); // Элемент мог забрать другой поток, тогда снова спать
+        }
+        waiters.count.fetch_sub(1, std::memory_order_seq_cst);
+        
+        if (done)
+        {
+            if (Ready(waiters)) // Пока этот поток просыпался, пришли еще элементы, а их Push не будил спящих
+                Notify(waiters);
+            return true;
+        }
+    }
+    
+    return false;
+}
+
+template <class T>
+void Blocking_Queue<T>::Notify(Waiters& waiters, bool all)
+{
+    std::atomic_thread_fence(std::memory_order_seq_cst); // Изменение буфера видно до чтения count
+    if (waiters.count.load(std::memory_order_relaxed) == 0 || waiters.notified.exchange(true, std::memory_order_seq_cst))
+        return;
+    
+    waiters.epoch.fetch_add(1, std::memory_order_release);
+    if (all)
+        waiters.epoch.notify_all();
+    else
+        waiters.epoch.notify_one();
+}
+
+template <class T>
+bool Blocking_Queue<T>::Ready(const Waiters& waiters) const noexcept
+{
+    return &waiters == &_consumers ? !_queue.Empty() : _queue.Size() < _queue.Capacity();
+}
+
+#endif /* Blocking_Queue_h */
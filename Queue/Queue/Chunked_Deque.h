@@ -0,0 +1,571 @@
+#ifndef Chunked_Deque_h
+#define Chunked_Deque_h
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <initializer_list>
+#include <iostream>
+#include <new>
+#include <stdexcept>
+#include <utility>
+
+/*
+ Chunked_Deque (двусторонняя очередь на чанках) - элементы хранятся в чанках по Chunk_Size элементов, указатели на чанки - в кольцевом буфере (map).
+ element[index] = map[(_map_head + (_begin + index) / Chunk_Size) % map_capacity][(_begin + index) % Chunk_Size], Chunk_Size и емкость map - степени двойки, поэтому деление и остаток - это сдвиг и маска.
+ В отличии от std::deque (libstdc++):
+ - размер чанка задается параметром, по умолчанию 4 КБ (у libstdc++ 512 байт: для больших T это 1-2 элемента в блоке и выделение памяти почти на каждый Push).
+ - map кольцевой: Push_Front/Pop_Front сдвигают голову кольца, а не элементы map, поэтому map растет только когда заполнен целиком, и не нужно «переезжать» в середину map.
+ - освобожденные чанки не возвращаются системе, а кэшируются в списке свободных чанков (до cache_limit штук) и переиспользуются следующим Push:
+   очередь (Push_Back + Pop_Front) или стек (Push_Back + Pop_Back) в установившемся режиме не выделяет память совсем.
+ - Shrink_To_Fit возвращает системе кэш чанков и уменьшает map (std::deque свой map не уменьшает никогда).
+ В отличии от linked_list::Queue/Stack - нет выделения памяти и указателя next на каждый элемент, соседние элементы лежат подряд в памяти.
+ Указатели/ссылки на элементы остаются валидными при Push_Front/Push_Back (элементы не перемещаются), индексы - нет.
+ Поэтому первый и последний элементы хранятся указателями (_front/_back): Front/Back и Push/Pop внутри чанка не обращаются к map.
+ Для адаптеров DEQUE::Queue/DEQUE::Stack (параметр Container) есть интерфейс std-контейнера: emplace_back, front, back, pop_front, pop_back, empty, size.
+ */
+template <class T, size_t Chunk_Size = std::bit_floor(std::max<size_t>(4096 / sizeof(T), 16))>
+class Chunked_Deque
+{
+    static_assert(Chunk_Size > 0 && (Chunk_Size & (Chunk_Size - 1)) == 0, "Chunk_Size must be a power of two");
+    
+    using size_type = size_t;
+    using value_type = T;
+    using reference = value_type&;
+    using const_reference = const value_type&;
+    
+    static constexpr size_type shift = std::countr_zero(Chunk_Size);
+    static constexpr size_type mask = Chunk_Size - 1;
+    static constexpr size_type cache_limit = 4; // Сколько свободных чанков хранится для переиспользования
+    
+    // Свободный чанк: его память используется как узел списка
+    struct Free_Chunk
+    {
+        Free_Chunk* next = nullptr;
+    };
+
+public:
+    class Iterator;
+    
+    Chunked_Deque() = default;
+    Chunked_Deque(const std::initializer_list<T>& list);
+    Chunked_Deque(const Chunked_Deque& other);
+    Chunked_Deque(Chunked_Deque&& other) noexcept;
+    ~Chunked_Deque();
+    Chunked_Deque& operator=(const Chunked_Deque& other);
+    Chunked_Deque& operator=(Chunked_Deque&& other) noexcept;
+    
+    reference operator[](size_type index);
+    const_reference operator[](size_type index) const;
+    reference At(size_type index);
+    const_reference At(size_type index) const;
+    reference Front();
+    const_reference Front() const;
+    reference Back();
+    const_reference Back() const;
+    
+    template <typename ...Args>
+    reference Emplace_Back(Args&& ...args);
+    template <typename ...Args>
+    reference Emplace_Front(Args&& ...args);
+    void Push_Back(const T& value);
+    void Push_Back(T&& value);
+    void Push_Front(const T& value);
+    void Push_Front(T&& value);
+    void Pop_Back();
+    void Pop_Front();
+    
+    void Swap(Chunked_Deque& other) noexcept;
+    bool Empty() const noexcept;
+    size_type Size() const noexcept;
+    size_type Chunks() const noexcept; // Чанки с элементами, без кэша
+    size_type Cached_Chunks() const noexcept;
+    void Clear() noexcept; // Чанки уходят в кэш (до cache_limit), map сохраняется
+    void Shrink_To_Fit(); // Освобождение кэша чанков и уменьшение map
+    
+    Iterator Begin() noexcept;
+    Iterator End() noexcept;
+    
+    // Интерфейс std-контейнера для DEQUE::Queue/DEQUE::Stack
+    template <typename ...Args>
+    reference emplace_back(Args&& ...args) { return Emplace_Back(std::forward<Args>(args)...); }
+    reference front() { return Front(); }
+    const_reference front() const { return Front(); }
+    reference back() { return Back(); }
+    const_reference back() const { return Back(); }
+    void pop_front() { Pop_Front(); }
+    void pop_back() { Pop_Back(); }
+    bool empty() const noexcept { return Empty(); }
+    size_type size() const noexcept { return Size(); }
+    
+    template <typename U, size_t N>
+    friend std::ostream& operator<<(std::ostream& os, const Chunked_Deque<U, N>& deque);
+
+private:
+    T* Element(size_type index) const noexcept
+    {
+        const size_type position = _begin + index;
+        return _map[(_map_head + (position >> shift)) & (_map_capacity - 1)] + (position & mask);
+    }
+    
+    T* Acquire_Chunk();
+    void Release_Chunk(T* chunk) noexcept;
+    static void Deallocate_Chunk(T* chunk) noexcept;
+    void Reserve_Map(size_type chunks);
+    void Copy(const Chunked_Deque& other);
+
+private:
+    T** _map = nullptr;          // Кольцевой буфер указателей на чанки
+    size_type _map_capacity = 0; // Степень двойки
+    size_type _map_head = 0;     // Индекс первого чанка в _map
+    size_type _chunks = 0;       // Количество чанков в _map
+    size_type _begin = 0;        // Позиция первого элемента в первом чанке
+    size_type _size = 0;
+    T* _front = nullptr;         // Первый элемент, nullptr - пусто
+    T* _back = nullptr;          // Последний элемент
+    Free_Chunk* _cache = nullptr;
+    size_type _cached = 0;
+};
+
+template <class T, size_t Chunk_Size>
+class Chunked_Deque<T, Chunk_Size>::Iterator
+{
+public:
+    Iterator(Chunked_Deque* deque, size_type index) noexcept : _deque(deque), _index(index) {}
+    
+    Iterator& operator++() noexcept { ++_index; return *this; }
+    Iterator operator++(int) noexcept { Iterator temp = *this; ++_index; return temp; }
+    Iterator& operator--() noexcept { --_index; return *this; }
+    Iterator operator--(int) noexcept { Iterator temp = *this; --_index; return temp; }
+    reference operator*() const noexcept { return (*_deque)[_index]; }
+    T* operator->() const noexcept { return &(*_deque)[_index]; }
+    bool operator==(const Iterator& other) const noexcept { return _deque == other._deque && _index == other._index; }
+    bool operator!=(const Iterator& other) const noexcept { return !(*this == other); }
+
+private:
+    Chunked_Deque* _deque = nullptr;
+    size_type _index = 0;
+};
+
+template <class T, size_t Chunk_Size>
+Chunked_Deque<T, Chunk_Size>::Chunked_Deque(const std::initializer_list<T>& list)
+{
+    for (const auto& value : list)
+        Emplace_Back(value);
+}
+
+template <class T, size_t Chunk_Size>
+Chunked_Deque<T, Chunk_Size>::Chunked_Deque(const Chunked_Deque& other)
+{
+    Copy(other);
+}
+
+template <class T, size_t Chunk_Size>
+Chunked_Deque<T, Chunk_Size>::Chunked_Deque(Chunked_Deque&& other) noexcept
+{
+    Swap(other);
+}
+
+template <class T, size_t Chunk_Size>
+Chunked_Deque<T, Chunk_Size>::~Chunked_Deque()
+{
+    Clear();
+    Shrink_To_Fit();
+    delete[] _map;
+}
+
+template <class T, size_t Chunk_Size>
+Chunked_Deque<T, Chunk_Size>& Chunked_Deque<T, Chunk_Size>::operator=(const Chunked_Deque& other)
+{
+    if (this == &other) // object = object
+        return *this;
+    
+    Clear();
+    Copy(other);
+    
+    return *this;
+}
+
+template <class T, size_t Chunk_Size>
+Chunked_Deque<T, Chunk_Size>& Chunked_Deque<T, Chunk_Size>::operator=(Chunked_Deque&& other) noexcept
+{
+    if (this == &other) // object = object
+        return *this;
+    
+    Chunked_Deque temp(std::move(other));
+    Swap(temp);
+    
+    return *this;
+}
+
+template <class T, size_t Chunk_Size>
+Chunked_Deque<T, Chunk_Size>::reference Chunked_Deque<T, Chunk_Size>::operator[](size_type index)
+{
+    return *Element(index);
+}
+
+template <class T, size_t Chunk_Size>
+Chunked_Deque<T, Chunk_Size>::const_reference Chunked_Deque<T, Chunk_Size>::operator[](size_type index) const
+{
+    return *Element(index);
+}
+
+template <class T, size_t Chunk_Size>
+Chunked_Deque<T, Chunk_Size>::reference Chunked_Deque<T, Chunk_Size>::At(size_type index)
+{
+    if (index >= _size)
+        throw std::out_of_range("Index is out of range!");
+    
+    return *Element(index);
+}
+
+template <class T, size_t Chunk_Size>
+Chunked_Deque<T, Chunk_Size>::const_reference Chunked_Deque<T, Chunk_Size>::At(size_type index) const
+{
+    if (index >= _size)
+        throw std::out_of_range("Index is out of range!");
+    
+    return *Element(index);
+}
+
+template <class T, size_t Chunk_Size>
+Chunked_Deque<T, Chunk_Size>::reference Chunked_Deque<T, Chunk_Size>::Front()
+{
+    if (Empty())
+        throw std::runtime_error("Deque is empty");
+    
+    return *_front;
+}
+
+template <class T, size_t Chunk_Size>
+Chunked_Deque<T, Chunk_Size>::const_reference Chunked_Deque<T, Chunk_Size>::Front() const
+{
+    if (Empty())
+        throw std::runtime_error("Deque is empty");
+    
+    return *_front;
+}
+
+template <class T, size_t Chunk_Size>
+Chunked_Deque<T, Chunk_Size>::reference Chunked_Deque<T, Chunk_Size>::Back()
+{
+    if (Empty())
+        throw std::runtime_error("Deque is empty");
+    
+    return *_back;
+}
+
+template <class T, size_t Chunk_Size>
+Chunked_Deque<T, Chunk_Size>::const_reference Chunked_Deque<T, Chunk_Size>::Back() const
+{
+    if (Empty())
+        throw std::runtime_error("Deque is empty");
+    
+    return *_back;
+}
+
+template <class T, size_t Chunk_Size>
+template <typename ...Args>
+Chunked_Deque<T, Chunk_Size>::reference Chunked_Deque<T, Chunk_Size>::Emplace_Back(Args&& ...args)
+{
+    if ((_begin + _size) & mask) // Место есть в чанке последнего элемента
+    {
+        T* element = _back + 1;
+        new (element) T(std::forward<Args>(args)...);
+        ++_size;
+        _back = element;
+        return *element;
+    }
+    
+    if (_begin + _size == _chunks << shift) // Последний чанк заполнен
+    {
+        Reserve_Map(_chunks + 1);
+        _map[(_map_head + _chunks) & (_map_capacity - 1)] = Acquire_Chunk();
+        ++_chunks;
+    }
+    
+    T* element = Element(_size);
+    new (element) T(std::forward<Args>(args)...);
+    if (_size++ == 0)
+        _front = element;
+    _back = element;
+    return *element;
+}
+
+template <class T, size_t Chunk_Size>
+template <typename ...Args>
+Chunked_Deque<T, Chunk_Size>::reference Chunked_Deque<T, Chunk_Size>::Emplace_Front(Args&& ...args)
+{
+    if (_begin == 0) // Первый чанк заполнен с начала
+    {
+        Reserve_Map(_chunks + 1);
+        T* chunk = Acquire_Chunk();
+        _map_head = (_map_head - 1) & (_map_capacity - 1);
+        _map[_map_head] = chunk;
+        ++_chunks;
+        _begin = Chunk_Size;
+    }
+    
+    T* element = _map[_map_head] + (_begin - 1);
+    new (element) T(std::forward<Args>(args)...);
+    --_begin;
+    if (_size++ == 0)
+        _back = element;
+    _front = element;
+    return *element;
+}
+
+template <class T, size_t Chunk_Size>
+void Chunked_Deque<T, Chunk_Size>::Push_Back(const T& value)
+{
+    Emplace_Back(value);
+}
+
+template <class T, size_t Chunk_Size>
+void Chunked_Deque<T, Chunk_Size>::Push_Back(T&& value)
+{
+    Emplace_Back(std::move(value));
+}
+
+template <class T, size_t Chunk_Size>
+void Chunked_Deque<T, Chunk_Size>::Push_Front(const T& value)
+{
+    Emplace_Front(value);
+}
+
+template <class T, size_t Chunk_Size>
+void Chunked_Deque<T, Chunk_Size>::Push_Front(T&& value)
+{
+    Emplace_Front(std::move(value));
+}
+
+template <class T, size_t Chunk_Size>
+void Chunked_Deque<T, Chunk_Size>::Pop_Back()
+{
+    if (Empty())
+        throw std::runtime_error("Deque is empty");
+    
+    _back->~T();
+    --_size;
+    if (_size == 0 || _begin + _size == (_chunks - 1) << shift) // Последний чанк опустел
+    {
+        --_chunks;
+        Release_Chunk(_map[(_map_head + _chunks) & (_map_capacity - 1)]);
+        if (_chunks == 0)
+            _begin = 0;
+        _back = _size == 0 ? nullptr : Element(_size - 1);
+        if (_size == 0)
+            _front = nullptr;
+    }
+    else
+    {
+        --_back;
+    }
+}
+
+template <class T, size_t Chunk_Size>
+void Chunked_Deque<T, Chunk_Size>::Pop_Front()
+{
+    if (Empty())
+        throw std::runtime_error("Deque is empty");
+    
+    _front->~T();
+    ++_begin;
+    --_size;
+    if (_begin == Chunk_Size || _size == 0) // Первый чанк опустел
+    {
+        Release_Chunk(_map[_map_head]);
+        _map_head = (_map_head + 1) & (_map_capacity - 1);
+        --_chunks;
+        _begin = 0;
+        _front = _size == 0 ? nullptr : _map[_map_head];
+        if (_size == 0)
+            _back = nullptr;
+    }
+    else
+    {
+        ++_front;
+    }
+}
+
+template <class T, size_t Chunk_Size>
+void Chunked_Deque<T, Chunk_Size>::Swap(Chunked_Deque& other) noexcept
+{
+    if (this == &other) // object.Swap(object)
+        return;
+    
+    std::swap(_map, other._map);
+    std::swap(_map_capacity, other._map_capacity);
+    std::swap(_map_head, other._map_head);
+    std::swap(_chunks, other._chunks);
+    std::swap(_begin, other._begin);
+    std::swap(_size, other._size);
+    std::swap(_front, other._front);
+    std::swap(_back, other._back);
+    std::swap(_cache, other._cache);
+    std::swap(_cached, other._cached);
+}
+
+template <class T, size_t Chunk_Size>
+bool Chunked_Deque<T, Chunk_Size>::Empty() const noexcept
+{
+    return _size == 0;
+}
+
+template <class T, size_t Chunk_Size>
+Chunked_Deque<T, Chunk_Size>::size_type Chunked_Deque<T, Chunk_Size>::Size() const noexcept
+{
+    return _size;
+}
+
+template <class T, size_t Chunk_Size>
+Chunked_Deque<T, Chunk_Size>::size_type Chunked_Deque<T, Chunk_Size>::Chunks() const noexcept
+{
+    return _chunks;
+}
+
+template <class T, size_t Chunk_Size>
+Chunked_Deque<T, Chunk_Size>::size_type Chunked_Deque<T, Chunk_Size>::Cached_Chunks() const noexcept
+{
+    return _cached;
+}
+
+template <class T, size_t Chunk_Size>
+void Chunked_Deque<T, Chunk_Size>::Clear() noexcept
+{
+    for (size_type i = 0; i < _size; ++i)
+        Element(i)->~T();
+    
+    for (size_type i = 0; i < _chunks; ++i)
+        Release_Chunk(_map[(_map_head + i) & (_map_capacity - 1)]);
+    
+    _map_head = 0;
+    _chunks = 0;
+    _begin = 0;
+    _size = 0;
+    _front = nullptr;
+    _back = nullptr;
+}
+
+template <class T, size_t Chunk_Size>
+void Chunked_Deque<T, Chunk_Size>::Shrink_To_Fit()
+{
+    while (_cache)
+    {
+        Free_Chunk* next = _cache->next;
+        Deallocate_Chunk(reinterpret_cast<T*>(_cache));
+        _cache = next;
+    }
+    _cached = 0;
+    
+    if (_chunks == 0)
+    {
+        delete[] _map;
+        _map = nullptr;
+        _map_capacity = 0;
+        _map_head = 0;
+    }
+    else if (_chunks <= _map_capacity / 4) // Уменьшение map в 2 раза с запасом, чтобы чередование Push/Pop не перевыделяло map
+    {
+        const size_type capacity = std::bit_ceil(_chunks * 2);
+        T** map = new T*[capacity];
+        for (size_type i = 0; i < _chunks; ++i)
+            map[i] = _map[(_map_head + i) & (_map_capacity - 1)];
+        
+        delete[] _map;
+        _map = map;
+        _map_capacity = capacity;
+        _map_head = 0;
+    }
+}
+
+template <class T, size_t Chunk_Size>
+Chunked_Deque<T, Chunk_Size>::Iterator Chunked_Deque<T, Chunk_Size>::Begin() noexcept
+{
+    return Iterator(this, 0);
+}
+
+template <class T, size_t Chunk_Size>
+Chunked_Deque<T, Chunk_Size>::Iterator Chunked_Deque<T, Chunk_Size>::End() noexcept
+{
+    return Iterator(this, _size);
+}
+
+// Свободный чанк из кэша или новый, память под Chunk_Size элементов без их создания
+template <class T, size_t Chunk_Size>
+T* Chunked_Deque<T, Chunk_Size>::Acquire_Chunk()
+{
+    if (_cache)
+    {
+        Free_Chunk* chunk = _cache;
+        _cache = chunk->next;
+        --_cached;
+        chunk->~Free_Chunk();
+        return reinterpret_cast<T*>(chunk);
+    }
+    
+    if constexpr (alignof(T) > __STDCPP_DEFAULT_NEW_ALIGNMENT__)
+        return static_cast<T*>(operator new(sizeof(T) * Chunk_Size, std::align_val_t(alignof(T))));
+    else
+        return static_cast<T*>(operator new(sizeof(T) * Chunk_Size));
+}
+
+template <class T, size_t Chunk_Size>
+void Chunked_Deque<T, Chunk_Size>::Release_Chunk(T* chunk) noexcept
+{
+    static_assert(sizeof(T) * Chunk_Size >= sizeof(Free_Chunk));
+    
+    if (_cached == cache_limit)
+    {
+        Deallocate_Chunk(chunk);
+        return;
+    }
+    
+    _cache = new (chunk) Free_Chunk{_cache};
+    ++_cached;
+}
+
+template <class T, size_t Chunk_Size>
+void Chunked_Deque<T, Chunk_Size>::Deallocate_Chunk(T* chunk) noexcept
+{
+    if constexpr (alignof(T) > __STDCPP_DEFAULT_NEW_ALIGNMENT__)
+        operator delete(static_cast<void*>(chunk), std::align_val_t(alignof(T)));
+    else
+        operator delete(static_cast<void*>(chunk));
+}
+
+// Рост map в 2 раза: чанки переписываются подряд с начала нового кольца
+template <class T, size_t Chunk_Size>
+void Chunked_Deque<T, Chunk_Size>::Reserve_Map(size_type chunks)
+{
+    if (chunks <= _map_capacity)
+        return;
+    
+    const size_type capacity = std::max<size_type>(std::bit_ceil(chunks), 8);
+    T** map = new T*[capacity];
+    for (size_type i = 0; i < _chunks; ++i)
+        map[i] = _map[(_map_head + i) & (_map_capacity - 1)];
+    
+    delete[] _map;
+    _map = map;
+    _map_capacity = capacity;
+    _map_head = 0;
+}
+
+template <class T, size_t Chunk_Size>
+void Chunked_Deque<T, Chunk_Size>::Copy(const Chunked_Deque& other)
+{
+    for (size_type i = 0; i < other._size; ++i)
+        Emplace_Back(other[i]);
+}
+
+template <typename U, size_t N>
+std::ostream& operator<<(std::ostream& os, const Chunked_Deque<U, N>& deque)
+{
+    for (size_t i = 0; i < deque.Size(); ++i)
+        os << deque[i] << " ";
+    
+    return os;
+}
+
+#endif /* Chunked_Deque_h */
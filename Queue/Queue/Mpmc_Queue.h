@@ -0,0 +1,228 @@
+#ifndef Mpmc_Queue_h
+#define Mpmc_Queue_h
+
+#include <atomic>
+#include <cstddef>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+/*
+ Ограниченная lock-free очередь для нескольких писателей и читателей (MPMC - multi producer multi consumer) по схеме Дмитрия Вьюкова: массив ячеек с номером последовательности (sequence) в каждой ячейке.
+ - писатель берет позицию pos из _tail и проверяет, что у ячейки sequence == pos (ячейка свободна на этом круге), занимает позицию CAS-ом _tail: pos -> pos + 1, записывает значение и публикует sequence = pos + 1.
+ - читатель берет позицию pos из _head и проверяет, что у ячейки sequence == pos + 1 (значение записано), занимает позицию CAS-ом _head, забирает значение и освобождает ячейку на следующий круг: sequence = pos + capacity.
+ Писатели конкурируют только между собой за _tail, читатели - только за _head, а писатель и читатель встречаются лишь на одной ячейке, и то через ее sequence, а не через общий счетчик.
+ Ячейка занята между CAS и публикацией sequence: если поток вытеснен в этот момент, соседние операции этой ячейки ждут (lock-free в смысле отсутствия mutex, но не wait-free).
+ Емкость - степень двойки (округляется вверх), память выделяется один раз в конструкторе.
+ Try_Push_Batch/Try_Pop_Batch занимают несколько подряд идущих готовых ячеек одним CAS.
+ Перемещение T не должно бросать исключений: исключение между CAS и публикацией sequence оставило бы ячейку занятой навсегда. Если конструктор T из args может бросить, Try_Emplace создает значение до CAS.
+ */
+template <class T>
+class Mpmc_Queue
+{
+    static_assert(std::is_nothrow_move_constructible_v<T> && std::is_nothrow_move_assignable_v<T>, "Mpmc_Queue: T must be nothrow movable");
+    
+    Mpmc_Queue(const Mpmc_Queue&) = delete;
+    Mpmc_Queue(Mpmc_Queue&&) noexcept = delete;
+    Mpmc_Queue& operator=(const Mpmc_Queue&) = delete;
+    Mpmc_Queue& operator=(Mpmc_Queue&&) noexcept = delete;
+    
+    struct Cell
+    {
+        T* Value() noexcept { return std::launder(reinterpret_cast<T*>(storage)); }
+        
+        std::atomic<size_t> sequence = 0;
+        alignas(T) unsigned char storage[sizeof(T)];
+    };
+
+public:
+    explicit Mpmc_Queue(size_t capacity);
+    ~Mpmc_Queue();
+    template <typename ...Args>
+    bool Try_Emplace(Args&& ...args); // false - очередь полна
+    bool Try_Push(const T& value);
+    bool Try_Push(T&& value);
+    bool Try_Pop(T& value); // false - очередь пуста
+    size_t Try_Push_Batch(T* values, size_t count); // Перемещает из values сколько поместится, возвращает количество
+    size_t Try_Pop_Batch(T* values, size_t count); // Перемещает в values до count элементов, возвращает количество
+    bool Empty() const noexcept;
+    size_t Size() const noexcept; // Приблизительный: другие потоки могут изменить очередь сразу после чтения
+    size_t Capacity() const noexcept;
+
+private:
+    Cell& At(size_t position) noexcept { return _cells[position & _mask]; }
+    size_t Claim(std::atomic<size_t>& index, size_t count, size_t ready_offset, size_t& position) noexcept;
+
+private:
+    Cell* _cells = nullptr;
+    size_t _mask = 0;
+    alignas(64) std::atomic<size_t> _tail = 0; // Позиция следующей записи
+    alignas(64) std::atomic<size_t> _head = 0; // Позиция следующего чтения
+};
+
+template <class T>
+Mpmc_Queue<T>::Mpmc_Queue(size_t capacity)
+{
+    if (capacity < 2)
+        throw std::invalid_argument("capacity must be at least 2");
+    
+    size_t size = 2;
+    while (size < capacity)
+        size <<= 1;
+    
+    _cells = new Cell[size];
+    _mask = size - 1;
+    for (size_t i = 0; i < size; ++i)
+        _cells[i].sequence.store(i, std::memory_order_relaxed);
+}
+
+// Разрушение без конкурентного доступа: разрушаются оставшиеся элементы
+template <class T>
+Mpmc_Queue<T>::~Mpmc_Queue()
+{
+    const size_t tail = _tail.load(std::memory_order_acquire);
+    for (size_t head = _head.load(std::memory_order_relaxed); head != tail; ++head)
+        At(head).Value()->~T();
+    
+    delete[] _cells;
+}
+
+template <class T>
+template <typename ...Args>
+bool Mpmc_Queue<T>::Try_Emplace(Args&& ...args)
+{
+    if constexpr (!std::is_nothrow_constructible_v<T, Args&&...>)
+    {
+        T value(std::forward<Args>(args)...); // Исключение здесь не затрагивает очередь
+        return Try_Emplace(std::move(value));
+    }
+    else
+    {
+        size_t position = 0;
+        if (Claim(_tail, 1, 0, position) == 0)
+            return false;
+        
+        Cell& cell = At(position);
+        new (cell.storage) T(std::forward<Args>(args)...);
+        cell.sequence.store(position + 1, std::memory_order_release); // Значение видно читателю только после записи
+        return true;
+    }
+}
+
+template <class T>
+bool Mpmc_Queue<T>::Try_Push(const T& value)
+{
+    return Try_Emplace(value);
+}
+
+template <class T>
+bool Mpmc_Queue<T>::Try_Push(T&& value)
+{
+    return Try_Emplace(std::move(value));
+}
+
+template <class T>
+bool Mpmc_Queue<T>::Try_Pop(T& value)
+{
+    size_t position = 0;
+    if (Claim(_head, 1, 1, position) == 0)
+        return false;
+    
+    Cell& cell = At(position);
+    value = std::move(*cell.Value());
+    cell.Value()->~T();
+    cell.sequence.store(position + _mask + 1, std::memory_order_release); // Свободна для писателя следующего круга
+    return true;
+}
+
+template <class T>
+size_t Mpmc_Queue<T>::Try_Push_Batch(T* values, size_t count)
+{
+    size_t position = 0;
+    count = Claim(_tail, count, 0, position);
+    for (size_t i = 0; i < count; ++i)
+    {
+        Cell& cell = At(position + i);
+        new (cell.storage) T(std::move(values[i]));
+        cell.sequence.store(position + i + 1, std::memory_order_release);
+    }
+    
+    return count;
+}
+
+template <class T>
+size_t Mpmc_Queue<T>::Try_Pop_Batch(T* values, size_t count)
+{
+    size_t position = 0;
+    count = Claim(_head, count, 1, position);
+    for (size_t i = 0; i < count; ++i)
+    {
+        Cell& cell = At(position + i);
+        values[i] = std::move(*cell.Value());
+        cell.Value()->~T();
+        cell.sequence.store(position + i + _mask + 1, std::memory_order_release);
+    }
+    
+    return count;
+}
+
+template <class T>
+bool Mpmc_Queue<T>::Empty() const noexcept
+{
+    return Size() == 0;
+}
+
+template <class T>
+size_t Mpmc_Queue<T>::Size() const noexcept
+{
+    const size_t head = _head.load(std::memory_order_acquire);
+    const size_t tail = _tail.load(std::memory_order_acquire);
+    return tail > head ? tail - head : 0; // Индексы читаются не одновременно
+}
+
+template <class T>
+size_t Mpmc_Queue<T>::Capacity() const noexcept
+{
+    return _mask + 1;
+}
+
+/*
+ Захват до count подряд идущих готовых ячеек, начиная с index: ячейка позиции p готова, если ее sequence == p + ready_offset (0 - свободна для писателя, 1 - записана для читателя).
+ Ячейки, готовые на момент проверки, не может занять никто другой, пока index не сдвинут, поэтому их достаточно проверить до CAS, а CAS занимает сразу все.
+ Возвращает количество занятых ячеек (0 - очередь полна/пуста), position - первая занятая позиция.
+ */
+template <class T>
+size_t Mpmc_Queue<T>::Claim(std::atomic<size_t>& index, size_t count, size_t ready_offset, size_t& position) noexcept
+{
+    position = index.load(std::memory_order_relaxed);
+    while (count > 0)
+    {
+        size_t ready = 0;
+        size_t sequence = 0;
+        for (; ready < count; ++ready)
+        {
+            sequence = At(position + ready).sequence.load(std::memory_order_acquire);
+            if (sequence != position + ready + ready_offset)
+                break;
+        }
+        
+        if (ready > 0)
+        {
+            if (index.compare_exchange_weak(position, position + ready, std::memory_order_relaxed))
+                return ready;
+        }
+        else if (sequence < position + ready_offset) // Первая ячейка еще не освобождена читателем прошлого круга / не записана писателем
+        {
+            return 0;
+        }
+        else // Позицию уже занял другой поток
+        {
+            position = index.load(std::memory_order_relaxed);
+        }
+    }
+    
+    return 0;
+}
+
+#endif /* Mpmc_Queue_h */
@@ -0,0 +1,235 @@
+#ifndef Mpsc_Queue_h
+#define Mpsc_Queue_h
+
+#include <atomic>
+#include <cstddef>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+
+/*
+ Интрузивная очередь для нескольких писателей и одного читателя (MPSC - multi producer single consumer) по схеме Дмитрия Вьюкова.
+ Связь (Mpsc_Hook) лежит внутри самого сообщения, как у Intrusive_List: очередь не владеет сообщениями и не выделяет память.
+ - Push (писатели) - wait-free, одна атомарная операция: exchange заменяет _head (последний узел) на новый узел, затем старый последний узел ссылается на новый.
+ - Front/Pop (только читатель) - без атомарных read-modify-write: читатель идет по ссылкам next от _tail (первый узел).
+ В отличии от Mpmc_Queue - неограниченная (нет «очередь полна») и писатели не повторяют CAS при конкуренции, поэтому цена Push не растет с количеством писателей (кроме общей кэш-линии _head).
+ Фиктивный узел _stub: очередь никогда не бывает пустой в смысле связей, поэтому Push не проверяет, пуста ли очередь, а читатель возвращает _stub в конец, когда забирает последний узел.
+ Между exchange и записью next писатель уже поставил узел, но он еще не связан с предыдущим: если писателя вытеснят в этот момент, Pop последнего узла ждет его (Push wait-free, Pop - нет).
+ Объект должен жить, пока он в очереди, и не может быть в двух очередях через один hook.
+ */
+struct Mpsc_Hook
+{
+    std::atomic<Mpsc_Hook*> next = nullptr;
+};
+
+namespace linked_list
+{
+    template <class T, Mpsc_Hook T::*Hook>
+    class Intrusive_Mpsc_Queue
+    {
+        Intrusive_Mpsc_Queue(const Intrusive_Mpsc_Queue&) = delete;
+        Intrusive_Mpsc_Queue(Intrusive_Mpsc_Queue&&) noexcept = delete;
+        Intrusive_Mpsc_Queue& operator=(const Intrusive_Mpsc_Queue&) = delete;
+        Intrusive_Mpsc_Queue& operator=(Intrusive_Mpsc_Queue&&) noexcept = delete;
+        
+    public:
+        Intrusive_Mpsc_Queue() noexcept = default;
+        void Push(T& value) noexcept; // Любой поток
+        T& Front(); // Только читатель
+        const T& Front() const;
+        void Pop(); // Только читатель
+        bool Empty() const noexcept; // Для писателя - приблизительно
+        
+    private:
+        // Переход от hook к объекту (container_of), как в Intrusive_List
+        static T* Owner(const Mpsc_Hook* hook) noexcept
+        {
+            return reinterpret_cast<T*>(reinterpret_cast<char*>(const_cast<Mpsc_Hook*>(hook)) - Offset());
+        }
+        
+        static std::ptrdiff_t Offset() noexcept
+        {
+            alignas(T) static const char storage[sizeof(T)] = {};
+            const T* object = reinterpret_cast<const T*>(storage);
+            return reinterpret_cast<const char*>(&(object->*Hook)) - storage;
+        }
+        
+        void Push_Hook(Mpsc_Hook* hook) noexcept;
+        const Mpsc_Hook* First() const noexcept; // Первый узел с сообщением, nullptr - пусто
+        
+    private:
+        alignas(64) std::atomic<Mpsc_Hook*> _head = &_stub; // Писатели: последний узел
+        alignas(64) Mpsc_Hook* _tail = &_stub; // Читатель: первый узел
+        Mpsc_Hook _stub;
+    };
+
+    template <class T, Mpsc_Hook T::*Hook>
+    void Intrusive_Mpsc_Queue<T, Hook>::Push(T& value) noexcept
+    {
+        Push_Hook(&(value.*Hook));
+    }
+
+    template <class T, Mpsc_Hook T::*Hook>
+    T& Intrusive_Mpsc_Queue<T, Hook>::Front()
+    {
+        const Mpsc_Hook* first = First();
+        if (!first)
+            throw std::logic_error("Queue is empty");
+        
+        return *Owner(first);
+    }
+
+    template <class T, Mpsc_Hook T::*Hook>
+    const T& Intrusive_Mpsc_Queue<T, Hook>::Front() const
+    {
+        const Mpsc_Hook* first = First();
+        if (!first)
+            throw std::logic_error("Queue is empty");
+        
+        return *Owner(first);
+    }
+
+    template <class T, Mpsc_Hook T::*Hook>
+    void Intrusive_Mpsc_Queue<T, Hook>::Pop()
+    {
+        if (_tail == &_stub) // Пропуск фиктивного узла
+        {
+            Mpsc_Hook* next = _stub.next.load(std::memory_order_acquire);
+            if (!next)
+                throw std::logic_error("Queue is empty");
+            
+            _tail = next;
+        }
+        
+        Mpsc_Hook* node = _tail;
+        Mpsc_Hook* next = node->next.load(std::memory_order_acquire);
+        if (!next)
+        {
+            if (_head.load(std::memory_order_acquire) == node) // Последний узел: _stub становится последним вместо него
+                Push_Hook(&_stub);
+            while (!(next = node->next.load(std::memory_order_acquire))) // Писатель уже сделал exchange, но еще не записал next
+                std::this_thread::yield();
+        }
+        
+        _tail = next;
+        node->next.store(nullptr, std::memory_order_relaxed); // Объект можно снова поставить в очередь
+    }
+
+    template <class T, Mpsc_Hook T::*Hook>
+    bool Intrusive_Mpsc_Queue<T, Hook>::Empty() const noexcept
+    {
+        return First() == nullptr;
+    }
+
+    // release: содержимое сообщения видно читателю, который прочитает next с acquire
+    template <class T, Mpsc_Hook T::*Hook>
+    void Intrusive_Mpsc_Queue<T, Hook>::Push_Hook(Mpsc_Hook* hook) noexcept
+    {
+        hook->next.store(nullptr, std::memory_order_relaxed);
+        Mpsc_Hook* previous = _head.exchange(hook, std::memory_order_acq_rel);
+        previous->next.store(hook, std::memory_order_release);
+    }
+
+    template <class T, Mpsc_Hook T::*Hook>
+    const Mpsc_Hook* Intrusive_Mpsc_Queue<T, Hook>::First() const noexcept
+    {
+        if (_tail != &_stub)
+            return _tail;
+        
+        return _stub.next.load(std::memory_order_acquire);
+    }
+
+    /*
+     Очередь MPSC, владеющая элементами: узел с hook создается на каждый Emplace/Push, как у linked_list::Queue, и удаляется в Pop.
+     */
+    template <class T>
+    class Mpsc_Queue
+    {
+        struct Node
+        {
+            template <typename ...Args>
+            Node(Args&& ...args) :
+            value(std::forward<Args>(args)...)
+            {
+                
+            }
+            
+            T value;
+            Mpsc_Hook hook;
+        };
+        
+    public:
+        Mpsc_Queue() = default;
+        ~Mpsc_Queue();
+        template <typename ...Args>
+        void Emplace(Args&& ...args); // Любой поток
+        void Push(const T& value);
+        void Push(T&& value);
+        T& Front(); // Только читатель
+        const T& Front() const;
+        void Pop(); // Только читатель
+        bool Empty() const noexcept;
+        
+    private:
+        Intrusive_Mpsc_Queue<Node, &Node::hook> _queue;
+    };
+
+    // Разрушение без конкурентного доступа: оставшиеся узлы удаляются
+    template <class T>
+    Mpsc_Queue<T>::~Mpsc_Queue()
+    {
+        while (!_queue.Empty())
+        {
+            Node* node = &_queue.Front();
+            _queue.Pop();
+            delete node;
+        }
+    }
+
+    template <class T>
+    template <typename ...Args>
+    void Mpsc_Queue<T>::Emplace(Args&& ...args)
+    {
+        _queue.Push(*new Node(std::forward<Args>(args)...));
+    }
+
+    template <class T>
+    void Mpsc_Queue<T>::Push(const T& value)
+    {
+        Emplace(value);
+    }
+
+    template <class T>
+    void Mpsc_Queue<T>::Push(T&& value)
+    {
+        Emplace(std::move(value));
+    }
+
+    template <class T>
+    T& Mpsc_Queue<T>::Front()
+    {
+        return _queue.Front().value;
+    }
+
+    template <class T>
+    const T& Mpsc_Queue<T>::Front() const
+    {
+        return _queue.Front().value;
+    }
+
+    template <class T>
+    void Mpsc_Queue<T>::Pop()
+    {
+        Node* node = &_queue.Front(); // Бросает исключение, если очередь пуста
+        _queue.Pop();
+        delete node;
+    }
+
+    template <class T>
+    bool Mpsc_Queue<T>::Empty() const noexcept
+    {
+        return _queue.Empty();
+    }
+}
+
+#endif /* Mpsc_Queue_h */
@@ -0,0 +1,169 @@
+#ifndef Multi_Level_Queue_h
+#define Multi_Level_Queue_h
+
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+
+#include "Mpmc_Queue.h"
+
+/*
+ Многоуровневая очередь с приоритетами для нескольких писателей и читателей: на каждый уровень приоритета своя lock-free очередь Mpmc_Queue (FIFO внутри уровня), уровень 0 - самый высокий приоритет.
+ Битовая маска непустых уровней (_levels): уровню level соответствует бит 63 - level, поэтому самый приоритетный непустой уровень - это количество ведущих нулей маски (countl_zero, одна инструкция lzcnt/clz), Try_Pop - O(1) независимо от количества уровней.
+ В отличии от кучи (priority_queue) под mutex: писатели разных уровней не конкурируют вообще, писатели одного уровня - только за _tail его очереди.
+ Бит уровня устанавливает писатель после записи элемента, сбрасывает читатель, увидевший пустую очередь уровня. Читатель после сброса еще раз проверяет очередь, а писатель после записи проверяет бит (seq_cst барьеры по схеме Деккера, как в Blocking_Queue):
+ элемент, записанный одновременно со сбросом бита, увидит хотя бы один из них, и бит будет установлен снова.
+ Старение (aging): при строгом приоритете поток высокоприоритетных задач может бесконечно откладывать низкие уровни (starvation).
+ Если aging > 0, каждый aging-й Try_Pop берет элемент не с самого высокого уровня, а с первого непустого уровня начиная с вращающегося курсора: любой непустой уровень обслуживается не реже, чем раз в aging * Levels операций.
+ */
+template <class T, size_t Levels>
+class Multi_Level_Queue
+{
+    static_assert(Levels >= 1 && Levels <= 64, "Levels must be in [1, 64]");
+    
+    Multi_Level_Queue(const Multi_Level_Queue&) = delete;
+    Multi_Level_Queue(Multi_Level_Queue&&) noexcept = delete;
+    Multi_Level_Queue& operator=(const Multi_Level_Queue&) = delete;
+    Multi_Level_Queue& operator=(Multi_Level_Queue&&) noexcept = delete;
+    
+    static constexpr uint64_t Bit(size_t level) noexcept { return uint64_t(1) << (63 - level); }
+
+public:
+    explicit Multi_Level_Queue(size_t capacity, size_t aging = 0); // capacity - емкость каждого уровня
+    bool Try_Push(size_t level, const T& value); // false - уровень заполнен
+    bool Try_Push(size_t level, T&& value);
+    bool Try_Pop(T& value); // false - все уровни пусты
+    bool Try_Pop(T& value, size_t& level);
+    bool Empty() const noexcept;
+    size_t Size() const noexcept; // Приблизительный: другие потоки могут изменить очередь сразу после чтения
+    size_t Size(size_t level) const;
+    static constexpr size_t Level_Count() noexcept { return Levels; }
+
+private:
+    template <class U>
+    bool Push(size_t level, U&& value);
+    size_t Choose(uint64_t levels) noexcept; // Уровень для Try_Pop среди непустых
+    void Mark_Empty(size_t level) noexcept;
+
+private:
+    std::array<std::unique_ptr<Mpmc_Queue<T>>, Levels> _queues;
+    const size_t _aging = 0;
+    alignas(64) std::atomic<uint64_t> _levels = 0; // Бит 63 - level: уровень непуст
+    alignas(64) std::atomic<size_t> _pops = 0; // Счетчик Try_Pop для старения
+    std::atomic<size_t> _cursor = 0; // Следующий уровень, обслуживаемый по старению
+};
+
+template <class T, size_t Levels>
+Multi_Level_Queue<T, Levels>::Multi_Level_Queue(size_t capacity, size_t aging) : _aging(aging)
+{
+    for (auto& queue : _queues)
+        queue = std::make_unique<Mpmc_Queue<T>>(capacity);
+}
+
+template <class T, size_t Levels>
+bool Multi_Level_Queue<T, Levels>::Try_Push(size_t level, const T& value)
+{
+    return Push(level, value);
+}
+
+template <class T, size_t Levels>
+bool Multi_Level_Queue<T, Levels>::Try_Push(size_t level, T&& value)
+{
+    return Push(level, std::move(value));
+}
+
+template <class T, size_t Levels>
+bool Multi_Level_Queue<T, Levels>::Try_Pop(T& value)
+{
+    size_t level = 0;
+    return Try_Pop(value, level);
+}
+
+template <class T, size_t Levels>
+bool Multi_Level_Queue<T, Levels>::Try_Pop(T& value, size_t& level)
+{
+    // Каждый уровень, непустой на момент входа, проверяется один раз: ячейка, занятая, но еще не записанная писателем, не дает Try_Pop ни взять элемент, ни сбросить бит, и повторная проверка того же уровня ждала бы писателя
+    uint64_t levels = _levels.load(std::memory_order_acquire);
+    while (levels != 0)
+    {
+        level = Choose(levels);
+        if (_queues[level]->Try_Pop(value))
+            return true;
+        
+        if (_queues[level]->Empty())
+            Mark_Empty(level);
+        levels &= ~Bit(level); // Уровень занят другими читателями или пуст: следующий
+    }
+    
+    return false;
+}
+
+template <class T, size_t Levels>
+bool Multi_Level_Queue<T, Levels>::Empty() const noexcept
+{
+    return Size() == 0;
+}
+
+template <class T, size_t Levels>
+size_t Multi_Level_Queue<T, Levels>::Size() const noexcept
+{
+    size_t size = 0;
+    for (const auto& queue : _queues)
+        size += queue->Size();
+    
+    return size;
+}
+
+template <class T, size_t Levels>
+size_t Multi_Level_Queue<T, Levels>::Size(size_t level) const
+{
+    if (level >= Levels)
+        throw std::out_of_range("Level is out of range!");
+    
+    return _queues[level]->Size();
+}
+
+template <class T, size_t Levels>
+template <class U>
+bool Multi_Level_Queue<T, Levels>::Push(size_t level, U&& value)
+{
+    if (level >= Levels)
+        throw std::out_of_range("Level is out of range!");
+    
+    if (!_queues[level]->Try_Push(std::forward<U>(value)))
+        return false;
+    
+    std::atomic_thread_fence(std::memory_order_seq_cst); // Парный барьеру в Mark_Empty
+    if (!(_levels.load(std::memory_order_relaxed) & Bit(level))) // Бит уже установлен - без записи в общую кэш-линию
+        _levels.fetch_or(Bit(level), std::memory_order_release);
+    return true;
+}
+
+template <class T, size_t Levels>
+size_t Multi_Level_Queue<T, Levels>::Choose(uint64_t levels) noexcept
+{
+    if (_aging > 0 && _pops.fetch_add(1, std::memory_order_relaxed) % _aging == _aging - 1)
+    {
+        const size_t cursor = _cursor.fetch_add(1, std::memory_order_relaxed) % Levels;
+        if (const uint64_t below = levels & (~uint64_t(0) >> cursor)) // Непустые уровни от cursor и ниже по приоритету
+            return std::countl_zero(below);
+    }
+    
+    return std::countl_zero(levels);
+}
+
+template <class T, size_t Levels>
+void Multi_Level_Queue<T, Levels>::Mark_Empty(size_t level) noexcept
+{
+    _levels.fetch_and(~Bit(level), std::memory_order_seq_cst);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (!_queues[level]->Empty()) // Писатель записал элемент до сброса, но увидел еще установленный бит
+        _levels.fetch_or(Bit(level), std::memory_order_release);
+}
+
+#endif /* Multi_Level_Queue_h */
@@ -0,0 +1,169 @@
+#ifndef Spsc_Queue_h
+#define Spsc_Queue_h
+
+#include <atomic>
+#include <cstddef>
+#include <new>
+#include <utility>
+
+/*
+ Ограниченная lock-free очередь для одного писателя и одного читателя (SPSC - single producer single consumer): кольцевой буфер Лэмпорта на N элементов без выделения памяти после создания.
+ - _tail изменяет только писатель, _head - только читатель, поэтому вместо CAS достаточно обычных load/store с acquire/release.
+ - индексы растут бесконечно, позиция в буфере - index & (N - 1), поэтому N - степень двойки, а полная очередь (tail - head == N) отличается от пустой (tail == head).
+ - каждая сторона хранит кэшированную копию чужого индекса (_head_cache у писателя, _tail_cache у читателя) и перечитывает настоящий индекс, только когда по копии не хватает места/элементов.
+ Без кэша каждая операция читала бы кэш-линию, которую постоянно изменяет другой поток (промах кэша на каждый элемент), с кэшем - один раз на заполнение/опустошение.
+ Данные писателя, данные читателя и буфер лежат на разных кэш-линиях (false sharing).
+ Try_Push_Batch/Try_Pop_Batch - пакетные операции: одна публикация индекса на весь пакет.
+ */
+template <class T, size_t N>
+class Spsc_Queue
+{
+    static_assert(N >= 2 && (N & (N - 1)) == 0, "N must be a power of two");
+    
+    Spsc_Queue(const Spsc_Queue&) = delete;
+    Spsc_Queue(Spsc_Queue&&) noexcept = delete;
+    Spsc_Queue& operator=(const Spsc_Queue&) = delete;
+    Spsc_Queue& operator=(Spsc_Queue&&) noexcept = delete;
+
+public:
+    Spsc_Queue() = default;
+    ~Spsc_Queue();
+    template <typename ...Args>
+    bool Try_Emplace(Args&& ...args); // false - очередь полна
+    bool Try_Push(const T& value);
+    bool Try_Push(T&& value);
+    bool Try_Pop(T& value); // false - очередь пуста
+    size_t Try_Push_Batch(T* values, size_t count); // Перемещает из values сколько поместится, возвращает количество
+    size_t Try_Pop_Batch(T* values, size_t count); // Перемещает в values до count элементов, возвращает количество
+    bool Empty() const noexcept;
+    size_t Size() const noexcept; // Приблизительный, если вызывается не писателем и не читателем
+    static constexpr size_t Capacity() noexcept { return N; }
+
+private:
+    T* Slot(size_t index) noexcept { return std::launder(reinterpret_cast<T*>(_buffer + (index & (N - 1)) * sizeof(T))); }
+    size_t Free_Slots(size_t tail, size_t wanted) noexcept; // Для писателя
+    size_t Ready_Slots(size_t head, size_t wanted) noexcept; // Для читателя
+
+private:
+    // Писатель
+    alignas(64) std::atomic<size_t> _tail = 0;
+    size_t _head_cache = 0;
+    // Читатель
+    alignas(64) std::atomic<size_t> _head = 0;
+    size_t _tail_cache = 0;
+    
+    alignas(64) alignas(T) unsigned char _buffer[N * sizeof(T)];
+};
+
+// Разрушение без конкурентного доступа: разрушаются оставшиеся элементы
+template <class T, size_t N>
+Spsc_Queue<T, N>::~Spsc_Queue()
+{
+    const size_t tail = _tail.load(std::memory_order_acquire);
+    for (size_t head = _head.load(std::memory_order_relaxed); head != tail; ++head)
+        Slot(head)->~T();
+}
+
+template <class T, size_t N>
+template <typename ...Args>
+bool Spsc_Queue<T, N>::Try_Emplace(Args&& ...args)
+{
+    const size_t tail = _tail.load(std::memory_order_relaxed);
+    if (Free_Slots(tail, 1) == 0)
+        return false;
+    
+    new (Slot(tail)) T(std::forward<Args>(args)...);
+    _tail.store(tail + 1, std::memory_order_release); // Элемент виден читателю только после записи
+    return true;
+}
+
+template <class T, size_t N>
+bool Spsc_Queue<T, N>::Try_Push(const T& value)
+{
+    return Try_Emplace(value);
+}
+
+template <class T, size_t N>
+bool Spsc_Queue<T, N>::Try_Push(T&& value)
+{
+    return Try_Emplace(std::move(value));
+}
+
+template <class T, size_t N>
+bool Spsc_Queue<T, N>::Try_Pop(T& value)
+{
+    const size_t head = _head.load(std::memory_order_relaxed);
+    if (Ready_Slots(head, 1) == 0)
+        return false;
+    
+    T* slot = Slot(head);
+    value = std::move(*slot);
+    slot->~T();
+    _head.store(head + 1, std::memory_order_release); // Ячейка свободна для писателя только после разрушения элемента
+    return true;
+}
+
+template <class T, size_t N>
+size_t Spsc_Queue<T, N>::Try_Push_Batch(T* values, size_t count)
+{
+    const size_t tail = _tail.load(std::memory_order_relaxed);
+    const size_t free = Free_Slots(tail, count);
+    if (count > free)
+        count = free;
+    
+    for (size_t i = 0; i < count; ++i)
+        new (Slot(tail + i)) T(std::move(values[i]));
+    _tail.store(tail + count, std::memory_order_release);
+    return count;
+}
+
+template <class T, size_t N>
+size_t Spsc_Queue<T, N>::Try_Pop_Batch(T* values, size_t count)
+{
+    const size_t head = _head.load(std::memory_order_relaxed);
+    const size_t ready = Ready_Slots(head, count);
+    if (count > ready)
+        count = ready;
+    
+    for (size_t i = 0; i < count; ++i)
+    {
+        T* slot = Slot(head + i);
+        values[i] = std::move(*slot);
+        slot->~T();
+    }
+    _head.store(head + count, std::memory_order_release);
+    return count;
+}
+
+template <class T, size_t N>
+bool Spsc_Queue<T, N>::Empty() const noexcept
+{
+    return Size() == 0;
+}
+
+template <class T, size_t N>
+size_t Spsc_Queue<T, N>::Size() const noexcept
+{
+    const size_t head = _head.load(std::memory_order_acquire);
+    const size_t tail = _tail.load(std::memory_order_acquire);
+    return tail > head ? tail - head : 0; // Индексы читаются не одновременно
+}
+
+// Чужой индекс перечитывается, только когда по кэшированной копии не хватает места/элементов
+template <class T, size_t N>
+size_t Spsc_Queue<T, N>::Free_Slots(size_t tail, size_t wanted) noexcept
+{
+    if (N - (tail - _head_cache) < wanted)
+        _head_cache = _head.load(std::memory_order_acquire);
+    return N - (tail - _head_cache);
+}
+
+template <class T, size_t N>
+size_t Spsc_Queue<T, N>::Ready_Slots(size_t head, size_t wanted) noexcept
+{
+    if (_tail_cache - head < wanted)
+        _tail_cache = _tail.load(std::memory_order_acquire);
+    return _tail_cache - head;
+}
+
+#endif /* Spsc_Queue_h */
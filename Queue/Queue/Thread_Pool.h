@@ -0,0 +1,332 @@
+#ifndef Thread_Pool_h
+#define Thread_Pool_h
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <future>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "function.h"
+#include "Work_Stealing_Deque.h"
+
+/*
+ Пул потоков с кражей задач (work stealing): у каждого рабочего потока свой Work_Stealing_Deque задач.
+ - задача, созданная в рабочем потоке, кладется в его собственный дек (без общей блокировки), рабочий поток берет задачи из своего дека в порядке LIFO.
+ - поток без задач крадет самую старую задачу у случайно выбранного потока (random victim), затем по кругу у остальных.
+ - задачи из внешних потоков (не из пула) попадают в общую FIFO очередь под mutex, откуда их забирают рабочие потоки.
+ Задача хранит first_implementation::function<void()> с small buffer optimization: lambda с несколькими захваченными ссылками не выделяет память.
+ Submit(function) - задача с результатом в std::future.
+ Invoke(left, right) - fork-join: right кладется в дек, left выполняется сразу, затем right забирается обратно (если его не украли) или поток помогает выполнять другие задачи, пока вор не закончит right.
+ Задачи Invoke живут на стеке вызывающего потока: fork-join не выделяет память, а ожидание не блокирует рабочий поток (иначе рекурсивное деление задач исчерпало бы потоки пула).
+ Parallel_For - рекурсивное деление диапазона пополам через Invoke до grain элементов.
+ Поток без задач недолго ищет работу, затем засыпает на C++20 atomic::wait (как Blocking_Queue): спящих будит только появление новой задачи.
+ */
+class Thread_Pool
+{
+    Thread_Pool(const Thread_Pool&) = delete;
+    Thread_Pool(Thread_Pool&&) noexcept = delete;
+    Thread_Pool& operator=(const Thread_Pool&) = delete;
+    Thread_Pool& operator=(Thread_Pool&&) noexcept = delete;
+    
+    using Function = first_implementation::function<void()>;
+    
+    struct Task
+    {
+        Function work;
+        std::atomic<bool> done = false; // Для задач Invoke: выполнена
+        bool owned = false; // Создана new в Submit: удаляется после выполнения
+    };
+    
+    struct alignas(64) Worker
+    {
+        Work_Stealing_Deque<Task*> tasks;
+        uint64_t seed = 0; // Выбор случайной жертвы для кражи (xorshift)
+    };
+    
+    static constexpr int spin_count = 64; // Попыток найти задачу перед сном
+
+public:
+    explicit Thread_Pool(size_t threads = std::max(std::thread::hardware_concurrency(), 1u));
+    ~Thread_Pool(); // Выполняет оставшиеся задачи и дожидается потоков
+    template <class TFunction>
+    auto Submit(TFunction&& function) -> std::future<std::invoke_result_t<std::decay_t<TFunction>>>;
+    template <class Left, class Right>
+    void Invoke(Left&& left, Right&& right);
+    template <class Iterator, class TFunction>
+    void Parallel_For(Iterator first, Iterator last, TFunction function, size_t grain = 0); // function(element), grain = 0 - подбирается по количеству потоков
+    size_t Size() const noexcept { return _workers.size(); }
+
+private:
+    Worker* Current() const noexcept; // Worker текущего потока, nullptr - поток не из этого пула
+    void Schedule(Task* task);
+    bool Find(Worker& worker, Task*& task);
+    void Execute(Task* task);
+    void Wait(Worker& worker, const Task& task); // Выполнение других задач, пока task не выполнена
+    void Run(size_t index);
+    void Wake() noexcept;
+    template <class Iterator, class TFunction>
+    void For(Iterator first, Iterator last, TFunction& function, size_t grain);
+
+private:
+    std::vector<std::unique_ptr<Worker>> _workers;
+    std::vector<std::thread> _threads;
+    std::mutex _mutex;
+    std::deque<Task*> _injected; // Задачи из внешних потоков в порядке поступления (FIFO), под _mutex
+    std::atomic<size_t> _injected_count = 0; // Проверка общей очереди без блокировки
+    alignas(64) std::atomic<uint32_t> _epoch = 0; // На нем спят потоки без задач
+    std::atomic<uint32_t> _sleeping = 0;
+    std::atomic<bool> _stop = false;
+    
+    inline static thread_local const Thread_Pool* _current_pool = nullptr;
+    inline static thread_local Worker* _current_worker = nullptr;
+};
+
+inline Thread_Pool::Thread_Pool(size_t threads)
+{
+    threads = std::max<size_t>(threads, 1);
+    for (size_t i = 0; i < threads; ++i)
+    {
+        _workers.push_back(std::make_unique<Worker>());
+        _workers.back()->seed = 0x9E3779B97F4A7C15ull * (i + 1);
+    }
+    
+    for (size_t i = 0; i < threads; ++i)
+        _threads.emplace_back(&Thread_Pool::Run, this, i);
+}
+
+inline Thread_Pool::~Thread_Pool()
+{
+    _stop.store(true, std::memory_order_seq_cst);
+    _epoch.fetch_add(1, std::memory_order_seq_cst);
+    _epoch.notify_all();
+    for (auto& thread : _threads)
+        thread.join();
+}
+
+template <class TFunction>
+auto Thread_Pool::Submit(TFunction&& function) -> std::future<std::invoke_result_t<std::decay_t<TFunction>>>
+{
+    using Result = std::invoke_result_t<std::decay_t<TFunction>>;
+    
+    // packaged_task только перемещается, а function копирует функтор, поэтому задача хранит shared_ptr на нее
+    auto task = std::make_shared<std::packaged_task<Result()>>(std::forward<TFunction>(function));
+    std::future<Result> future = task->get_future();
+    Schedule(new Task{Function([task]() { (*task)(); }), false, true});
+    return future;
+}
+
+template <class Left, class Right>
+void Thread_Pool::Invoke(Left&& left, Right&& right)
+{
+    Worker* worker = Current();
+    if (!worker) // Внешний поток: весь fork-join выполняется в пуле
+    {
+        Submit([&]() { Invoke(left, right); }).get();
+        return;
+    }
+    
+    std::exception_ptr error;
+    Task task{Function([&right, &error]()
+    {
+        try
+        {
+            right();
+        }
+        catch (...)
+        {
+            error = std::current_exception();
+        }
+    })};
+    worker->tasks.Push(&task);
+    Wake();
+    
+    try
+    {
+        left();
+    }
+    catch (...)
+    {
+        Wait(*worker, task); // task ссылается на стек этой функции: ждать ее нужно и при исключении
+        throw;
+    }
+    
+    Wait(*worker, task);
+    if (error)
+        std::rethrow_exception(error);
+}
+
+template <class Iterator, class TFunction>
+void Thread_Pool::Parallel_For(Iterator first, Iterator last, TFunction function, size_t grain)
+{
+    const size_t count = std::distance(first, last);
+    if (count == 0)
+        return;
+    
+    if (grain == 0) // По 8 частей на поток: воры успевают выровнять неравномерную работу
+        grain = std::max<size_t>(count / (_workers.size() * 8), 1);
+    
+    if (Current())
+    {
+        For(first, last, function, grain);
+        return;
+    }
+    
+    Submit([&]() { For(first, last, function, grain); }).get();
+}
+
+template <class Iterator, class TFunction>
+void Thread_Pool::For(Iterator first, Iterator last, TFunction& function, size_t grain)
+{
+    const size_t count = std::distance(first, last);
+    if (count <= grain)
+    {
+        for (; first != last; ++first)
+            function(*first);
+        return;
+    }
+    
+    Iterator middle = std::next(first, count / 2);
+    Invoke([&]() { For(first, middle, function, grain); }, [&]() { For(middle, last, function, grain); });
+}
+
+inline Thread_Pool::Worker* Thread_Pool::Current() const noexcept
+{
+    return _current_pool == this ? _current_worker : nullptr;
+}
+
+inline void Thread_Pool::Schedule(Task* task)
+{
+    if (Worker* worker = Current())
+    {
+        worker->tasks.Push(task);
+    }
+    else
+    {
+        std::lock_guard lock(_mutex);
+        _injected.push_back(task);
+        _injected_count.fetch_add(1, std::memory_order_relaxed);
+    }
+    Wake();
+}
+
+// Поиск задачи: свой дек, общая очередь, кража у случайного потока и затем у остальных по кругу
+inline bool Thread_Pool::Find(Worker& worker, Task*& task)
+{
+    if (worker.tasks.Try_Pop(task))
+        return true;
+    
+    if (_injected_count.load(std::memory_order_relaxed) > 0)
+    {
+        std::lock_guard lock(_mutex);
+        if (!_injected.empty())
+        {
+            task = _injected.front(); // Самая старая: при постоянном потоке Submit ранние задачи не откладываются бесконечно
+            _injected.pop_front();
+            _injected_count.fetch_sub(1, std::memory_order_relaxed);
+            return true;
+        }
+    }
+    
+    const size_t count = _workers.size();
+    worker.seed ^= worker.seed << 13;
+    worker.seed ^= worker.seed >> 7;
+    worker.seed ^= worker.seed << 17;
+    const size_t victim = worker.seed % count;
+    for (size_t i = 0; i < count; ++i)
+    {
+        Worker& other = *_workers[(victim + i) % count];
+        if (&other != &worker && other.tasks.Try_Steal(task))
+            return true;
+    }
+    
+    return false;
+}
+
+inline void Thread_Pool::Execute(Task* task)
+{
+    task->work();
+    if (task->owned)
+        delete task;
+    else
+        task->done.store(true, std::memory_order_release); // После этого task может быть разрушена владельцем
+}
+
+inline void Thread_Pool::Wait(Worker& worker, const Task& task)
+{
+    Task* other = nullptr;
+    while (!task.done.load(std::memory_order_acquire))
+    {
+        if (Find(worker, other))
+        {
+            if (other == &task) // Не украли: выполняется здесь же
+            {
+                other->work();
+                return;
+            }
+            Execute(other);
+        }
+        else
+        {
+            std::this_thread::yield(); // Задачу выполняет вор, новых задач нет
+        }
+    }
+}
+
+inline void Thread_Pool::Run(size_t index)
+{
+    Worker& worker = *_workers[index];
+    _current_pool = this;
+    _current_worker = &worker;
+    
+    Task* task = nullptr;
+    while (true)
+    {
+        bool found = false;
+        for (int i = 0; i < spin_count && !found; ++i)
+            found = Find(worker, task);
+        
+        if (!found)
+        {
+            // Потерянное пробуждение исключено барьерами по схеме Деккера, как в Blocking_Queue: Schedule (задача, барьер, чтение _sleeping) и поток (_sleeping + 1, барьер, поиск задачи)
+            _sleeping.fetch_add(1, std::memory_order_seq_cst);
+            const uint32_t epoch = _epoch.load(std::memory_order_acquire);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            found = Find(worker, task);
+            if (!found && !_stop.load(std::memory_order_acquire))
+                _epoch.wait(epoch, std::memory_order_acquire);
+            _sleeping.fetch_sub(1, std::memory_order_seq_cst);
+        }
+        
+        if (!found && _stop.load(std::memory_order_acquire))
+        {
+            found = Find(worker, task); // Задачи, поставленные до остановки, видны только после чтения _stop
+            if (!found)
+                break;
+        }
+        
+        if (found)
+            Execute(task);
+    }
+}
+
+inline void Thread_Pool::Wake() noexcept
+{
+    std::atomic_thread_fence(std::memory_order_seq_cst); // Задача видна до чтения _sleeping
+    if (_sleeping.load(std::memory_order_relaxed) == 0)
+        return;
+    
+    _epoch.fetch_add(1, std::memory_order_release);
+    _epoch.notify_one();
+}
+
+#endif /* Thread_Pool_h */
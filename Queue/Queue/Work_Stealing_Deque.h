@@ -0,0 +1,160 @@
+#ifndef Work_Stealing_Deque_h
+#define Work_Stealing_Deque_h
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+/*
+ Дек для планировщика с кражей задач (work stealing) по схеме Chase-Lev (модель памяти C++11 - Lê, Pop, Cohen, Zappa Nardelli, 2013).
+ Один владелец работает с низом дека (_bottom) как со стеком: Push/Try_Pop без CAS (только в гонке за последний элемент).
+ Остальные потоки (воры) забирают элементы сверху (_top) через Try_Steal: CAS _top -> _top + 1, поэтому воры конкурируют между собой и с владельцем только за один элемент.
+ Владелец берет последнюю добавленную задачу (LIFO - ее данные еще в кэше), вор - самую старую (FIFO - обычно самую большую часть работы при рекурсивном делении).
+ Буфер кольцевой, индексы растут бесконечно. Когда буфер заполнен, владелец копирует элементы в буфер в 2 раза больше, а старый буфер не освобождается до разрушения дека: вор мог успеть прочитать указатель на него.
+ T должен быть trivially copyable (обычно указатель на задачу): вор читает ячейку до CAS, и если CAS не прошел, прочитанное значение просто отбрасывается.
+ */
+template <class T>
+class Work_Stealing_Deque
+{
+    static_assert(std::is_trivially_copyable_v<T>, "T must be trivially copyable");
+    
+    Work_Stealing_Deque(const Work_Stealing_Deque&) = delete;
+    Work_Stealing_Deque(Work_Stealing_Deque&&) noexcept = delete;
+    Work_Stealing_Deque& operator=(const Work_Stealing_Deque&) = delete;
+    Work_Stealing_Deque& operator=(Work_Stealing_Deque&&) noexcept = delete;
+    
+    struct Buffer
+    {
+        explicit Buffer(int64_t capacity) : mask(capacity - 1), cells(new std::atomic<T>[capacity]) {}
+        
+        T Get(int64_t index) const noexcept { return cells[index & mask].load(std::memory_order_relaxed); }
+        void Put(int64_t index, T value) noexcept { cells[index & mask].store(value, std::memory_order_relaxed); }
+        int64_t Capacity() const noexcept { return mask + 1; }
+        
+        const int64_t mask;
+        const std::unique_ptr<std::atomic<T>[]> cells;
+    };
+
+public:
+    explicit Work_Stealing_Deque(size_t capacity = 256);
+    void Push(T value); // Только владелец
+    bool Try_Pop(T& value); // Только владелец, false - дек пуст
+    bool Try_Steal(T& value); // Любой поток, false - дек пуст или элемент забрал другой поток
+    bool Empty() const noexcept;
+    size_t Size() const noexcept; // Приблизительный: другие потоки могут изменить дек сразу после чтения
+
+private:
+    Buffer* Grow(Buffer* buffer, int64_t top, int64_t bottom);
+
+private:
+    alignas(64) std::atomic<int64_t> _top = 0; // Воры
+    alignas(64) std::atomic<int64_t> _bottom = 0; // Владелец
+    std::atomic<Buffer*> _buffer = nullptr;
+    std::vector<std::unique_ptr<Buffer>> _buffers; // Все буферы, включая старые: освобождаются в деструкторе
+};
+
+template <class T>
+Work_Stealing_Deque<T>::Work_Stealing_Deque(size_t capacity)
+{
+    int64_t size = 2;
+    while (size < static_cast<int64_t>(capacity))
+        size <<= 1;
+    
+    _buffers.push_back(std::make_unique<Buffer>(size));
+    _buffer.store(_buffers.back().get(), std::memory_order_relaxed);
+}
+
+template <class T>
+void Work_Stealing_Deque<T>::Push(T value)
+{
+    const int64_t bottom = _bottom.load(std::memory_order_relaxed);
+    const int64_t top = _top.load(std::memory_order_acquire);
+    Buffer* buffer = _buffer.load(std::memory_order_relaxed);
+    if (bottom - top > buffer->Capacity() - 1) // Буфер заполнен
+        buffer = Grow(buffer, top, bottom);
+    
+    buffer->Put(bottom, value);
+    std::atomic_thread_fence(std::memory_order_release); // Элемент виден вору до нового _bottom
+    _bottom.store(bottom + 1, std::memory_order_relaxed);
+}
+
+/*
+ Владелец сначала уменьшает _bottom (резервирует последний элемент), затем читает _top: seq_cst барьер гарантирует, что вор, который прочитает _top раньше, увидит новый _bottom.
+ Если остался один элемент (top == bottom), его может забирать и вор: гонка решается тем же CAS по _top, что у вора.
+ */
+template <class T>
+bool Work_Stealing_Deque<T>::Try_Pop(T& value)
+{
+    const int64_t bottom = _bottom.load(std::memory_order_relaxed) - 1;
+    Buffer* buffer = _buffer.load(std::memory_order_relaxed);
+    _bottom.store(bottom, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    int64_t top = _top.load(std::memory_order_relaxed);
+    
+    if (top > bottom) // Пусто
+    {
+        _bottom.store(bottom + 1, std::memory_order_relaxed);
+        return false;
+    }
+    
+    value = buffer->Get(bottom);
+    if (top == bottom) // Последний элемент
+    {
+        const bool won = _top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+        _bottom.store(bottom + 1, std::memory_order_relaxed);
+        return won;
+    }
+    
+    return true;
+}
+
+template <class T>
+bool Work_Stealing_Deque<T>::Try_Steal(T& value)
+{
+    int64_t top = _top.load(std::memory_order_acquire);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    const int64_t bottom = _bottom.load(std::memory_order_acquire);
+    if (top >= bottom)
+        return false;
+    
+    // Чтение до CAS: если владелец в этот момент переехал в новый буфер, старый буфер еще жив и содержит тот же элемент
+    const T stolen = _buffer.load(std::memory_order_acquire)->Get(top);
+    if (!_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+        return false;
+    
+    value = stolen;
+    return true;
+}
+
+template <class T>
+bool Work_Stealing_Deque<T>::Empty() const noexcept
+{
+    return Size() == 0;
+}
+
+template <class T>
+size_t Work_Stealing_Deque<T>::Size() const noexcept
+{
+    const int64_t top = _top.load(std::memory_order_acquire);
+    const int64_t bottom = _bottom.load(std::memory_order_acquire);
+    return bottom > top ? static_cast<size_t>(bottom - top) : 0;
+}
+
+// Рост буфера в 2 раза: копируются элементы [top, bottom), индексы не меняются
+template <class T>
+Work_Stealing_Deque<T>::Buffer* Work_Stealing_Deque<T>::Grow(Buffer* buffer, int64_t top, int64_t bottom)
+{
+    auto bigger = std::make_unique<Buffer>(buffer->Capacity() * 2);
+    for (int64_t i = top; i < bottom; ++i)
+        bigger->Put(i, buffer->Get(i));
+    
+    Buffer* result = bigger.get();
+    _buffers.push_back(std::move(bigger));
+    _buffer.store(result, std::memory_order_release);
+    return result;
+}
+
+#endif /* Work_Stealing_Deque_h */
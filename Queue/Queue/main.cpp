@@ -1,8 +1,54 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdlib>
 #include <iostream>
+#include <memory>
+#include <mutex>
+#include <numeric>
+#include <queue>
 #include <string>
+#include <thread>
+#include <vector>
 
 #include "LinkedList.h"
 #include "Deque.h"
+#include "Blocking_Queue.h"
+#include "Chunked_Deque.h"
+#include "Mpmc_Queue.h"
+#include "Mpsc_Queue.h"
+#include "Multi_Level_Queue.h"
+#include "Spsc_Queue.h"
+#include "Thread_Pool.h"
+#include "Timer.h"
+
+static std::atomic<size_t> allocations = 0; // Счетчик вызовов operator new для бенчмарка
+
+// noinline: иначе GCC встраивает free в место вызова delete и ошибочно сообщает о несоответствии с operator new (-Wmismatched-new-delete)
+#if defined(_MSC_VER)
+#define NOINLINE __declspec(noinline)
+#else
+#define NOINLINE __attribute__((noinline))
+#endif
+
+NOINLINE void* operator new(size_t size)
+{
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* ptr = std::malloc(size))
+        return ptr;
+    throw std::bad_alloc();
+}
+
+NOINLINE void operator delete(void* ptr) noexcept
+{
+    std::free(ptr);
+}
+
+NOINLINE void operator delete(void* ptr, size_t) noexcept
+{
+    std::free(ptr);
+}
 
 
 class Example
@@ -80,6 +126,568 @@ void Test2()
     }
 }
 
+// Однопоточная очередь под mutex с интерфейсом Try_Push/Try_Pop
+template <class TQueue>
+class Mutex_Queue
+{
+public:
+    bool Try_Push(int value)
+    {
+        std::lock_guard lock(_mutex);
+        _queue.Push(value);
+        return true;
+    }
+    
+    bool Try_Pop(int& value)
+    {
+        std::lock_guard lock(_mutex);
+        if (_queue.Empty())
+            return false;
+        
+        value = _queue.Front();
+        _queue.Pop();
+        return true;
+    }
+    
+private:
+    std::mutex _mutex;
+    TQueue _queue;
+};
+
+// Пропускная способность: producers потоков отправляют messages чисел, consumers потоков их забирают. Batch - пакетами по batch_size через Try_Push_Batch/Try_Pop_Batch
+template <bool Batch = false, class TQueue>
+void Throughput(const char* name, TQueue& queue, size_t producers, size_t consumers, size_t messages)
+{
+    static constexpr size_t batch_size = 64;
+    std::atomic<size_t> received = 0;
+    std::atomic<long long> sum = 0;
+    
+    Timer timer;
+    timer.start();
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < producers; ++i)
+    {
+        threads.emplace_back([&queue, count = messages / producers]()
+        {
+            if constexpr (Batch)
+            {
+                int values[batch_size];
+                for (size_t sent = 0; sent < count;)
+                {
+                    const size_t size = std::min(batch_size, count - sent);
+                    for (size_t j = 0; j < size; ++j)
+                        values[j] = static_cast<int>(sent + j + 1);
+                    
+                    size_t pushed = 0;
+                    while ((pushed += queue.Try_Push_Batch(values + pushed, size - pushed)) < size)
+                        std::this_thread::yield(); // Очередь полна
+                    sent += size;
+                }
+            }
+            else
+            {
+                for (size_t j = 1; j <= count; ++j)
+                {
+                    while (!queue.Try_Push(static_cast<int>(j)))
+                        std::this_thread::yield();
+                }
+            }
+        });
+    }
+    for (size_t i = 0; i < consumers; ++i)
+    {
+        threads.emplace_back([&queue, &received, &sum, total = messages / producers * producers]()
+        {
+            long long local_sum = 0;
+            int values[batch_size];
+            while (received.load(std::memory_order_relaxed) < total)
+            {
+                size_t popped = 0;
+                if constexpr (Batch)
+                    popped = queue.Try_Pop_Batch(values, batch_size);
+                else
+                    popped = queue.Try_Pop(values[0]) ? 1 : 0;
+                
+                if (popped == 0)
+                {
+                    std::this_thread::yield(); // Очередь пуста
+                    continue;
+                }
+                
+                for (size_t j = 0; j < popped; ++j)
+                    local_sum += values[j];
+                received.fetch_add(popped, std::memory_order_relaxed);
+            }
+            sum.fetch_add(local_sum);
+        });
+    }
+    for (auto& thread : threads)
+        thread.join();
+    timer.stop();
+    
+    const long long count = static_cast<long long>(messages / producers);
+    const long long expected = static_cast<long long>(producers) * count * (count + 1) / 2;
+    std::cout << name << ": " << timer.elapsedMilliseconds() << " ms, "
+              << static_cast<size_t>(received.load() / timer.elapsedMilliseconds() / 1000) << " M msg/s, sum ok: " << (sum.load() == expected) << std::endl;
+}
+
+// Задержка: поток отправляет число в request, второй поток возвращает его через response, время круга туда-обратно
+template <class TQueue>
+void Latency(const char* name, TQueue& request, TQueue& response, size_t round_trips)
+{
+    std::thread echo([&request, &response, round_trips]()
+    {
+        int value = 0;
+        for (size_t i = 0; i < round_trips; ++i)
+        {
+            while (!request.Try_Pop(value))
+                std::this_thread::yield();
+            while (!response.Try_Push(value))
+                std::this_thread::yield();
+        }
+    });
+    
+    Timer timer;
+    timer.start();
+    int value = 0;
+    for (size_t i = 0; i < round_trips; ++i)
+    {
+        while (!request.Try_Push(static_cast<int>(i)))
+            std::this_thread::yield();
+        while (!response.Try_Pop(value))
+            std::this_thread::yield();
+    }
+    timer.stop();
+    echo.join();
+    
+    std::cout << name << " round trip: " << timer.elapsedMilliseconds() * 1'000'000 / round_trips << " ns" << std::endl;
+}
+
+// Блокирующая очередь на mutex + condition_variable с интерфейсом Blocking_Queue
+template <class T>
+class Cv_Queue
+{
+public:
+    void Push(const T& value)
+    {
+        {
+            std::lock_guard lock(_mutex);
+            _queue.Push(value);
+        }
+        _cv.notify_one();
+    }
+    
+    bool Pop(T& value)
+    {
+        std::unique_lock lock(_mutex);
+        _cv.wait(lock, [this]() { return !_queue.Empty() || _closed; });
+        if (_queue.Empty())
+            return false;
+        
+        value = _queue.Front();
+        _queue.Pop();
+        return true;
+    }
+    
+    void Close()
+    {
+        {
+            std::lock_guard lock(_mutex);
+            _closed = true;
+        }
+        _cv.notify_all();
+    }
+    
+private:
+    std::mutex _mutex;
+    std::condition_variable _cv;
+    DEQUE::Queue<T> _queue;
+    bool _closed = false;
+};
+
+// Задержка пробуждения: читатель спит на пустой очереди, писатель раз в 100 мкс отправляет время отправки, читатель считает, через сколько он его получил
+template <class TQueue>
+void Wakeup_Latency(const char* name, TQueue& queue, size_t samples)
+{
+    using Clock = std::chrono::steady_clock;
+    std::vector<long long> latencies;
+    latencies.reserve(samples);
+    std::thread consumer([&queue, &latencies]()
+    {
+        long long sent = 0;
+        while (queue.Pop(sent))
+            latencies.push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now().time_since_epoch()).count() - sent);
+    });
+    
+    for (size_t i = 0; i < samples; ++i)
+    {
+        std::this_thread::sleep_for(std::chrono::microseconds(100));
+        queue.Push(std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now().time_since_epoch()).count());
+    }
+    queue.Close();
+    consumer.join();
+    
+    std::sort(latencies.begin(), latencies.end());
+    auto Percentile = [&latencies](double percent) { return latencies[static_cast<size_t>(percent / 100 * (latencies.size() - 1))] / 1000.0; };
+    std::cout << name << " wakeup latency, us: p50 " << Percentile(50) << ", p90 " << Percentile(90) << ", p99 " << Percentile(99)
+              << ", p99.9 " << Percentile(99.9) << ", max " << Percentile(100) << std::endl;
+}
+
+// Пропускная способность блокирующих очередей: читатели спят, когда очередь пуста, и завершаются после Close
+template <bool Batch = false, class TQueue>
+void Blocking_Throughput(const char* name, TQueue& queue, size_t producers, size_t consumers, size_t messages)
+{
+    static constexpr size_t batch_size = 64;
+    std::atomic<long long> sum = 0;
+    
+    Timer timer;
+    timer.start();
+    std::vector<std::thread> producer_threads, consumer_threads;
+    for (size_t i = 0; i < consumers; ++i)
+    {
+        consumer_threads.emplace_back([&queue, &sum]()
+        {
+            long long local_sum = 0;
+            if constexpr (Batch)
+            {
+                int values[batch_size];
+                while (size_t count = queue.Pop_Batch(values, batch_size))
+                {
+                    for (size_t j = 0; j < count; ++j)
+                        local_sum += values[j];
+                }
+            }
+            else
+            {
+                int value = 0;
+                while (queue.Pop(value))
+                    local_sum += value;
+            }
+            sum.fetch_add(local_sum);
+        });
+    }
+    for (size_t i = 0; i < producers; ++i)
+    {
+        producer_threads.emplace_back([&queue, count = messages / producers]()
+        {
+            for (size_t j = 1; j <= count; ++j)
+                queue.Push(static_cast<int>(j));
+        });
+    }
+    for (auto& thread : producer_threads)
+        thread.join();
+    queue.Close();
+    for (auto& thread : consumer_threads)
+        thread.join();
+    timer.stop();
+    
+    const long long count = static_cast<long long>(messages / producers);
+    const long long expected = static_cast<long long>(producers) * count * (count + 1) / 2;
+    std::cout << name << ": " << timer.elapsedMilliseconds() << " ms, sum ok: " << (sum.load() == expected) << std::endl;
+}
+
+// Сообщение размером в кэш-линию: в блок std::deque (512 байт) помещается 8 штук
+struct Message
+{
+    explicit Message(size_t value = 0) : data{static_cast<long long>(value)} {}
+    explicit operator long long() const { return data[0]; }
+    
+    long long data[8] = {};
+};
+
+// Установившийся режим очереди: in_flight элементов в очереди, каждая операция - Push в конец и Pop из начала
+template <class TQueue, class T>
+void Steady_Queue(const char* name, size_t in_flight, size_t operations)
+{
+    TQueue queue;
+    for (size_t i = 0; i < in_flight; ++i)
+        queue.Push(T());
+    
+    long long sum = 0;
+    const size_t before = allocations.load();
+    Timer timer;
+    timer.start();
+    for (size_t i = 0; i < operations; ++i)
+    {
+        queue.Push(T(i));
+        sum += static_cast<long long>(queue.Front());
+        queue.Pop();
+    }
+    timer.stop();
+    
+    std::cout << name << ": " << timer.elapsedMilliseconds() << " ms, allocations: " << allocations.load() - before << " (sum " << sum << ")" << std::endl;
+}
+
+// Сообщение со встроенной связью для Intrusive_Mpsc_Queue: очередь не выделяет память
+struct Event
+{
+    size_t producer = 0;
+    size_t sequence = 0;
+    Mpsc_Hook hook;
+};
+
+class Intrusive_Mpsc_Events
+{
+public:
+    void Push(Event& event) { _queue.Push(event); }
+    
+    Event* Try_Pop()
+    {
+        if (_queue.Empty())
+            return nullptr;
+        
+        Event* event = &_queue.Front();
+        _queue.Pop();
+        return event;
+    }
+    
+private:
+    linked_list::Intrusive_Mpsc_Queue<Event, &Event::hook> _queue;
+};
+
+class Locked_Events
+{
+public:
+    void Push(Event& event)
+    {
+        std::lock_guard lock(_mutex);
+        _queue.Push(&event);
+    }
+    
+    Event* Try_Pop()
+    {
+        std::lock_guard lock(_mutex);
+        if (_queue.Empty())
+            return nullptr;
+        
+        Event* event = _queue.Front();
+        _queue.Pop();
+        return event;
+    }
+    
+private:
+    std::mutex _mutex;
+    linked_list::Queue<Event*> _queue;
+};
+
+class Mpmc_Events
+{
+public:
+    void Push(Event& event)
+    {
+        while (!_queue.Try_Push(&event))
+            std::this_thread::yield();
+    }
+    
+    Event* Try_Pop()
+    {
+        Event* event = nullptr;
+        return _queue.Try_Pop(event) ? event : nullptr;
+    }
+    
+private:
+    Mpmc_Queue<Event*> _queue{1 << 16};
+};
+
+// Цена Push для писателя: среднее время одного Push в потоке писателя, пока один читатель разбирает очередь
+template <class TQueue>
+double Producer_Cost(size_t producers, size_t messages)
+{
+    TQueue queue;
+    std::vector<std::vector<Event>> events; // Event не копируется: связь принадлежит очереди
+    events.reserve(producers);
+    for (size_t i = 0; i < producers; ++i)
+        events.emplace_back(messages);
+    std::atomic<long long> producer_ns = 0;
+    
+    std::thread consumer([&queue, &events, producers, messages]()
+    {
+        std::vector<size_t> expected(producers, 0);
+        for (size_t received = 0; received < producers * messages;)
+        {
+            Event* event = queue.Try_Pop();
+            if (!event)
+                continue;
+            
+            if (event->sequence != expected[event->producer]++) // Порядок сообщений одного писателя сохраняется
+                std::cout << "wrong order" << std::endl;
+            ++received;
+        }
+    });
+    
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < producers; ++i)
+    {
+        threads.emplace_back([&queue, &events, &producer_ns, i]()
+        {
+            const auto start = std::chrono::steady_clock::now();
+            size_t sequence = 0;
+            for (Event& event : events[i])
+            {
+                event.producer = i;
+                event.sequence = sequence++;
+                queue.Push(event);
+            }
+            producer_ns += std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+        });
+    }
+    for (auto& thread : threads)
+        thread.join();
+    consumer.join();
+    
+    return static_cast<double>(producer_ns.load()) / (producers * messages);
+}
+
+// Задача диспетчера: уровень приоритета (0 - самый высокий) и время постановки в очередь
+struct Job
+{
+    long long sent = 0;
+    size_t level = 0;
+    size_t sequence = 0; // Порядок внутри уровня для priority_queue
+};
+
+// Одна FIFO-очередь без приоритетов
+class Fifo_Dispatch
+{
+public:
+    explicit Fifo_Dispatch(size_t capacity) : _queue(capacity) {}
+    bool Try_Push(size_t, const Job& job) { return _queue.Try_Push(job); }
+    bool Try_Pop(Job& job) { return _queue.Try_Pop(job); }
+    
+private:
+    Mpmc_Queue<Job> _queue;
+};
+
+// Куча с приоритетами под общим mutex
+class Locked_Priority_Dispatch
+{
+    struct Later
+    {
+        bool operator()(const Job& lhs, const Job& rhs) const { return lhs.level != rhs.level ? lhs.level > rhs.level : lhs.sequence > rhs.sequence; }
+    };
+    
+public:
+    explicit Locked_Priority_Dispatch(size_t capacity) : _capacity(capacity) {}
+    
+    bool Try_Push(size_t, const Job& job)
+    {
+        std::lock_guard lock(_mutex);
+        if (_queue.size() == _capacity)
+            return false;
+        
+        _queue.push(job);
+        return true;
+    }
+    
+    bool Try_Pop(Job& job)
+    {
+        std::lock_guard lock(_mutex);
+        if (_queue.empty())
+            return false;
+        
+        job = _queue.top();
+        _queue.pop();
+        return true;
+    }
+    
+private:
+    std::mutex _mutex;
+    std::priority_queue<Job, std::vector<Job>, Later> _queue;
+    size_t _capacity = 0;
+};
+
+/*
+ Задержка диспетчеризации под смешанной нагрузкой: писатели ставят задачи быстрее, чем диспетчер успевает их выполнять (work_ns на задачу), поэтому очередь постоянно заполнена.
+ Каждая 10-я задача критическая (уровень 0), 30% - уровень 1, остальные - фоновые (уровень 3). Задержка - время от Push до Pop.
+ */
+template <class TQueue>
+void Dispatch_Latency(const char* name, TQueue& queue, size_t producers, size_t jobs_per_producer, long long work_ns)
+{
+    using Clock = std::chrono::steady_clock;
+    auto Now = []() { return std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now().time_since_epoch()).count(); };
+    
+    std::vector<long long> latencies[4];
+    std::thread dispatcher([&]()
+    {
+        Job job;
+        for (size_t received = 0; received < producers * jobs_per_producer;)
+        {
+            if (!queue.Try_Pop(job))
+            {
+                std::this_thread::yield();
+                continue;
+            }
+            
+            const long long start = Now();
+            latencies[job.level].push_back(start - job.sent);
+            ++received;
+            while (Now() - start < work_ns) {} // Выполнение задачи
+        }
+    });
+    
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < producers; ++i)
+    {
+        threads.emplace_back([&queue, &Now, jobs_per_producer]()
+        {
+            for (size_t j = 0; j < jobs_per_producer; ++j)
+            {
+                const size_t level = j % 10 == 0 ? 0 : (j % 10 < 4 ? 1 : 3);
+                const Job job{0, level, j};
+                while (true)
+                {
+                    Job stamped = job;
+                    stamped.sent = Now();
+                    if (queue.Try_Push(level, stamped))
+                        break;
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+    for (auto& thread : threads)
+        thread.join();
+    dispatcher.join();
+    
+    std::cout << name << " latency, us:";
+    for (size_t level : {0, 1, 3})
+    {
+        auto& values = latencies[level];
+        std::sort(values.begin(), values.end());
+        auto Percentile = [&values](double percent) { return values[static_cast<size_t>(percent / 100 * (values.size() - 1))] / 1000.0; };
+        std::cout << " level " << level << " p50 " << Percentile(50) << " p99 " << Percentile(99) << " max " << Percentile(100) << (level == 3 ? "" : ";");
+    }
+    std::cout << std::endl;
+}
+
+long long Fib(int n)
+{
+    return n < 2 ? n : Fib(n - 1) + Fib(n - 2);
+}
+
+// Fork-join: каждый вызов выше cutoff - задача Invoke
+long long Fib(Thread_Pool& pool, int n, int cutoff)
+{
+    if (n <= cutoff)
+        return Fib(n);
+    
+    long long left = 0, right = 0;
+    pool.Invoke([&]() { left = Fib(pool, n - 1, cutoff); }, [&]() { right = Fib(pool, n - 2, cutoff); });
+    return left + right;
+}
+
+// Свертка рекурсивным делением пополам до grain элементов
+long long Reduce(Thread_Pool& pool, const int* first, const int* last, size_t grain)
+{
+    if (static_cast<size_t>(last - first) <= grain)
+        return std::accumulate(first, last, 0LL);
+    
+    const int* middle = first + (last - first) / 2;
+    long long left = 0, right = 0;
+    pool.Invoke([&]() { left = Reduce(pool, first, middle, grain); }, [&]() { right = Reduce(pool, middle, last, grain); });
+    return left + right;
+}
+
 
 int main()
 {
@@ -101,6 +709,274 @@ int main()
         
         std::cout << std::endl;
     }
+    // Chunked_Deque
+    {
+        std::cout << "Queue on Chunked_Deque" << std::endl;
+        
+        Test1<DEQUE::Queue<int, Chunked_Deque<int>>>();
+        Test2<DEQUE::Queue<Example, Chunked_Deque<Example>>>();
+        
+        Chunked_Deque<int, 4> deque = {3, 4, 5};
+        deque.Push_Front(2);
+        deque.Emplace_Front(1);
+        deque.Push_Back(6);
+        std::cout << "Chunked_Deque: " << deque << "[2]: " << deque[2] << ", chunks: " << deque.Chunks() << std::endl;
+        deque.Pop_Front();
+        deque.Pop_Front();
+        std::cout << "Pop_Front x2: " << deque << "chunks: " << deque.Chunks() << ", cached: " << deque.Cached_Chunks() << std::endl;
+        deque.Shrink_To_Fit();
+        std::cout << "Shrink_To_Fit cached: " << deque.Cached_Chunks() << std::endl;
+        
+        static constexpr size_t operations = 5'000'000;
+        for (size_t in_flight : {16, 10'000})
+        {
+            std::cout << "in flight: " << in_flight << std::endl;
+            Steady_Queue<DEQUE::Queue<int>, int>("std::deque<int>", in_flight, operations);
+            Steady_Queue<DEQUE::Queue<int, Chunked_Deque<int>>, int>("Chunked_Deque<int>", in_flight, operations);
+            Steady_Queue<linked_list::Queue<int>, int>("linked_list::Queue<int>", in_flight, operations);
+            Steady_Queue<DEQUE::Queue<Message>, Message>("std::deque<Message>", in_flight, operations);
+            Steady_Queue<DEQUE::Queue<Message, Chunked_Deque<Message>>, Message>("Chunked_Deque<Message>", in_flight, operations);
+            Steady_Queue<linked_list::Queue<Message>, Message>("linked_list::Queue<Message>", in_flight, operations);
+        }
+        
+        std::cout << std::endl;
+    }
+    
+    // Многопоточные очереди
+    {
+        std::cout << "Spsc_Queue / Mpmc_Queue" << std::endl;
+        
+        Spsc_Queue<std::string, 4> strings;
+        strings.Try_Push("one");
+        strings.Try_Emplace(3, 't');
+        std::string value;
+        strings.Try_Pop(value);
+        std::cout << "Spsc_Queue: " << value << ", size: " << strings.Size() << ", capacity: " << strings.Capacity() << std::endl;
+        
+        Mpmc_Queue<std::string> mpmc_strings(3);
+        std::string values[] = {"a", "b", "c", "d", "e"};
+        std::cout << "Mpmc_Queue capacity: " << mpmc_strings.Capacity() << ", Try_Push_Batch(5): " << mpmc_strings.Try_Push_Batch(values, 5)
+                  << ", Try_Pop_Batch(2): " << mpmc_strings.Try_Pop_Batch(values, 2) << " -> " << values[0] << values[1] << std::endl;
+        
+        static constexpr size_t messages = 1 << 22;
+        static constexpr size_t capacity = 1 << 14;
+        
+        std::cout << "1 producer, 1 consumer:" << std::endl;
+        {
+            Mutex_Queue<linked_list::Queue<int>> linked_queue;
+            Throughput("mutex + linked_list::Queue", linked_queue, 1, 1, messages);
+            Mutex_Queue<DEQUE::Queue<int>> deque_queue;
+            Throughput("mutex + DEQUE::Queue", deque_queue, 1, 1, messages);
+            auto spsc = std::make_unique<Spsc_Queue<int, capacity>>();
+            Throughput("Spsc_Queue", *spsc, 1, 1, messages);
+            Throughput<true>("Spsc_Queue batch", *spsc, 1, 1, messages);
+            Mpmc_Queue<int> mpmc(capacity);
+            Throughput("Mpmc_Queue", mpmc, 1, 1, messages);
+            Throughput<true>("Mpmc_Queue batch", mpmc, 1, 1, messages);
+        }
+        
+        std::cout << "4 producers, 4 consumers:" << std::endl;
+        {
+            Mutex_Queue<linked_list::Queue<int>> linked_queue;
+            Throughput("mutex + linked_list::Queue", linked_queue, 4, 4, messages);
+            Mutex_Queue<DEQUE::Queue<int>> deque_queue;
+            Throughput("mutex + DEQUE::Queue", deque_queue, 4, 4, messages);
+            Mpmc_Queue<int> mpmc(capacity);
+            Throughput("Mpmc_Queue", mpmc, 4, 4, messages);
+            Throughput<true>("Mpmc_Queue batch", mpmc, 4, 4, messages);
+        }
+        
+        static constexpr size_t round_trips = 100'000;
+        {
+            Mutex_Queue<DEQUE::Queue<int>> request, response;
+            Latency("mutex + DEQUE::Queue", request, response, round_trips);
+        }
+        {
+            auto request = std::make_unique<Spsc_Queue<int, capacity>>();
+            auto response = std::make_unique<Spsc_Queue<int, capacity>>();
+            Latency("Spsc_Queue", *request, *response, round_trips);
+        }
+        {
+            Mpmc_Queue<int> request(capacity), response(capacity);
+            Latency("Mpmc_Queue", request, response, round_trips);
+        }
+    }
+    
+    // Блокирующие очереди
+    {
+        std::cout << "Blocking_Queue" << std::endl;
+        
+        static constexpr size_t samples = 5000;
+        {
+            Cv_Queue<long long> queue;
+            Wakeup_Latency("mutex + condition_variable", queue, samples);
+        }
+        {
+            Blocking_Queue<long long> queue(1024);
+            Wakeup_Latency("Blocking_Queue", queue, samples);
+        }
+        
+        static constexpr size_t messages = 1 << 22;
+        {
+            Cv_Queue<int> queue;
+            Blocking_Throughput("mutex + condition_variable, 2 producers, 2 consumers", queue, 2, 2, messages);
+        }
+        {
+            Blocking_Queue<int> queue(1 << 14);
+            Blocking_Throughput("Blocking_Queue Pop, 2 producers, 2 consumers", queue, 2, 2, messages);
+        }
+        {
+            Blocking_Queue<int> queue(1 << 14);
+            Blocking_Throughput<true>("Blocking_Queue Pop_Batch, 2 producers, 2 consumers", queue, 2, 2, messages);
+        }
+        
+        std::cout << std::endl;
+    }
+    
+    // Очередь MPSC
+    {
+        std::cout << "Mpsc_Queue" << std::endl;
+        
+        linked_list::Mpsc_Queue<std::string> queue;
+        queue.Push("first");
+        queue.Emplace(3, 'x');
+        std::string text = "third";
+        queue.Push(std::move(text));
+        while (!queue.Empty())
+        {
+            std::cout << queue.Front() << " ";
+            queue.Pop();
+        }
+        std::cout << std::endl;
+        
+        static constexpr size_t messages = 200'000;
+        for (size_t producers : {1, 2, 4, 8})
+        {
+            std::cout << "producers: " << producers
+                      << ", ns per Push: Intrusive_Mpsc_Queue " << Producer_Cost<Intrusive_Mpsc_Events>(producers, messages)
+                      << ", Mpmc_Queue " << Producer_Cost<Mpmc_Events>(producers, messages)
+                      << ", mutex + linked_list::Queue " << Producer_Cost<Locked_Events>(producers, messages) << std::endl;
+        }
+        
+        std::cout << std::endl;
+    }
+    
+    // Очередь с приоритетами
+    {
+        std::cout << "Multi_Level_Queue" << std::endl;
+        
+        Multi_Level_Queue<std::string, 4> queue(16);
+        queue.Try_Push(3, "background");
+        queue.Try_Push(1, "normal");
+        queue.Try_Push(0, "critical");
+        queue.Try_Push(1, "normal 2");
+        std::string value;
+        size_t level = 0;
+        while (queue.Try_Pop(value, level))
+            std::cout << level << ": " << value << std::endl;
+        
+        static constexpr size_t producers = 2;
+        static constexpr size_t jobs = 20'000;
+        static constexpr size_t capacity = 1024;
+        static constexpr long long work_ns = 1000;
+        {
+            Fifo_Dispatch fifo(capacity);
+            Dispatch_Latency("FIFO Mpmc_Queue", fifo, producers, jobs, work_ns);
+        }
+        {
+            Locked_Priority_Dispatch heap(capacity);
+            Dispatch_Latency("mutex + priority_queue", heap, producers, jobs, work_ns);
+        }
+        {
+            Multi_Level_Queue<Job, 4> levels(capacity);
+            Dispatch_Latency("Multi_Level_Queue", levels, producers, jobs, work_ns);
+        }
+        {
+            Multi_Level_Queue<Job, 4> levels(capacity, 8);
+            Dispatch_Latency("Multi_Level_Queue aging 8", levels, producers, jobs, work_ns);
+        }
+        
+        std::cout << std::endl;
+    }
+    
+    // Пул потоков с кражей задач
+    {
+        std::cout << "Thread_Pool" << std::endl;
+        
+        Thread_Pool pool;
+        std::future<int> answer = pool.Submit([]() { return 6 * 7; });
+        std::cout << "Submit: " << answer.get() << std::endl;
+        
+        std::vector<int> squares(1000);
+        std::iota(squares.begin(), squares.end(), 0);
+        pool.Parallel_For(squares.begin(), squares.end(), [](int& value) { value *= value; });
+        std::cout << "Parallel_For: squares[999] = " << squares[999] << std::endl;
+        
+        try
+        {
+            pool.Invoke([]() {}, []() { throw std::runtime_error("task failed"); });
+        }
+        catch (const std::exception& exception)
+        {
+            std::cout << "Invoke exception: " << exception.what() << std::endl;
+        }
+        
+        for (size_t threads : {1, 2, 4, 8})
+        {
+            Thread_Pool workers(threads);
+            std::cout << "threads: " << threads << std::endl;
+            
+            // Fork-join fib: без cutoff каждая задача - два сложения, т.е. измеряется только цена планировщика
+            {
+                static constexpr int n = 32;
+                Timer timer;
+                timer.start();
+                const long long serial = Fib(n);
+                timer.stop();
+                const double serial_time = timer.elapsedMilliseconds();
+                
+                timer.start();
+                const long long parallel = workers.Submit([&workers]() { return Fib(workers, n, 16); }).get();
+                timer.stop();
+                std::cout << "fib(" << n << ") = " << parallel << (parallel == serial ? "" : " wrong") << ", serial: " << serial_time << " ms, cutoff 16: " << timer.elapsedMilliseconds() << " ms";
+                
+                static constexpr int m = 25;
+                const size_t tasks = Fib(m + 1) - 1; // Количество вызовов Invoke для Fib(m) без cutoff
+                timer.start();
+                workers.Submit([&workers]() { return Fib(workers, m, 1); }).get();
+                timer.stop();
+                std::cout << ", fib(" << m << ") without cutoff: " << timer.elapsedMilliseconds() * 1'000'000 / tasks << " ns per task" << std::endl;
+            }
+            // Параллельная свертка
+            {
+                static std::vector<int> data(1 << 25, 1);
+                Timer timer;
+                timer.start();
+                const long long serial = std::accumulate(data.begin(), data.end(), 0LL);
+                timer.stop();
+                const double serial_time = timer.elapsedMilliseconds();
+                
+                timer.start();
+                const long long parallel = workers.Submit([&workers]() { return Reduce(workers, data.data(), data.data() + data.size(), 1 << 16); }).get();
+                timer.stop();
+                std::cout << "reduce " << data.size() << (parallel == serial ? "" : " wrong") << ", serial: " << serial_time << " ms, pool: " << timer.elapsedMilliseconds() << " ms" << std::endl;
+            }
+            // Submit из внешнего потока: задача, future и общая очередь под mutex
+            {
+                static constexpr size_t tasks = 100'000;
+                std::vector<std::future<void>> futures;
+                futures.reserve(tasks);
+                Timer timer;
+                timer.start();
+                for (size_t i = 0; i < tasks; ++i)
+                    futures.push_back(workers.Submit([]() {}));
+                for (auto& future : futures)
+                    future.get();
+                timer.stop();
+                std::cout << "Submit + future: " << timer.elapsedMilliseconds() * 1'000'000 / tasks << " ns per task" << std::endl;
+            }
+        }
+    }
     
     return 0;
 }
@@ -0,0 +1,172 @@
+#ifndef Concurrent_Stack_h
+#define Concurrent_Stack_h
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <utility>
+
+/*
+ Lock-free стек (Treiber stack) для нескольких писателей и читателей: узлы как у linked_list::Stack, но вершина меняется через compare_exchange (CAS), без mutex.
+ - Push - новый узел указывает на текущую вершину и CAS заменяет вершину на узел, если вершину за это время никто не изменил, иначе повтор.
+ - Try_Pop - CAS заменяет вершину на ее next.
+ Проблема ABA: поток прочитал вершину A и ее next B, другой поток снял A и B и вернул A обратно, CAS первого потока успешен (вершина снова A), но вершиной становится уже снятый B.
+ Решение - tagged pointer: вершина хранится вместе со счетчиком изменений в одном 64-битном слове (указатель - младшие 48 бит адреса x86-64/ARM64, счетчик - старшие 16 бит), каждый успешный CAS увеличивает счетчик, поэтому вернувшаяся вершина A уже не равна прочитанной.
+ Безопасное освобождение памяти: поток может прочитать next узла, который в этот момент снимает и удаляет другой поток.
+ Поэтому снятые узлы не удаляются, а попадают в собственный lock-free список свободных узлов (тоже с tagged pointer) и переиспользуются следующими Push: память узла остается памятью узла до разрушения стека (type-stable memory), чтение next устаревшего узла безопасно, а CAS с ним не пройдет из-за счетчика.
+ Память стека не уменьшается до разрушения: размер пула равен максимальному количеству элементов, которые одновременно были в стеке.
+ Top нет: между Top и Pop вершину может снять другой поток, поэтому Try_Pop сразу забирает значение. Size нет: общий счетчик - еще две атомарные операции на каждую пару Push/Try_Pop, а его значение устаревает сразу после чтения.
+ */
+template <class T>
+class Concurrent_Stack
+{
+    Concurrent_Stack(const Concurrent_Stack&) = delete;
+    Concurrent_Stack(Concurrent_Stack&&) noexcept = delete;
+    Concurrent_Stack& operator=(const Concurrent_Stack&) = delete;
+    Concurrent_Stack& operator=(Concurrent_Stack&&) noexcept = delete;
+    
+    struct Node
+    {
+        T* Value() noexcept { return std::launder(reinterpret_cast<T*>(storage)); }
+        
+        alignas(T) unsigned char storage[sizeof(T)]; // Значение живет только пока узел в стеке
+        std::atomic<Node*> next = nullptr; // atomic: next читают потоки, которые еще не знают, что узел уже снят
+    };
+    
+    static_assert(sizeof(void*) == sizeof(uint64_t), "tagged pointer: 64-bit pointers only");
+    static_assert(std::atomic<uint64_t>::is_always_lock_free);
+    
+    static constexpr int pointer_bits = 48;
+    static constexpr uint64_t pointer_mask = (uint64_t(1) << pointer_bits) - 1;
+    
+    static Node* Pointer(uint64_t tagged) noexcept { return reinterpret_cast<Node*>(tagged & pointer_mask); }
+    static uint64_t Tag(Node* node, uint64_t old_tagged) noexcept // Счетчик на 1 больше, чем у старой вершины
+    {
+        return reinterpret_cast<uint64_t>(node) | ((old_tagged & ~pointer_mask) + (pointer_mask + 1));
+    }
+
+public:
+    Concurrent_Stack() = default;
+    ~Concurrent_Stack();
+    template <typename ...Args>
+    void Emplace(Args&& ...args);
+    void Push(const T& value);
+    void Push(T&& value);
+    bool Try_Pop(T& value); // false - стек пуст
+    bool Empty() const noexcept;
+
+private:
+    static void Push_Node(std::atomic<uint64_t>& head, Node* node) noexcept;
+    static Node* Pop_Node(std::atomic<uint64_t>& head) noexcept;
+    Node* Acquire_Node();
+
+private:
+    alignas(64) std::atomic<uint64_t> _head = 0; // Вершина и свободные узлы на разных кэш-линиях: Push и Try_Pop меняют оба
+    alignas(64) std::atomic<uint64_t> _free = 0;
+};
+
+// Разрушение без конкурентного доступа: оставшиеся значения разрушаются, все узлы удаляются
+template <class T>
+Concurrent_Stack<T>::~Concurrent_Stack()
+{
+    for (Node* node = Pointer(_head.load(std::memory_order_acquire)); node;)
+    {
+        Node* next = node->next.load(std::memory_order_relaxed);
+        node->Value()->~T();
+        delete node;
+        node = next;
+    }
+    
+    for (Node* node = Pointer(_free.load(std::memory_order_acquire)); node;)
+    {
+        Node* next = node->next.load(std::memory_order_relaxed);
+        delete node;
+        node = next;
+    }
+}
+
+template <class T>
+template <typename ...Args>
+void Concurrent_Stack<T>::Emplace(Args&& ...args)
+{
+    Node* node = Acquire_Node();
+    try
+    {
+        new (node->storage) T(std::forward<Args>(args)...);
+    }
+    catch (...)
+    {
+        Push_Node(_free, node);
+        throw;
+    }
+    
+    Push_Node(_head, node);
+}
+
+template <class T>
+void Concurrent_Stack<T>::Push(const T& value)
+{
+    Emplace(value);
+}
+
+template <class T>
+void Concurrent_Stack<T>::Push(T&& value)
+{
+    Emplace(std::move(value));
+}
+
+template <class T>
+bool Concurrent_Stack<T>::Try_Pop(T& value)
+{
+    Node* node = Pop_Node(_head);
+    if (!node)
+        return false;
+    
+    value = std::move(*node->Value()); // Узел снят CAS-ом: значение принадлежит только этому потоку
+    node->Value()->~T();
+    Push_Node(_free, node);
+    return true;
+}
+
+template <class T>
+bool Concurrent_Stack<T>::Empty() const noexcept
+{
+    return Pointer(_head.load(std::memory_order_acquire)) == nullptr;
+}
+
+// release: значение и next узла видны потоку, который снимет узел (acquire в Pop_Node)
+template <class T>
+void Concurrent_Stack<T>::Push_Node(std::atomic<uint64_t>& head, Node* node) noexcept
+{
+    uint64_t top = head.load(std::memory_order_relaxed);
+    do
+    {
+        node->next.store(Pointer(top), std::memory_order_relaxed);
+    } while (!head.compare_exchange_weak(top, Tag(node, top), std::memory_order_release, std::memory_order_relaxed));
+}
+
+// next может быть прочитан у узла, который уже снял другой поток: память узла не освобождается, а CAS не пройдет, т.к. изменился счетчик
+template <class T>
+Concurrent_Stack<T>::Node* Concurrent_Stack<T>::Pop_Node(std::atomic<uint64_t>& head) noexcept
+{
+    uint64_t top = head.load(std::memory_order_acquire);
+    while (Node* node = Pointer(top))
+    {
+        if (head.compare_exchange_weak(top, Tag(node->next.load(std::memory_order_relaxed), top), std::memory_order_acquire, std::memory_order_acquire))
+            return node;
+    }
+    
+    return nullptr;
+}
+
+template <class T>
+Concurrent_Stack<T>::Node* Concurrent_Stack<T>::Acquire_Node()
+{
+    if (Node* node = Pop_Node(_free))
+        return node;
+    
+    return new Node();
+}
+
+#endif /* Concurrent_Stack_h */
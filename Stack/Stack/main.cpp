@@ -1,8 +1,18 @@
+#include <atomic>
+#include <condition_variable>
 #include <iostream>
+#include <mutex>
 #include <string>
+#include <thread>
+#include <vector>
 
 #include "LinkedList.h"
 #include "Deque.h"
+#include "Chunked_Deque.h"
+#include "Concurrent_Stack.h"
+#include "Lock_guard.h"
+#include "Spinlock.h"
+#include "Timer.h"
 
 
 class Example
@@ -80,6 +90,89 @@ void Test2()
     }
 }
 
+// Однопоточный стек под блокировкой с тем же интерфейсом, что у Concurrent_Stack
+template <class TMutex, template <class> class TGuard>
+class Locked_Stack
+{
+public:
+    void Push(int value)
+    {
+        TGuard<TMutex> lock(_mutex);
+        _stack.Push(value);
+    }
+    
+    bool Try_Pop(int& value)
+    {
+        TGuard<TMutex> lock(_mutex);
+        if (_stack.Empty())
+            return false;
+        
+        value = _stack.Top();
+        _stack.Pop();
+        return true;
+    }
+    
+private:
+    TMutex _mutex;
+    linked_list::Stack<int> _stack;
+};
+
+// Список свободных объектов: каждый поток берет объект (Try_Pop) и возвращает его (Push), общее количество операций не зависит от количества потоков
+template <class TStack>
+double Benchmark(size_t threads_count, size_t operations)
+{
+    TStack stack;
+    for (int i = 0; i < 1024; ++i)
+        stack.Push(i);
+    
+    Timer timer;
+    timer.start();
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < threads_count; ++i)
+    {
+        threads.emplace_back([&stack, count = operations / threads_count]()
+        {
+            int value = 0;
+            for (size_t j = 0; j < count; ++j)
+            {
+                if (stack.Try_Pop(value))
+                    stack.Push(value);
+            }
+        });
+    }
+    for (auto& thread : threads)
+        thread.join();
+    timer.stop();
+    
+    return timer.elapsedMilliseconds();
+}
+
+// Пачки Push/Pop: стек растет до burst элементов и опустошается, rounds раз
+template <class TStack>
+double Burst(size_t burst, size_t rounds)
+{
+    TStack stack;
+    long long sum = 0;
+    
+    Timer timer;
+    timer.start();
+    for (size_t i = 0; i < rounds; ++i)
+    {
+        for (size_t j = 0; j < burst; ++j)
+            stack.Push(static_cast<int>(j));
+        while (!stack.Empty())
+        {
+            sum += stack.Top();
+            stack.Pop();
+        }
+    }
+    timer.stop();
+    
+    if (sum != static_cast<long long>(rounds * (burst * (burst - 1) / 2)))
+        std::cout << "wrong sum" << std::endl;
+    return timer.elapsedMilliseconds();
+}
+
 
 int main()
 {
@@ -101,6 +194,75 @@ int main()
         
         std::cout << std::endl;
     }
+    // Chunked_Deque
+    {
+        std::cout << "stack on Chunked_Deque" << std::endl;
+        
+        Test1<DEQUE::Stack<int, Chunked_Deque<int>>>();
+        Test2<DEQUE::Stack<Example, Chunked_Deque<Example>>>();
+        
+        std::cout << std::endl;
+        
+        static constexpr size_t operations = 4'000'000;
+        for (size_t burst : {100, 10'000, 1'000'000})
+        {
+            std::cout << "burst " << burst
+                      << ", std::deque: " << Burst<DEQUE::Stack<int>>(burst, operations / burst) << " ms"
+                      << ", Chunked_Deque: " << Burst<DEQUE::Stack<int, Chunked_Deque<int>>>(burst, operations / burst) << " ms"
+                      << ", linked list: " << Burst<linked_list::Stack<int>>(burst, operations / burst) << " ms" << std::endl;
+        }
+        
+        std::cout << std::endl;
+    }
+    
+    // Concurrent_Stack
+    {
+        std::cout << "concurrent stack" << std::endl;
+        
+        // Проверка: каждое значение, помещенное писателями, снимается читателями ровно один раз
+        static constexpr int writers = 4;
+        static constexpr int values_per_writer = 100'000;
+        Concurrent_Stack<int> stack;
+        std::vector<std::atomic<int>> popped(writers * values_per_writer);
+        std::atomic<int> done = 0;
+        std::vector<std::thread> threads;
+        for (int i = 0; i < writers; ++i)
+        {
+            threads.emplace_back([&stack, i]()
+            {
+                for (int j = 0; j < values_per_writer; ++j)
+                    stack.Push(i * values_per_writer + j);
+            });
+            threads.emplace_back([&stack, &popped, &done]()
+            {
+                int value = 0;
+                while (done.load() < writers * values_per_writer)
+                {
+                    if (stack.Try_Pop(value))
+                    {
+                        popped[value].fetch_add(1);
+                        done.fetch_add(1);
+                    }
+                }
+            });
+        }
+        for (auto& thread : threads)
+            thread.join();
+        
+        bool once = true;
+        for (auto& count : popped)
+            once = once && count.load() == 1;
+        std::cout << "popped once: " << once << ", empty: " << stack.Empty() << std::endl;
+        
+        static constexpr size_t operations = 1 << 21;
+        for (size_t threads_count : {1, 2, 4, 8, 16, 32, 64})
+        {
+            std::cout << "threads: " << threads_count
+                      << ", Concurrent_Stack: " << Benchmark<Concurrent_Stack<int>>(threads_count, operations) << " ms"
+                      << ", Spinlock + Stack: " << Benchmark<Locked_Stack<atomic_flag::Spinlock11, Lock_guard>>(threads_count, operations) << " ms"
+                      << ", mutex + Stack: " << Benchmark<Locked_Stack<std::mutex, std::lock_guard>>(threads_count, operations) << " ms" << std::endl;
+        }
+    }
     
     return 0;
 }
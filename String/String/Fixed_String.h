@@ -0,0 +1,131 @@
+#ifndef Fixed_String_h
+#define Fixed_String_h
+
+#include "Array.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <stdexcept>
+#include <string_view>
+#include <type_traits>
+
+/*
+ Fixed_String<N> - строка фиксированной вместимости N символов без выделения памяти, для коротких ключей ограниченной длины (тикеры, коды ISO 4217/3166, идентификаторы).
+ Раскладка: Array<char, N> + размер в 1 байте, sizeof == N + 1 без выравнивания, поэтому удобные N: 7, 15, 31 (объект 8, 16, 32 байта).
+ Все байты после size всегда нули, поэтому:
+ - равенство - сравнение объектов целиком (memcmp фиксированного размера компилятор заменяет на сравнение 1-2 машинных слов или одним SSE сравнением), без ветки Is_SSO и цикла по символам.
+ - хэш - перемешивание sizeof / 8 слов объекта, без цикла по символам.
+ - копирование тривиальное (memcpy), объект можно создавать в constexpr.
+ В отличии от String: нет кучи и нет ветки SSO/не SSO, но вместимость фиксирована и превышение - исключение std::length_error.
+ */
+template <size_t N>
+class Fixed_String
+{
+    static_assert(N > 0 && N < 256, "Fixed_String: size is stored in 1 byte");
+
+public:
+    constexpr Fixed_String() noexcept = default;
+    
+    template <size_t M>
+    constexpr Fixed_String(const char (&literal)[M]) noexcept // Строковый литерал: длина проверяется при компиляции
+    {
+        static_assert(M - 1 <= N, "Fixed_String: literal is longer than capacity");
+        Assign(literal, M - 1);
+    }
+    
+    constexpr explicit Fixed_String(std::string_view view)
+    {
+        if (view.size() > N)
+            throw std::length_error("Fixed_String capacity exceeded");
+        
+        Assign(view.data(), view.size());
+    }
+    
+    // Доступ к символам только на чтение: запись после Size() нарушила бы нули в хвосте, на которых основаны operator== и Hash
+    constexpr const char& operator[](size_t index) const noexcept { return _data[index]; }
+    
+    constexpr const char& At(size_t index) const
+    {
+        if (index >= _size)
+            throw std::out_of_range("Index is out of range!");
+        
+        return _data[index];
+    }
+    
+    constexpr const char* Data() const noexcept { return _data.Data(); }
+    constexpr size_t Size() const noexcept { return _size; }
+    constexpr bool Empty() const noexcept { return _size == 0; }
+    static constexpr size_t Capacity() noexcept { return N; }
+    constexpr std::string_view View() const noexcept { return std::string_view(Data(), _size); }
+    constexpr operator std::string_view() const noexcept { return View(); }
+    
+    constexpr void Push_Back(char ch)
+    {
+        if (_size == N)
+            throw std::length_error("Fixed_String capacity exceeded");
+        
+        _data[_size++] = ch;
+    }
+    
+    constexpr void Clear() noexcept
+    {
+        for (size_t i = 0; i < _size; ++i)
+            _data[i] = '\0'; // Сохраняем нули после size
+        _size = 0;
+    }
+    
+    // Хэш по словам объекта: байты после size - нули, поэтому равные строки дают равные слова
+    size_t Hash() const noexcept
+    {
+        const auto* bytes = reinterpret_cast<const char*>(this);
+        uint64_t hash = 0x9E3779B97F4A7C15ull;
+        for (size_t i = 0; i < sizeof(Fixed_String); i += sizeof(uint64_t)) // Число итераций известно при компиляции, цикл разворачивается
+        {
+            uint64_t word = 0;
+            std::memcpy(&word, bytes + i, std::min(sizeof(uint64_t), sizeof(Fixed_String) - i));
+            hash = (hash ^ word) * 0xBF58476D1CE4E5B9ull;
+            hash ^= hash >> 31;
+        }
+        return static_cast<size_t>(hash);
+    }
+    
+    friend constexpr bool operator==(const Fixed_String& lhs, const Fixed_String& rhs) noexcept
+    {
+        if (std::is_constant_evaluated())
+            return lhs.View() == rhs.View();
+        
+        return std::memcmp(&lhs, &rhs, sizeof(Fixed_String)) == 0; // Размер + все символы одним сравнением
+    }
+    
+    friend constexpr bool operator!=(const Fixed_String& lhs, const Fixed_String& rhs) noexcept { return !(lhs == rhs); }
+    friend constexpr bool operator<(const Fixed_String& lhs, const Fixed_String& rhs) noexcept { return lhs.View() < rhs.View(); }
+    friend std::ostream& operator<<(std::ostream& os, const Fixed_String& string) { return os << string.View(); }
+
+private:
+    constexpr void Assign(const char* data, size_t size) noexcept
+    {
+        for (size_t i = 0; i < size; ++i)
+            _data[i] = data[i];
+        _size = static_cast<unsigned char>(size);
+    }
+
+private:
+    Array<char, N> _data{}; // Нули после size
+    unsigned char _size = 0;
+};
+
+template <size_t M>
+Fixed_String(const char (&)[M]) -> Fixed_String<M - 1>;
+
+template <size_t N>
+struct std::hash<Fixed_String<N>>
+{
+    size_t operator()(const Fixed_String<N>& string) const noexcept
+    {
+        return string.Hash();
+    }
+};
+
+#endif /* Fixed_String_h */
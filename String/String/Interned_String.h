@@ -0,0 +1,221 @@
+#ifndef Interned_String_h
+#define Interned_String_h
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <mutex>
+#include <string_view>
+#include <unordered_set>
+#include <utility>
+
+/*
+ Interning (интернирование строк) - каждая уникальная строка хранится в пуле в единственном экземпляре, Interned_String - это указатель на запись пула.
+ Плюсы:
+ - миллион копий одного ключа занимают 8 байт каждая + одна запись в пуле, вместо миллиона буферов в куче.
+ - сравнение на равенство - сравнение указателей: O(1) вместо O(N).
+ - хэш вычисляется один раз при интернировании и хранится в записи: O(1).
+ Минусы:
+ - интернирование требует поиска в пуле под блокировкой (хэш + сравнение строки), поэтому выгодно для часто повторяющихся и долгоживущих ключей.
+ - строка неизменяемая.
+ Запись пула (Entry) как ControlBlock у Shared_Ptr: атомарный счетчик ссылок, при обнулении запись удаляется из пула.
+ Пул разбит на shards независимых частей со своими mutex, часть выбирается по хэшу, поэтому потоки, интернирующие разные строки, редко ждут друг друга.
+ Обнуление счетчика выполняется только под mutex части: иначе другой поток мог бы найти запись в пуле и увеличить счетчик уже удаляемой записи.
+ */
+class Interned_String
+{
+    // Запись пула: счетчик ссылок, хэш и сама строка сразу за заголовком (одно выделение памяти)
+    struct Entry
+    {
+        std::atomic<uint64_t> count;
+        size_t hash;
+        size_t size;
+        
+        const char* Data() const noexcept { return reinterpret_cast<const char*>(this + 1); }
+        std::string_view View() const noexcept { return std::string_view(Data(), size); }
+    };
+    
+    // Пул записей: хэш-множество по содержимому строки
+    class Pool
+    {
+        struct Entry_Hash
+        {
+            using is_transparent = void; // Поиск по std::string_view без создания Entry
+            size_t operator()(const Entry* entry) const noexcept { return entry->hash; }
+            size_t operator()(std::string_view view) const noexcept { return std::hash<std::string_view>()(view); }
+        };
+        
+        struct Entry_Equal
+        {
+            using is_transparent = void;
+            bool operator()(const Entry* lhs, const Entry* rhs) const noexcept { return lhs == rhs; }
+            bool operator()(const Entry* lhs, std::string_view rhs) const noexcept { return lhs->View() == rhs; }
+            bool operator()(std::string_view lhs, const Entry* rhs) const noexcept { return lhs == rhs->View(); }
+        };
+        
+        struct alignas(64) Shard // на отдельной кэш-линии, чтобы избежать false sharing между mutex
+        {
+            std::mutex mutex;
+            std::unordered_set<Entry*, Entry_Hash, Entry_Equal> entries;
+        };
+        
+        static constexpr size_t shards = 16;
+    
+    public:
+        static Pool& Instance()
+        {
+            static Pool pool;
+            return pool;
+        }
+        
+        Entry* Intern(std::string_view view)
+        {
+            const size_t hash = std::hash<std::string_view>()(view);
+            Shard& shard = _shards[hash % shards];
+            std::lock_guard lock(shard.mutex);
+            if (auto it = shard.entries.find(view); it != shard.entries.end())
+            {
+                (*it)->count.fetch_add(1, std::memory_order_relaxed);
+                return *it;
+            }
+            
+            Entry* entry = new (operator new(sizeof(Entry) + view.size() + 1)) Entry{1, hash, view.size()};
+            char* data = reinterpret_cast<char*>(entry + 1);
+            std::memcpy(data, view.data(), view.size());
+            data[view.size()] = '\0';
+            shard.entries.insert(entry);
+            return entry;
+        }
+        
+        Entry* Lookup(std::string_view view)
+        {
+            const size_t hash = std::hash<std::string_view>()(view);
+            Shard& shard = _shards[hash % shards];
+            std::lock_guard lock(shard.mutex);
+            if (auto it = shard.entries.find(view); it != shard.entries.end())
+            {
+                (*it)->count.fetch_add(1, std::memory_order_relaxed);
+                return *it;
+            }
+            return nullptr;
+        }
+        
+        // Уменьшение счетчика: без блокировки, пока ссылка не последняя
+        void Release(Entry* entry)
+        {
+            uint64_t count = entry->count.load(std::memory_order_relaxed);
+            while (count > 1)
+            {
+                if (entry->count.compare_exchange_weak(count, count - 1, std::memory_order_release, std::memory_order_relaxed))
+                    return;
+            }
+            
+            Shard& shard = _shards[entry->hash % shards];
+            std::lock_guard lock(shard.mutex);
+            if (entry->count.fetch_sub(1, std::memory_order_acq_rel) == 1)
+            {
+                shard.entries.erase(entry);
+                entry->~Entry();
+                operator delete(entry);
+            }
+        }
+        
+        // Количество уникальных строк и занимаемая ими память
+        std::pair<size_t, size_t> Statistics()
+        {
+            size_t count = 0, bytes = 0;
+            for (auto& shard : _shards)
+            {
+                std::lock_guard lock(shard.mutex);
+                count += shard.entries.size();
+                for (const Entry* entry : shard.entries)
+                    bytes += sizeof(Entry) + entry->size + 1;
+            }
+            return {count, bytes};
+        }
+    
+    private:
+        Shard _shards[shards];
+    };
+
+public:
+    // Пустая строка не интернируется: у нее, как у созданного по умолчанию и перемещенного Interned_String, _entry == nullptr, поэтому все пустые строки равны и имеют хэш 0
+    Interned_String() noexcept = default;
+    explicit Interned_String(std::string_view view) : _entry(view.empty() ? nullptr : Pool::Instance().Intern(view)) {}
+    
+    Interned_String(const Interned_String& other) noexcept : _entry(other._entry)
+    {
+        if (_entry)
+            _entry->count.fetch_add(1, std::memory_order_relaxed);
+    }
+    
+    Interned_String(Interned_String&& other) noexcept : _entry(std::exchange(other._entry, nullptr)) {}
+    
+    ~Interned_String()
+    {
+        if (_entry)
+            Pool::Instance().Release(_entry);
+    }
+    
+    Interned_String& operator=(const Interned_String& other) noexcept
+    {
+        if (this == &other) // object = object
+            return *this;
+        
+        Interned_String tmp(other);
+        Swap(tmp);
+        return *this;
+    }
+    
+    Interned_String& operator=(Interned_String&& other) noexcept
+    {
+        if (this == &other) // object = object
+            return *this;
+        
+        Interned_String tmp(std::move(other));
+        Swap(tmp);
+        return *this;
+    }
+    
+    // Поиск без добавления: пустой Interned_String, если строки нет в пуле
+    static Interned_String Lookup(std::string_view view)
+    {
+        Interned_String string;
+        if (!view.empty())
+            string._entry = Pool::Instance().Lookup(view);
+        return string;
+    }
+    
+    static std::pair<size_t, size_t> Pool_Statistics()
+    {
+        return Pool::Instance().Statistics();
+    }
+    
+    // Равные строки - это одна и та же запись пула
+    bool operator==(const Interned_String& other) const noexcept { return _entry == other._entry; }
+    bool operator!=(const Interned_String& other) const noexcept { return _entry != other._entry; }
+    
+    void Swap(Interned_String& other) noexcept { std::swap(_entry, other._entry); }
+    size_t Hash() const noexcept { return _entry ? _entry->hash : 0; }
+    size_t Size() const noexcept { return _entry ? _entry->size : 0; }
+    bool Empty() const noexcept { return Size() == 0; }
+    const char* Data() const noexcept { return _entry ? _entry->Data() : ""; }
+    std::string_view View() const noexcept { return _entry ? _entry->View() : std::string_view(); }
+    
+    friend std::ostream& operator<<(std::ostream& os, const Interned_String& string) { return os << string.View(); }
+
+private:
+    Entry* _entry = nullptr;
+};
+
+template<>
+struct std::hash<Interned_String>
+{
+    size_t operator()(const Interned_String& string) const noexcept
+    {
+        return string.Hash();
+    }
+};
+
+#endif /* Interned_String_h */
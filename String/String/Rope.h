@@ -0,0 +1,317 @@
+#ifndef Rope_h
+#define Rope_h
+
+#include "String.h"
+
+#include <algorithm>
+#include <iostream>
+#include <memory>
+#include <string_view>
+#include <vector>
+
+/*
+ Rope (веревка) - строка в виде сбалансированного (AVL) дерева, в листьях которого лежат куски текста String размером до leaf_size.
+ Все операции сводятся к двум:
+ - Join (склейка двух деревьев): спуск по краю более высокого дерева до поддерева нужной высоты + повороты по пути вверх. Time: O(log(N))
+ - Split (разрез по позиции): спуск к позиции, по пути вверх куски склеиваются Join. Time: O(log(N))
+ Insert = Split + Join + Join, Erase = Split + Split + Join, Substr = Split + Split.
+ Узлы неизменяемые и разделяемые (std::shared_ptr<const Node>): при изменении копируется только путь от корня до места изменения, остальные узлы общие. Поэтому копирование Rope и Substr - O(1)/O(log(N)) без копирования текста.
+ Плюсы:
+ - вставка/удаление в середину большого текста - O(log(N)) вместо O(N) со сдвигом и реаллокацией.
+ - обход кусков без копирования (Begin/End) - готовый массив iovec для writev.
+ Минусы:
+ - доступ по индексу - O(log(N)) вместо O(1).
+ - накладные расходы на узлы, поэтому маленькие соседние куски склеиваются в один лист.
+ */
+class Rope
+{
+    static constexpr size_t leaf_size = 512; // Максимальный размер листа при склейке маленьких кусков
+    
+    struct Node;
+    using Ptr = std::shared_ptr<const Node>;
+    
+    struct Node
+    {
+        Ptr left;
+        Ptr right;
+        String leaf; // Текст, только у листа
+        size_t size = 0;
+        int height = 1;
+        
+        bool Is_Leaf() const noexcept { return !left; }
+    };
+
+public:
+    class Iterator;
+    
+    Rope() = default;
+    explicit Rope(std::string_view view) : _root(Build(view)) {}
+    
+    size_t Size() const noexcept { return Size(_root); }
+    bool Empty() const noexcept { return Size() == 0; }
+    char operator[](size_t index) const;
+    char At(size_t index) const;
+    
+    void Append(std::string_view view);
+    void Append(const Rope& other);
+    void Insert(size_t position, std::string_view view);
+    void Insert(size_t position, const Rope& other);
+    void Erase(size_t position, size_t count);
+    Rope Substr(size_t position, size_t count) const;
+    static Rope Concat(const Rope& lhs, const Rope& rhs);
+    String To_String() const;
+    
+    // Обход кусков текста по порядку без копирования
+    Iterator Begin() const;
+    Iterator End() const;
+
+private:
+    explicit Rope(Ptr root) : _root(std::move(root)) {}
+    
+    static size_t Size(const Ptr& node) noexcept { return node ? node->size : 0; }
+    static int Height(const Ptr& node) noexcept { return node ? node->height : 0; }
+    static Ptr Leaf(std::string_view view);
+    static Ptr Make(Ptr left, Ptr right);
+    static Ptr Balance(Ptr left, Ptr right);
+    static Ptr Join(Ptr left, Ptr right);
+    static std::pair<Ptr, Ptr> Split(const Ptr& node, size_t position);
+    static Ptr Build(std::string_view view);
+
+private:
+    Ptr _root;
+};
+
+// Итератор по листьям: разыменование дает std::string_view куска
+class Rope::Iterator
+{
+    friend class Rope;
+
+public:
+    Iterator() = default;
+    
+    std::string_view operator*() const noexcept { return std::string_view(_leaf->leaf); }
+    Iterator& operator++() { Next(); return *this; }
+    bool operator==(const Iterator& other) const noexcept { return _leaf == other._leaf; }
+    bool operator!=(const Iterator& other) const noexcept { return _leaf != other._leaf; }
+
+private:
+    explicit Iterator(const Node* root)
+    {
+        if (root && root->size > 0)
+        {
+            _stack.push_back(root);
+            Next();
+        }
+    }
+    
+    // Спуск к самому левому листу из еще не пройденных: правые поддеревья откладываются в стек
+    void Next()
+    {
+        _leaf = nullptr;
+        if (_stack.empty())
+            return;
+        
+        const Node* node = _stack.back();
+        _stack.pop_back();
+        while (!node->Is_Leaf())
+        {
+            _stack.push_back(node->right.get());
+            node = node->left.get();
+        }
+        _leaf = node;
+    }
+
+private:
+    std::vector<const Node*> _stack; // Глубина - O(log(N))
+    const Node* _leaf = nullptr;
+};
+
+inline char Rope::operator[](size_t index) const
+{
+    const Node* node = _root.get();
+    while (!node->Is_Leaf())
+    {
+        if (index < node->left->size)
+        {
+            node = node->left.get();
+        }
+        else
+        {
+            index -= node->left->size;
+            node = node->right.get();
+        }
+    }
+    return node->leaf[index];
+}
+
+inline char Rope::At(size_t index) const
+{
+    if (index >= Size())
+        throw std::out_of_range("Index is out of range!");
+    
+    return (*this)[index];
+}
+
+inline void Rope::Append(std::string_view view)
+{
+    _root = Join(_root, Build(view));
+}
+
+inline void Rope::Append(const Rope& other)
+{
+    _root = Join(_root, other._root);
+}
+
+inline void Rope::Insert(size_t position, std::string_view view)
+{
+    Insert(position, Rope(view));
+}
+
+inline void Rope::Insert(size_t position, const Rope& other)
+{
+    if (position > Size())
+        throw std::out_of_range("Position is out of range!");
+    
+    auto [left, right] = Split(_root, position);
+    _root = Join(Join(std::move(left), other._root), std::move(right));
+}
+
+inline void Rope::Erase(size_t position, size_t count)
+{
+    if (position > Size())
+        throw std::out_of_range("Position is out of range!");
+    
+    auto [left, rest] = Split(_root, position);
+    auto [middle, right] = Split(rest, count);
+    _root = Join(std::move(left), std::move(right));
+}
+
+inline Rope Rope::Substr(size_t position, size_t count) const
+{
+    if (position > Size())
+        throw std::out_of_range("Position is out of range!");
+    
+    auto [left, rest] = Split(_root, position);
+    auto [middle, right] = Split(rest, count);
+    return Rope(std::move(middle));
+}
+
+inline Rope Rope::Concat(const Rope& lhs, const Rope& rhs)
+{
+    return Rope(Join(lhs._root, rhs._root));
+}
+
+inline String Rope::To_String() const
+{
+    String result;
+    result.Reserve(Size());
+    for (auto it = Begin(); it != End(); ++it)
+        result.Append(*it);
+    return result;
+}
+
+inline Rope::Iterator Rope::Begin() const
+{
+    return Iterator(_root.get());
+}
+
+inline Rope::Iterator Rope::End() const
+{
+    return Iterator();
+}
+
+inline Rope::Ptr Rope::Leaf(std::string_view view)
+{
+    if (view.empty())
+        return nullptr;
+    
+    auto node = std::make_shared<Node>();
+    node->leaf = String(view);
+    node->size = view.size();
+    return node;
+}
+
+inline Rope::Ptr Rope::Make(Ptr left, Ptr right)
+{
+    auto node = std::make_shared<Node>();
+    node->size = left->size + right->size;
+    node->height = std::max(left->height, right->height) + 1;
+    node->left = std::move(left);
+    node->right = std::move(right);
+    return node;
+}
+
+// Узел из поддеревьев, высоты которых отличаются не больше чем на 2: одинарный или двойной поворот восстанавливает AVL-баланс
+inline Rope::Ptr Rope::Balance(Ptr left, Ptr right)
+{
+    if (Height(left) > Height(right) + 1)
+    {
+        if (Height(left->left) >= Height(left->right))
+            return Make(left->left, Make(left->right, std::move(right))); // Правый поворот
+        return Make(Make(left->left, left->right->left), Make(left->right->right, std::move(right))); // Лево-правый поворот
+    }
+    if (Height(right) > Height(left) + 1)
+    {
+        if (Height(right->right) >= Height(right->left))
+            return Make(Make(std::move(left), right->left), right->right); // Левый поворот
+        return Make(Make(std::move(left), right->left->left), Make(right->left->right, right->right)); // Право-левый поворот
+    }
+    return Make(std::move(left), std::move(right));
+}
+
+inline Rope::Ptr Rope::Join(Ptr left, Ptr right)
+{
+    if (!left)
+        return right;
+    if (!right)
+        return left;
+    
+    // Маленькие соседние листья склеиваются, чтобы дерево из вставок по 1 символу не состояло из листьев по 1 символу
+    if (left->Is_Leaf() && right->Is_Leaf() && left->size + right->size <= leaf_size)
+    {
+        String text(std::string_view(left->leaf));
+        text.Append(std::string_view(right->leaf));
+        return Leaf(text);
+    }
+    
+    if (left->height > right->height + 1)
+        return Balance(left->left, Join(left->right, std::move(right)));
+    if (right->height > left->height + 1)
+        return Balance(Join(std::move(left), right->left), right->right);
+    return Make(std::move(left), std::move(right));
+}
+
+inline std::pair<Rope::Ptr, Rope::Ptr> Rope::Split(const Ptr& node, size_t position)
+{
+    if (!node || position == 0)
+        return {nullptr, node};
+    if (position >= node->size)
+        return {node, nullptr};
+    
+    if (node->Is_Leaf())
+    {
+        std::string_view view(node->leaf);
+        return {Leaf(view.substr(0, position)), Leaf(view.substr(position))};
+    }
+    
+    if (position < node->left->size)
+    {
+        auto [left, right] = Split(node->left, position);
+        return {std::move(left), Join(std::move(right), node->right)};
+    }
+    
+    auto [left, right] = Split(node->right, position - node->left->size);
+    return {Join(node->left, std::move(left)), std::move(right)};
+}
+
+// Сбалансированное дерево из большого текста: делится пополам до листьев размером leaf_size
+inline Rope::Ptr Rope::Build(std::string_view view)
+{
+    if (view.size() <= leaf_size)
+        return Leaf(view);
+    
+    const size_t middle = view.size() / 2;
+    return Make(Build(view.substr(0, middle)), Build(view.substr(middle)));
+}
+
+#endif /* Rope_h */
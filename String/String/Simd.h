@@ -0,0 +1,232 @@
+#ifndef Simd_h
+#define Simd_h
+
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <iostream>
+
+#if defined(__AVX2__) || defined(__SSE2__) || defined(_M_X64)
+    #include <immintrin.h>
+#endif
+
+/*
+ Поиск в строке с помощью SIMD (Single Instruction Multiple Data): за одну инструкцию сравнивается 16 (SSE2) или 32 (AVX2) байта.
+ Поиск символа (как memchr): блок сравнивается с символом, размноженным во все байты регистра (_mm_set1_epi8), _mm_movemask_epi8 собирает результат сравнения в битовую маску, номер младшего установленного бита - позиция первого совпадения.
+ Поиск подстроки (алгоритм Wojciech Muła): одновременно сравниваются блок с первым символом подстроки и блок, сдвинутый на (needle_size - 1), с последним символом подстроки. Полное сравнение memcmp выполняется только для позиций, где совпали оба символа, поэтому ложных кандидатов мало.
+ SSE4.2 pcmpistri не используется: у нее большая задержка (~11 тактов) и она проигрывает сравнению первого/последнего символа на SSE2/AVX2.
+ Поиск любого символа из множества (Char_Set): блок сравнивается с каждым символом множества, результаты объединяются OR.
+ Без SSE2/AVX2 (например, ARM) используется скалярная реализация.
+ */
+namespace simd
+{
+    static constexpr size_t npos = static_cast<size_t>(-1);
+
+#if defined(__AVX2__)
+    using Register = __m256i;
+    static constexpr size_t width = 32;
+    
+    inline Register Set(char ch) noexcept { return _mm256_set1_epi8(ch); }
+    inline Register Load(const char* data) noexcept { return _mm256_loadu_si256(reinterpret_cast<const Register*>(data)); }
+    inline unsigned Equal_Mask(Register lhs, Register rhs) noexcept { return static_cast<unsigned>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(lhs, rhs))); }
+    inline unsigned Equal_Mask(Register lhs1, Register rhs1, Register lhs2, Register rhs2) noexcept
+    {
+        return static_cast<unsigned>(_mm256_movemask_epi8(_mm256_and_si256(_mm256_cmpeq_epi8(lhs1, rhs1), _mm256_cmpeq_epi8(lhs2, rhs2))));
+    }
+    inline Register Equal(Register lhs, Register rhs) noexcept { return _mm256_cmpeq_epi8(lhs, rhs); }
+    inline Register Or(Register lhs, Register rhs) noexcept { return _mm256_or_si256(lhs, rhs); }
+    inline unsigned Mask(Register value) noexcept { return static_cast<unsigned>(_mm256_movemask_epi8(value)); }
+    #define SIMD_ENABLED 1
+#elif defined(__SSE2__) || defined(_M_X64)
+    using Register = __m128i;
+    static constexpr size_t width = 16;
+    
+    inline Register Set(char ch) noexcept { return _mm_set1_epi8(ch); }
+    inline Register Load(const char* data) noexcept { return _mm_loadu_si128(reinterpret_cast<const Register*>(data)); }
+    inline unsigned Equal_Mask(Register lhs, Register rhs) noexcept { return static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(lhs, rhs))); }
+    inline unsigned Equal_Mask(Register lhs1, Register rhs1, Register lhs2, Register rhs2) noexcept
+    {
+        return static_cast<unsigned>(_mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi8(lhs1, rhs1), _mm_cmpeq_epi8(lhs2, rhs2))));
+    }
+    inline Register Equal(Register lhs, Register rhs) noexcept { return _mm_cmpeq_epi8(lhs, rhs); }
+    inline Register Or(Register lhs, Register rhs) noexcept { return _mm_or_si128(lhs, rhs); }
+    inline unsigned Mask(Register value) noexcept { return static_cast<unsigned>(_mm_movemask_epi8(value)); }
+    #define SIMD_ENABLED 1
+#else
+    static constexpr size_t width = 1; // Скалярная реализация: блок из одного байта
+#endif
+    
+    // Позиция первого символа ch в [data, data + size) или npos
+    inline size_t Find(const char* data, size_t size, char ch) noexcept
+    {
+        size_t i = 0;
+#if defined(SIMD_ENABLED)
+        const Register pattern = Set(ch);
+        for (; i + width <= size; i += width)
+        {
+            if (unsigned mask = Equal_Mask(Load(data + i), pattern))
+                return i + static_cast<size_t>(std::countr_zero(mask));
+        }
+#endif
+        for (; i < size; ++i)
+        {
+            if (data[i] == ch)
+                return i;
+        }
+        return npos;
+    }
+    
+    // Позиция последнего символа ch в [data, data + size) или npos
+    inline size_t RFind(const char* data, size_t size, char ch) noexcept
+    {
+        size_t i = size;
+#if defined(SIMD_ENABLED)
+        const Register pattern = Set(ch);
+        for (; i >= width; i -= width)
+        {
+            if (unsigned mask = Equal_Mask(Load(data + i - width), pattern))
+                return i - width + static_cast<size_t>(31 - std::countl_zero(mask)); // Старший установленный бит
+        }
+#endif
+        while (i-- > 0)
+        {
+            if (data[i] == ch)
+                return i;
+        }
+        return npos;
+    }
+    
+    // Позиция первого вхождения подстроки [needle, needle + needle_size) в [data, data + size) или npos
+    inline size_t Find(const char* data, size_t size, const char* needle, size_t needle_size) noexcept
+    {
+        if (needle_size == 0)
+            return 0;
+        if (needle_size > size)
+            return npos;
+        if (needle_size == 1)
+            return Find(data, size, needle[0]);
+        
+        size_t i = 0;
+#if defined(SIMD_ENABLED)
+        const Register first = Set(needle[0]);
+        const Register last = Set(needle[needle_size - 1]);
+        for (; i + width + needle_size - 1 <= size; i += width)
+        {
+            unsigned mask = Equal_Mask(Load(data + i), first, Load(data + i + needle_size - 1), last);
+            while (mask)
+            {
+                const size_t position = i + static_cast<size_t>(std::countr_zero(mask));
+                if (std::memcmp(data + position + 1, needle + 1, needle_size - 2) == 0)
+                    return position;
+                mask &= mask - 1; // Сброс младшего бита
+            }
+        }
+#endif
+        for (; i + needle_size <= size; ++i)
+        {
+            if (data[i] == needle[0] && std::memcmp(data + i + 1, needle + 1, needle_size - 1) == 0)
+                return i;
+        }
+        return npos;
+    }
+    
+    // Позиция последнего вхождения подстроки, начинающегося не позже position, или npos
+    inline size_t RFind(const char* data, size_t size, const char* needle, size_t needle_size, size_t position = npos) noexcept
+    {
+        if (needle_size > size)
+            return npos;
+        
+        size_t end = std::min(position, size - needle_size) + 1; // Кандидаты: [0, end)
+        if (needle_size == 0)
+            return end - 1;
+        
+        while ((end = RFind(data, end, needle[0])) != npos)
+        {
+            if (std::memcmp(data + end + 1, needle + 1, needle_size - 1) == 0)
+                return end;
+        }
+        return npos;
+    }
+    
+    /*
+     Множество символов (например, разделители CSV: ",\n") для поиска первого символа из множества (как strpbrk).
+     До max_patterns символов: блок сравнивается с каждым символом, результаты объединяются OR, одна маска на блок.
+     Больше символов: таблица на 256 значений байта, по одному символу за шаг.
+     Регистры с размноженными символами создаются один раз в конструкторе, а не при каждом поиске.
+     */
+    class Char_Set
+    {
+    public:
+        static constexpr size_t max_patterns = 8;
+        
+        Char_Set(const char* set, size_t size) noexcept
+        {
+            for (size_t i = 0; i < size; ++i)
+                _table[static_cast<unsigned char>(set[i])] = true;
+#if defined(SIMD_ENABLED)
+            _count = size <= max_patterns ? size : 0;
+            for (size_t i = 0; i < _count; ++i)
+                _patterns[i] = Set(set[i]);
+#endif
+        }
+        
+        bool Contains(char ch) const noexcept { return _table[static_cast<unsigned char>(ch)]; }
+        
+        // Битовая маска символов из множества в блоке [data, data + width): бит i установлен, если data[i] входит в множество
+        unsigned Block_Mask(const char* data) const noexcept
+        {
+#if defined(SIMD_ENABLED)
+            if (_count > 0)
+            {
+                const Register block = Load(data);
+                Register found = Equal(block, _patterns[0]);
+                for (size_t j = 1; j < _count; ++j)
+                    found = Or(found, Equal(block, _patterns[j]));
+                return Mask(found);
+            }
+#endif
+            unsigned mask = 0;
+            for (size_t i = 0; i < width; ++i)
+                mask |= static_cast<unsigned>(_table[static_cast<unsigned char>(data[i])]) << i;
+            return mask;
+        }
+        
+        // Позиция первого символа из множества в [data, data + size) или npos
+        size_t Find(const char* data, size_t size) const noexcept
+        {
+            size_t i = 0;
+#if defined(SIMD_ENABLED)
+            if (_count > 0)
+            {
+                for (; i + width <= size; i += width)
+                {
+                    const Register block = Load(data + i);
+                    Register found = Equal(block, _patterns[0]);
+                    for (size_t j = 1; j < _count; ++j)
+                        found = Or(found, Equal(block, _patterns[j]));
+                    
+                    if (unsigned mask = Mask(found))
+                        return i + static_cast<size_t>(std::countr_zero(mask));
+                }
+            }
+#endif
+            for (; i < size; ++i)
+            {
+                if (_table[static_cast<unsigned char>(data[i])])
+                    return i;
+            }
+            return npos;
+        }
+    
+    private:
+#if defined(SIMD_ENABLED)
+        Register _patterns[max_patterns];
+        size_t _count = 0;
+#endif
+        bool _table[256] = {};
+    };
+}
+
+#undef SIMD_ENABLED
+
+#endif /* Simd_h */
@@ -1,68 +1,522 @@
 #ifndef String_h
 #define String_h
 
+#include "Simd.h"
+#include "Utf8.h"
+
+#include <atomic>
+#include <bit>
+#include <cstring>
 #include <iostream>
+#include <new>
+#include <string>
+#include <string_view>
 
+/*
+ SSO (Small String Optimization) по схеме SSO-23: sizeof(String) == 24 байта, а в самой строке без выделения памяти помещается до 23 символов + (\0).
+ Большая строка: data (8 байт) + size (8 байт) + capacity (8 байт).
+ Маленькая строка: data (23 байта) + remaining (1 байт), remaining = 23 - size. Когда size == 23, remaining == 0 и служит нуль-терминатором, поэтому используются все 23 байта.
+ Признак большой строки - старший бит capacity. На little-endian это старший бит последнего байта объекта, который у маленькой строки всегда 0 (remaining <= 23).
+ Размер хранится внутри union, отдельного поля _size нет.
+ Кэш хэша (Hash): у большой строки хэш хранится в буфере перед data (+8 байт к выделению), вычисляется при первом вызове и сбрасывается при изменении строки, поэтому длинные ключи (URL, пути) в хэш-таблице хэшируются один раз, а не при каждом поиске. sizeof(String) не меняется.
+ - маленькая строка (до 23 символов) хэшируется каждый раз: это дешевле, чем хранить кэш.
+ - кэш сбрасывается в Set_Size (все изменения размера) и в неконстантных Data() / operator[], т.к. через них строку можно изменить. Указатель, полученный через Data() раньше, нельзя использовать для изменения строки после вызова Hash().
+ - 0 означает "хэш не вычислен", хэш равный 0 просто не кэшируется. Вычисление в const методе через atomic_ref (relaxed): одновременные Hash() из разных потоков безопасны, как и другие const методы.
+ */
 class String
 {
+    static_assert(std::endian::native == std::endian::little, "String: SSO layout requires little-endian");
+    
     union Impl
     {
         struct big_string
         {
             char* data; // 8 байт
-            size_t capacity; // 8 байт
+            size_t size; // 8 байт
+            size_t capacity; // 8 байт, старший бит - признак большой строки
         } big;
         
         struct small_string
         {
-            char data[sizeof(big_string)];
+            char data[sizeof(big_string) - 1]; // 23 байта
+            unsigned char remaining; // 1 байт: sso - size
         } small;
     } impl;
     
-    static constexpr std::size_t sso = sizeof(Impl::big_string);
-    
+    static constexpr std::size_t sso = sizeof(Impl::small_string::data);
+    static constexpr std::size_t big_flag = std::size_t(1) << (sizeof(std::size_t) * 8 - 1);
+
 public:
-    explicit String(const char* data, std::size_t size):
-    _size(size)
+    static constexpr std::size_t npos = simd::npos;
+    
+    String() noexcept;
+    explicit String(const char* data, std::size_t size);
+    explicit String(const char* data) : String(data, strlen(data)) {}
+    explicit String(std::string_view view) : String(view.data(), view.size()) {}
+    String(const String& other);
+    String(String&& other) noexcept;
+    ~String();
+    String& operator=(const String& other);
+    String& operator=(String&& other) noexcept;
+    
+    char& operator[](std::size_t index) noexcept;
+    const char& operator[](std::size_t index) const noexcept;
+    String& operator+=(const String& other);
+    String& operator+=(std::string_view view);
+    String& operator+=(char ch);
+    operator std::string_view() const noexcept;
+    
+    char* Data() noexcept;
+    const char* Data() const noexcept;
+    const char* C_Str() const noexcept;
+    std::size_t Size() const noexcept;
+    std::size_t Capacity() const noexcept;
+    bool Empty() const noexcept;
+    
+    void Reserve(std::size_t capacity);
+    void Resize(std::size_t size, char ch = '\0');
+    void Clear() noexcept;
+    void Swap(String& other) noexcept;
+    String& Append(const char* data, std::size_t size);
+    String& Append(std::string_view view);
+    String& Append(std::size_t count, char ch);
+    void Push_Back(char ch);
+    
+    int Compare(std::string_view view) const noexcept;
+    std::size_t Hash() const noexcept; // Совпадает с std::hash<std::string_view>, у большой строки кэшируется
+    std::size_t Find(char ch, std::size_t position = 0) const noexcept;
+    std::size_t Find(std::string_view view, std::size_t position = 0) const noexcept;
+    std::size_t RFind(char ch, std::size_t position = npos) const noexcept;
+    std::size_t RFind(std::string_view view, std::size_t position = npos) const noexcept;
+    std::string_view Substr(std::size_t position, std::size_t count = npos) const; // Без копирования: view живет не дольше строки и до ее изменения
+    
+    // UTF-8
+    bool Validate_UTF8() const noexcept;
+    std::size_t Length_Code_Points() const noexcept; // Количество символов, строка должна быть корректной UTF-8
+    std::u16string To_UTF16() const;
+    std::u32string To_UTF32() const;
+    static String From_UTF16(std::u16string_view view);
+    static String From_UTF32(std::u32string_view view);
+    
+    friend bool operator==(const String& lhs, std::string_view rhs) noexcept { return lhs.Compare(rhs) == 0; }
+    friend bool operator!=(const String& lhs, std::string_view rhs) noexcept { return lhs.Compare(rhs) != 0; }
+    friend bool operator<(const String& lhs, std::string_view rhs) noexcept { return lhs.Compare(rhs) < 0; }
+    friend std::ostream& operator<<(std::ostream& os, const String& string) { return os << std::string_view(string); }
+
+private:
+    bool Is_SSO() const noexcept;
+    void Set_Size(std::size_t size) noexcept;
+    void Reallocate(std::size_t capacity);
+    void Destroy() noexcept;
+    void Reset_Hash() noexcept;
+    std::size_t& Hash_Cache() const noexcept;
+    static char* Allocate(std::size_t capacity);
+    static void Deallocate(char* data) noexcept;
+    
+    static std::size_t Grow(std::size_t capacity, std::size_t required) noexcept
     {
-        char* buffer = nullptr;
-        if (Is_SSO()) // 15, т.к. на конце должен (\0)
+        return std::max(required, capacity * 2); // Геометрический рост: Append за амортизированное O(1) на символ
+    }
+};
+
+inline String::String() noexcept
+{
+    impl.small.data[0] = '\0';
+    impl.small.remaining = sso;
+}
+
+inline String::String(const char* data, std::size_t size)
+{
+    char* buffer = nullptr;
+    if (size <= sso) // 23, т.к. на конце должен (\0)
+    {
+        buffer = impl.small.data;
+        impl.small.remaining = static_cast<unsigned char>(sso - size);
+    }
+    else
+    {
+        buffer = impl.big.data = Allocate(size);
+        impl.big.size = size;
+        impl.big.capacity = size | big_flag;
+    }
+    
+    std::memcpy(buffer, data, size);
+    Set_Size(size); // Записывает (\0)
+}
+
+inline String::String(const String& other) : String(other.Data(), other.Size())
+{
+    if (!Is_SSO() && !other.Is_SSO()) // Копия ключа при вставке в хэш-таблицу не хэшируется заново
+        Hash_Cache() = std::atomic_ref<std::size_t>(other.Hash_Cache()).load(std::memory_order_relaxed);
+}
+
+inline String::String(String&& other) noexcept
+{
+    std::memcpy(&impl, &other.impl, sizeof(Impl)); // Забираем буфер или копируем маленькую строку целиком
+    other.impl.small.data[0] = '\0';
+    other.impl.small.remaining = sso;
+}
+
+inline String::~String()
+{
+    Destroy();
+}
+
+inline String& String::operator=(const String& other)
+{
+    if (this == &other) // object = object
+        return *this;
+    
+    String tmp(other);
+    Swap(tmp);
+    return *this;
+}
+
+inline String& String::operator=(String&& other) noexcept
+{
+    if (this == &other) // object = object
+        return *this;
+    
+    Destroy();
+    std::memcpy(&impl, &other.impl, sizeof(Impl));
+    other.impl.small.data[0] = '\0';
+    other.impl.small.remaining = sso;
+    return *this;
+}
+
+inline char& String::operator[](std::size_t index) noexcept
+{
+    return Data()[index];
+}
+
+inline const char& String::operator[](std::size_t index) const noexcept
+{
+    return Data()[index];
+}
+
+inline String& String::operator+=(const String& other)
+{
+    return Append(other.Data(), other.Size());
+}
+
+inline String& String::operator+=(std::string_view view)
+{
+    return Append(view.data(), view.size());
+}
+
+inline String& String::operator+=(char ch)
+{
+    Push_Back(ch);
+    return *this;
+}
+
+inline String::operator std::string_view() const noexcept
+{
+    return std::string_view(Data(), Size());
+}
+
+inline char* String::Data() noexcept
+{
+    if (Is_SSO())
+        return impl.small.data;
+    
+    Reset_Hash(); // Через указатель строку можно изменить
+    return impl.big.data;
+}
+
+inline const char* String::Data() const noexcept
+{
+    return Is_SSO() ? impl.small.data : impl.big.data;
+}
+
+inline const char* String::C_Str() const noexcept
+{
+    return Data();
+}
+
+inline std::size_t String::Size() const noexcept
+{
+    return Is_SSO() ? sso - impl.small.remaining : impl.big.size;
+}
+
+inline std::size_t String::Capacity() const noexcept
+{
+    return Is_SSO() ? sso : impl.big.capacity & ~big_flag;
+}
+
+inline bool String::Empty() const noexcept
+{
+    return Size() == 0;
+}
+
+inline void String::Reserve(std::size_t capacity)
+{
+    if (capacity <= Capacity())
+        return;
+    
+    Reallocate(capacity);
+}
+
+inline void String::Resize(std::size_t size, char ch)
+{
+    const std::size_t old_size = Size();
+    if (size > old_size)
+    {
+        Reserve(size);
+        std::memset(Data() + old_size, ch, size - old_size);
+    }
+    Set_Size(size);
+}
+
+inline void String::Clear() noexcept
+{
+    Set_Size(0);
+}
+
+inline void String::Swap(String& other) noexcept
+{
+    std::swap(impl, other.impl);
+}
+
+inline String& String::Append(const char* data, std::size_t size)
+{
+    const std::size_t old_size = Size();
+    if (old_size + size > Capacity())
+    {
+        // data может указывать внутрь этой же строки (s.Append(s)), а после реаллокации старый буфер будет удален
+        const char* begin = Data();
+        if (data >= begin && data < begin + old_size)
         {
-            buffer = impl.small.data;
+            const std::size_t offset = static_cast<std::size_t>(data - begin);
+            Reallocate(Grow(Capacity(), old_size + size));
+            data = Data() + offset;
         }
         else
         {
-            impl.big.capacity = _size * 2;
-            buffer = impl.big.data = new char[impl.big.capacity];
+            Reallocate(Grow(Capacity(), old_size + size));
         }
-        
-        std::copy(data, data + size + 1, buffer); // + 1, т.к. на конце должен (\0)
     }
     
-    explicit String(const char* data) : String(data, strlen(data)) {}
+    std::memmove(Data() + old_size, data, size);
+    Set_Size(old_size + size);
+    return *this;
+}
+
+inline String& String::Append(std::string_view view)
+{
+    return Append(view.data(), view.size());
+}
+
+inline String& String::Append(std::size_t count, char ch)
+{
+    Resize(Size() + count, ch);
+    return *this;
+}
 
+inline void String::Push_Back(char ch)
+{
+    const std::size_t size = Size();
+    if (size == Capacity())
+        Reallocate(Grow(Capacity(), size + 1));
+    
+    Data()[size] = ch;
+    Set_Size(size + 1);
+}
+
+// < 0 - строка меньше view, 0 - равны, > 0 - больше
+inline int String::Compare(std::string_view view) const noexcept
+{
+    const std::size_t size = Size();
+    if (int result = std::memcmp(Data(), view.data(), std::min(size, view.size())))
+        return result;
     
-    ~String()
+    return size < view.size() ? -1 : (size > view.size() ? 1 : 0);
+}
+
+inline std::size_t String::Hash() const noexcept
+{
+    if (Is_SSO())
+        return std::hash<std::string_view>()(*this);
+    
+    std::atomic_ref<std::size_t> cache(Hash_Cache());
+    std::size_t hash = cache.load(std::memory_order_relaxed);
+    if (hash == 0)
     {
-        if (!Is_SSO())
-        {
-            delete[] impl.big.data;
-        }
+        hash = std::hash<std::string_view>()(*this);
+        cache.store(hash, std::memory_order_relaxed);
     }
+    return hash;
+}
+
+inline std::size_t String::Find(char ch, std::size_t position) const noexcept
+{
+    const std::size_t size = Size();
+    if (position >= size)
+        return npos;
+    
+    const std::size_t index = simd::Find(Data() + position, size - position, ch);
+    return index == npos ? npos : position + index;
+}
+
+inline std::size_t String::Find(std::string_view view, std::size_t position) const noexcept
+{
+    const std::size_t size = Size();
+    if (position > size)
+        return npos;
+    
+    const std::size_t index = simd::Find(Data() + position, size - position, view.data(), view.size());
+    return index == npos ? npos : position + index;
+}
+
+inline std::size_t String::RFind(char ch, std::size_t position) const noexcept
+{
+    const std::size_t size = Size();
+    if (size == 0)
+        return npos;
+    
+    return simd::RFind(Data(), std::min(position, size - 1) + 1, ch);
+}
+
+inline std::size_t String::RFind(std::string_view view, std::size_t position) const noexcept
+{
+    return simd::RFind(Data(), Size(), view.data(), view.size(), position);
+}
+
+inline std::string_view String::Substr(std::size_t position, std::size_t count) const
+{
+    const std::size_t size = Size();
+    if (position > size)
+        throw std::out_of_range("Position is out of range!");
+    
+    return std::string_view(Data() + position, std::min(count, size - position));
+}
+
+inline bool String::Validate_UTF8() const noexcept
+{
+    return utf8::Validate(Data(), Size());
+}
+
+inline std::size_t String::Length_Code_Points() const noexcept
+{
+    return utf8::Length(Data(), Size());
+}
+
+inline std::u16string String::To_UTF16() const
+{
+    std::u16string result(Size(), u'\0'); // Единиц UTF-16 не больше, чем байт UTF-8
+    const std::size_t size = utf8::To_UTF16(Data(), Size(), result.data());
+    if (size == utf8::npos)
+        throw std::runtime_error("Invalid UTF-8");
+    
+    result.resize(size);
+    return result;
+}
+
+inline std::u32string String::To_UTF32() const
+{
+    std::u32string result(Size(), U'\0');
+    const std::size_t size = utf8::To_UTF32(Data(), Size(), result.data());
+    if (size == utf8::npos)
+        throw std::runtime_error("Invalid UTF-8");
+    
+    result.resize(size);
+    return result;
+}
+
+inline String String::From_UTF16(std::u16string_view view)
+{
+    String result;
+    result.Reserve(view.size() * 3); // До 3 байт UTF-8 на единицу UTF-16
+    const std::size_t size = utf8::From_UTF16(view.data(), view.size(), result.Data());
+    if (size == utf8::npos)
+        throw std::runtime_error("Invalid UTF-16");
     
-    char* Data() noexcept
+    result.Set_Size(size);
+    return result;
+}
+
+inline String String::From_UTF32(std::u32string_view view)
+{
+    String result;
+    result.Reserve(view.size() * 4);
+    const std::size_t size = utf8::From_UTF32(view.data(), view.size(), result.Data());
+    if (size == utf8::npos)
+        throw std::runtime_error("Invalid UTF-32");
+    
+    result.Set_Size(size);
+    return result;
+}
+
+inline bool String::Is_SSO() const noexcept
+{
+    return !(impl.small.remaining & 0x80); // Старший бит последнего байта = старший бит big.capacity
+}
+
+inline void String::Set_Size(std::size_t size) noexcept
+{
+    if (Is_SSO())
     {
-        return Is_SSO() ? impl.small.data : impl.big.data;
+        impl.small.remaining = static_cast<unsigned char>(sso - size);
+        if (size < sso)
+            impl.small.data[size] = '\0'; // При size == 23 нуль-терминатором служит remaining == 0
     }
-    
-private:
-    bool Is_SSO() const noexcept
+    else
     {
-        return _size < sso;
+        impl.big.size = size;
+        impl.big.data[size] = '\0';
+        Reset_Hash();
+    }
+}
+
+// Перенос строки в новый буфер на capacity символов + (\0), маленькая строка становится большой
+inline void String::Reallocate(std::size_t capacity)
+{
+    const std::size_t size = Size();
+    char* buffer = Allocate(capacity);
+    std::memcpy(buffer, Data(), size + 1);
+    Destroy();
+    impl.big.data = buffer;
+    impl.big.size = size;
+    impl.big.capacity = capacity | big_flag;
+}
+
+inline void String::Destroy() noexcept
+{
+    if (!Is_SSO())
+        Deallocate(impl.big.data);
+}
+
+inline void String::Reset_Hash() noexcept
+{
+    std::atomic_ref<std::size_t>(Hash_Cache()).store(0, std::memory_order_relaxed);
+}
+
+// Кэш хэша большой строки лежит в буфере перед data
+inline std::size_t& String::Hash_Cache() const noexcept
+{
+    return *std::launder(reinterpret_cast<std::size_t*>(impl.big.data - sizeof(std::size_t)));
+}
+
+// Буфер на capacity символов + (\0) с кэшем хэша в начале, возвращает указатель на символы
+inline char* String::Allocate(std::size_t capacity)
+{
+    char* block = new char[sizeof(std::size_t) + capacity + 1]; // new char[] выровнен для любого типа, поэтому кэш выровнен
+    new (block) std::size_t(0);
+    return block + sizeof(std::size_t);
+}
+
+inline void String::Deallocate(char* data) noexcept
+{
+    delete[] (data - sizeof(std::size_t));
+}
+
+template <>
+struct std::hash<String>
+{
+    size_t operator()(const String& string) const noexcept
+    {
+        return string.Hash();
     }
-    
-private:
-    std::size_t _size = 0;
 };
 
 #endif /* String_h */
@@ -0,0 +1,255 @@
+#ifndef String_View_h
+#define String_View_h
+
+#include "Simd.h"
+#include "String.h"
+
+#include <bit>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <string_view>
+
+/*
+ String_View - невладеющая ссылка на диапазон символов: указатель + размер (16 байт), копирование и Substr без выделения памяти.
+ View действителен, пока жив и не изменяется исходный буфер (String, файл, отображенный в память и т.д.).
+ Поиск символов и подстрок выполняется через simd, как и в String.
+ */
+class String_View
+{
+public:
+    static constexpr size_t npos = simd::npos;
+    
+    constexpr String_View() noexcept = default;
+    constexpr String_View(const char* data, size_t size) noexcept : _data(data), _size(size) {}
+    String_View(const char* data) noexcept : String_View(data, std::strlen(data)) {}
+    String_View(const String& string) noexcept : String_View(string.Data(), string.Size()) {}
+    String_View(const std::string& string) noexcept : String_View(string.data(), string.size()) {}
+    constexpr String_View(std::string_view view) noexcept : String_View(view.data(), view.size()) {}
+    
+    constexpr const char& operator[](size_t index) const noexcept { return _data[index]; }
+    const char& At(size_t index) const
+    {
+        if (index >= _size)
+            throw std::out_of_range("Index is out of range!");
+        
+        return _data[index];
+    }
+    
+    constexpr const char* Data() const noexcept { return _data; }
+    constexpr size_t Size() const noexcept { return _size; }
+    constexpr bool Empty() const noexcept { return _size == 0; }
+    constexpr const char* Begin() const noexcept { return _data; }
+    constexpr const char* End() const noexcept { return _data + _size; }
+    constexpr char Front() const noexcept { return _data[0]; }
+    constexpr char Back() const noexcept { return _data[_size - 1]; }
+    
+    constexpr void Remove_Prefix(size_t count) noexcept { _data += count; _size -= count; }
+    constexpr void Remove_Suffix(size_t count) noexcept { _size -= count; }
+    
+    String_View Substr(size_t position, size_t count = npos) const
+    {
+        if (position > _size)
+            throw std::out_of_range("Position is out of range!");
+        
+        return String_View(_data + position, std::min(count, _size - position));
+    }
+    
+    size_t Find(char ch, size_t position = 0) const noexcept
+    {
+        if (position >= _size)
+            return npos;
+        
+        const size_t index = simd::Find(_data + position, _size - position, ch);
+        return index == npos ? npos : position + index;
+    }
+    
+    size_t Find(String_View view, size_t position = 0) const noexcept
+    {
+        if (position > _size)
+            return npos;
+        
+        const size_t index = simd::Find(_data + position, _size - position, view._data, view._size);
+        return index == npos ? npos : position + index;
+    }
+    
+    size_t RFind(char ch, size_t position = npos) const noexcept
+    {
+        if (_size == 0)
+            return npos;
+        
+        return simd::RFind(_data, std::min(position, _size - 1) + 1, ch);
+    }
+    
+    // Позиция первого символа из set или npos
+    size_t Find_First_Of(String_View set, size_t position = 0) const noexcept
+    {
+        if (position >= _size)
+            return npos;
+        
+        const size_t index = simd::Char_Set(set._data, set._size).Find(_data + position, _size - position);
+        return index == npos ? npos : position + index;
+    }
+    
+    bool Starts_With(String_View view) const noexcept { return _size >= view._size && std::memcmp(_data, view._data, view._size) == 0; }
+    bool Ends_With(String_View view) const noexcept { return _size >= view._size && std::memcmp(End() - view._size, view._data, view._size) == 0; }
+    
+    // < 0 - меньше view, 0 - равны, > 0 - больше
+    int Compare(String_View view) const noexcept
+    {
+        if (int result = std::memcmp(_data, view._data, std::min(_size, view._size)))
+            return result;
+        
+        return _size < view._size ? -1 : (_size > view._size ? 1 : 0);
+    }
+    
+    constexpr operator std::string_view() const noexcept { return std::string_view(_data, _size); }
+    
+    friend bool operator==(String_View lhs, String_View rhs) noexcept { return lhs._size == rhs._size && std::memcmp(lhs._data, rhs._data, lhs._size) == 0; }
+    friend bool operator!=(String_View lhs, String_View rhs) noexcept { return !(lhs == rhs); }
+    friend bool operator<(String_View lhs, String_View rhs) noexcept { return lhs.Compare(rhs) < 0; }
+    friend std::ostream& operator<<(std::ostream& os, String_View view) { return os.write(view._data, static_cast<std::streamsize>(view._size)); }
+
+private:
+    const char* _data = nullptr;
+    size_t _size = 0;
+};
+
+/*
+ Ленивый диапазон полей: следующий разделитель ищется только при переходе к следующему полю (operator++), поля - String_View в исходный буфер без выделения памяти.
+ Разделители ищутся через simd::Char_Set: 16/32 байта за сравнение, маска блока переиспользуется для всех полей внутри блока.
+ Split: пустые поля сохраняются ("a,,b" -> "a", "", "b"), как в CSV/TSV.
+ Tokenize: пустые поля пропускаются ("  a  b " -> "a", "b"), как при разборе по пробелам.
+ Диапазон должен жить, пока используются его итераторы (в range-based for временный объект живет до конца цикла).
+ */
+class Split_Range
+{
+public:
+    class Iterator
+    {
+        friend class Split_Range;
+    
+    public:
+        Iterator() = default;
+        
+        String_View operator*() const noexcept { return String_View(_begin, static_cast<size_t>(_end - _begin)); }
+        Iterator& operator++() { _range->Next(*this); return *this; }
+        bool operator==(const Iterator& other) const noexcept { return _done == other._done && (_done || _begin == other._begin); }
+        bool operator!=(const Iterator& other) const noexcept { return !(*this == other); }
+    
+    private:
+        const Split_Range* _range = nullptr;
+        const char* _begin = nullptr; // начало текущего поля
+        const char* _end = nullptr;   // конец текущего поля (позиция разделителя или конец текста)
+        const char* _block = nullptr; // блок, для которого вычислена маска разделителей
+        unsigned _mask = 0;           // маска разделителей блока _block
+        bool _done = true;
+    };
+    
+    Split_Range(String_View text, String_View delimiters, bool skip_empty) noexcept :
+    _text(text),
+    _delimiters(delimiters.Data(), delimiters.Size()),
+    _skip_empty(skip_empty)
+    {
+        
+    }
+    
+    Iterator Begin() const
+    {
+        Iterator it;
+        it._range = this;
+        it._done = false;
+        Find_Field(it, _text.Begin());
+        return it;
+    }
+    
+    Iterator End() const noexcept
+    {
+        return Iterator();
+    }
+    
+    // Для range-based for
+    Iterator begin() const { return Begin(); }
+    Iterator end() const noexcept { return End(); }
+
+private:
+    void Next(Iterator& it) const
+    {
+        if (it._end == _text.End())
+            it._done = true;
+        else
+            Find_Field(it, it._end + 1);
+    }
+    
+    /*
+     Позиция следующего разделителя, начиная с from, или конец текста.
+     Маска разделителей блока сохраняется в итераторе: короткие поля (несколько байт) берутся из одной маски по младшему установленному биту, и каждый блок сравнивается один раз, а не заново для каждого поля.
+     */
+    const char* Find_Delimiter(Iterator& it, const char* from) const
+    {
+        const char* text_end = _text.End();
+        while (true)
+        {
+            if (it._block && from < it._block + simd::width)
+            {
+                const unsigned mask = it._mask & (~0u << (from - it._block)); // Только разделители не раньше from
+                if (mask)
+                    return it._block + std::countr_zero(mask);
+                from = it._block + simd::width;
+            }
+            
+            if (static_cast<size_t>(text_end - from) < simd::width)
+                break;
+            it._block = from;
+            it._mask = _delimiters.Block_Mask(from);
+        }
+        
+        it._block = nullptr; // Хвост короче блока
+        const size_t index = _delimiters.Find(from, static_cast<size_t>(text_end - from));
+        return index == simd::npos ? text_end : from + index;
+    }
+    
+    // Поле, начинающееся с from, при skip_empty - первое непустое поле
+    void Find_Field(Iterator& it, const char* from) const
+    {
+        const char* text_end = _text.End();
+        while (true)
+        {
+            const char* end = Find_Delimiter(it, from);
+            if (!_skip_empty || end != from)
+            {
+                it._begin = from;
+                it._end = end;
+                return;
+            }
+            if (end == text_end)
+            {
+                it._done = true;
+                return;
+            }
+            from = end + 1;
+        }
+    }
+
+private:
+    String_View _text;
+    simd::Char_Set _delimiters;
+    bool _skip_empty = false;
+};
+
+inline Split_Range Split(String_View text, char delimiter)
+{
+    return Split_Range(text, String_View(&delimiter, 1), false);
+}
+
+inline Split_Range Split(String_View text, String_View delimiters)
+{
+    return Split_Range(text, delimiters, false);
+}
+
+inline Split_Range Tokenize(String_View text, String_View delimiters = " \t\r\n")
+{
+    return Split_Range(text, delimiters, true);
+}
+
+#endif /* String_View_h */
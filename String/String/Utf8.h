@@ -0,0 +1,551 @@
+#ifndef Utf8_h
+#define Utf8_h
+
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <iostream>
+
+#if defined(__AVX2__) || defined(__SSE2__) || defined(_M_X64)
+    #include <immintrin.h>
+#endif
+
+/*
+ UTF-8: символ (code point) кодируется 1-4 байтами:
+ - 0xxxxxxx - ASCII (U+0000..U+007F)
+ - 110xxxxx 10xxxxxx - U+0080..U+07FF (кириллица: 2 байта)
+ - 1110xxxx 10xxxxxx 10xxxxxx - U+0800..U+FFFF
+ - 11110xxx 10xxxxxx 10xxxxxx 10xxxxxx - U+10000..U+10FFFF (emoji)
+ Недопустимы: лишние/недостающие байты продолжения (10xxxxxx), overlong (кодирование длиннее необходимого: C0 80 вместо 00), суррогаты U+D800..U+DFFF, символы больше U+10FFFF.
+ Проверка (Validate):
+ - scalar: по байту, диапазоны второго байта по таблице 3-7 стандарта Unicode.
+ - AVX2: алгоритм Keiser-Lemire (simdjson/simdutf). Для каждого байта и предыдущего байта по 3 таблицам на 16 значений (старшие 4 бита предыдущего байта, младшие 4 бита предыдущего байта, старшие 4 бита текущего) через _mm256_shuffle_epi8 выбираются битовые маски возможных ошибок, их AND не равен 0 только при ошибке.
+   Длина 3- и 4-байтовых последовательностей проверяется отдельно по байтам за 2 и 3 позиции назад. Блок из одних ASCII пропускается после одной проверки movemask.
+ - SSE2 (без pshufb): блоки по 16 байт ASCII пропускаются, после не ASCII блока участок scalar_span байт проверяется scalar.
+ Транскодирование UTF-8 <-> UTF-16/UTF-32: блоки ASCII символов расширяются/сужаются SSE2 (unpack/pack), остальные блоки - scalar с проверкой. При ошибке возвращается npos.
+ */
+namespace utf8
+{
+    static constexpr size_t npos = static_cast<size_t>(-1);
+    
+    namespace scalar
+    {
+        /*
+         Длина корректной последовательности, начинающейся с data[0], или 0 при ошибке.
+         code_point - декодированный символ.
+         */
+        inline size_t Decode(const unsigned char* data, size_t size, char32_t& code_point) noexcept
+        {
+            const unsigned char byte = data[0];
+            if (byte < 0x80)
+            {
+                code_point = byte;
+                return 1;
+            }
+            
+            size_t length = 0;
+            unsigned char low = 0x80, high = 0xBF; // Допустимый диапазон второго байта
+            if (byte >= 0xC2 && byte <= 0xDF)
+            {
+                length = 2;
+                code_point = byte & 0x1F;
+            }
+            else if (byte >= 0xE0 && byte <= 0xEF)
+            {
+                length = 3;
+                code_point = byte & 0x0F;
+                if (byte == 0xE0)
+                    low = 0xA0; // overlong
+                else if (byte == 0xED)
+                    high = 0x9F; // суррогаты
+            }
+            else if (byte >= 0xF0 && byte <= 0xF4)
+            {
+                length = 4;
+                code_point = byte & 0x07;
+                if (byte == 0xF0)
+                    low = 0x90; // overlong
+                else if (byte == 0xF4)
+                    high = 0x8F; // больше U+10FFFF
+            }
+            else
+            {
+                return 0;
+            }
+            
+            if (length > size || data[1] < low || data[1] > high)
+                return 0;
+            
+            code_point = (code_point << 6) | (data[1] & 0x3F);
+            for (size_t i = 2; i < length; ++i)
+            {
+                if ((data[i] & 0xC0) != 0x80)
+                    return 0;
+                code_point = (code_point << 6) | (data[i] & 0x3F);
+            }
+            return length;
+        }
+        
+        // Запись символа в UTF-8, возвращает количество байт
+        inline size_t Encode(char32_t code_point, char* output) noexcept
+        {
+            if (code_point < 0x80)
+            {
+                output[0] = static_cast<char>(code_point);
+                return 1;
+            }
+            if (code_point < 0x800)
+            {
+                output[0] = static_cast<char>(0xC0 | (code_point >> 6));
+                output[1] = static_cast<char>(0x80 | (code_point & 0x3F));
+                return 2;
+            }
+            if (code_point < 0x10000)
+            {
+                output[0] = static_cast<char>(0xE0 | (code_point >> 12));
+                output[1] = static_cast<char>(0x80 | ((code_point >> 6) & 0x3F));
+                output[2] = static_cast<char>(0x80 | (code_point & 0x3F));
+                return 3;
+            }
+            output[0] = static_cast<char>(0xF0 | (code_point >> 18));
+            output[1] = static_cast<char>(0x80 | ((code_point >> 12) & 0x3F));
+            output[2] = static_cast<char>(0x80 | ((code_point >> 6) & 0x3F));
+            output[3] = static_cast<char>(0x80 | (code_point & 0x3F));
+            return 4;
+        }
+        
+        inline bool Validate(const char* data, size_t size) noexcept
+        {
+            const auto* bytes = reinterpret_cast<const unsigned char*>(data);
+            char32_t code_point = 0;
+            for (size_t i = 0; i < size;)
+            {
+                const size_t length = Decode(bytes + i, size - i, code_point);
+                if (length == 0)
+                    return false;
+                i += length;
+            }
+            return true;
+        }
+        
+        // Количество символов: все байты, кроме байтов продолжения 10xxxxxx
+        inline size_t Length(const char* data, size_t size) noexcept
+        {
+            size_t length = 0;
+            for (size_t i = 0; i < size; ++i)
+                length += (static_cast<unsigned char>(data[i]) & 0xC0) != 0x80;
+            return length;
+        }
+        
+        inline size_t To_UTF16(const char* data, size_t size, char16_t* output) noexcept
+        {
+            const auto* bytes = reinterpret_cast<const unsigned char*>(data);
+            char16_t* begin = output;
+            char32_t code_point = 0;
+            for (size_t i = 0; i < size;)
+            {
+                const size_t length = Decode(bytes + i, size - i, code_point);
+                if (length == 0)
+                    return npos;
+                i += length;
+                
+                if (code_point < 0x10000)
+                {
+                    *output++ = static_cast<char16_t>(code_point);
+                }
+                else
+                {
+                    code_point -= 0x10000; // Суррогатная пара: старшие и младшие 10 бит
+                    *output++ = static_cast<char16_t>(0xD800 | (code_point >> 10));
+                    *output++ = static_cast<char16_t>(0xDC00 | (code_point & 0x3FF));
+                }
+            }
+            return static_cast<size_t>(output - begin);
+        }
+        
+        inline size_t To_UTF32(const char* data, size_t size, char32_t* output) noexcept
+        {
+            const auto* bytes = reinterpret_cast<const unsigned char*>(data);
+            char32_t* begin = output;
+            for (size_t i = 0; i < size;)
+            {
+                const size_t length = Decode(bytes + i, size - i, *output++);
+                if (length == 0)
+                    return npos;
+                i += length;
+            }
+            return static_cast<size_t>(output - begin);
+        }
+        
+        // Декодирование символа UTF-16: возвращает количество единиц (1 или 2 для суррогатной пары) или 0 при ошибке
+        inline size_t Decode(const char16_t* data, size_t size, char32_t& code_point) noexcept
+        {
+            code_point = data[0];
+            if (code_point < 0xD800 || code_point > 0xDFFF)
+                return 1;
+            if (code_point > 0xDBFF || size < 2 || data[1] < 0xDC00 || data[1] > 0xDFFF)
+                return 0; // Одиночный суррогат
+            
+            code_point = 0x10000 + ((code_point - 0xD800) << 10) + (data[1] - 0xDC00);
+            return 2;
+        }
+        
+        inline size_t From_UTF16(const char16_t* data, size_t size, char* output) noexcept
+        {
+            char* begin = output;
+            char32_t code_point = 0;
+            for (size_t i = 0; i < size;)
+            {
+                const size_t length = Decode(data + i, size - i, code_point);
+                if (length == 0)
+                    return npos;
+                i += length;
+                output += Encode(code_point, output);
+            }
+            return static_cast<size_t>(output - begin);
+        }
+        
+        inline bool Is_Valid(char32_t code_point) noexcept
+        {
+            return code_point <= 0x10FFFF && (code_point < 0xD800 || code_point > 0xDFFF);
+        }
+        
+        inline size_t From_UTF32(const char32_t* data, size_t size, char* output) noexcept
+        {
+            char* begin = output;
+            for (size_t i = 0; i < size; ++i)
+            {
+                if (!Is_Valid(data[i]))
+                    return npos;
+                output += Encode(data[i], output);
+            }
+            return static_cast<size_t>(output - begin);
+        }
+    }
+    
+    /*
+     Конец участка для scalar обработки после не ASCII блока: scalar_span байт (за не ASCII текстом обычно следует не ASCII), граница сдвигается за байты продолжения, чтобы не разрезать символ.
+     */
+    static constexpr size_t scalar_span = 64;
+    
+    inline size_t Scalar_End(const char* data, size_t size, size_t i) noexcept
+    {
+        size_t end = std::min(i + scalar_span, size);
+        while (end < size && (static_cast<unsigned char>(data[end]) & 0xC0) == 0x80)
+            ++end;
+        return end;
+    }
+
+#if defined(__AVX2__)
+    namespace avx2
+    {
+        // Биты ошибок Keiser-Lemire: у каждой таблицы установлены биты ошибок, возможных для данного значения полубайта
+        static constexpr char too_short = 1 << 0;      // лидирующий байт, за которым не байт продолжения
+        static constexpr char too_long = 1 << 1;       // байт продолжения после ASCII
+        static constexpr char overlong_3 = 1 << 2;
+        static constexpr char too_large = 1 << 3;
+        static constexpr char surrogate = 1 << 4;
+        static constexpr char overlong_2 = 1 << 5;
+        static constexpr char too_large_1000 = 1 << 6;
+        static constexpr char overlong_4 = 1 << 6;
+        static constexpr char two_conts = static_cast<char>(1 << 7); // два байта продолжения подряд (допустимо только в 3-4 байтовых последовательностях)
+        static constexpr char carry = too_short | too_long | two_conts;
+        
+        inline __m256i Table(char t0, char t1, char t2, char t3, char t4, char t5, char t6, char t7,
+                             char t8, char t9, char t10, char t11, char t12, char t13, char t14, char t15) noexcept
+        {
+            return _mm256_setr_epi8(t0, t1, t2, t3, t4, t5, t6, t7, t8, t9, t10, t11, t12, t13, t14, t15,
+                                    t0, t1, t2, t3, t4, t5, t6, t7, t8, t9, t10, t11, t12, t13, t14, t15);
+        }
+        
+        inline __m256i High_Nibble(__m256i value) noexcept
+        {
+            return _mm256_and_si256(_mm256_srli_epi16(value, 4), _mm256_set1_epi8(0x0F));
+        }
+        
+        // Байты, сдвинутые на N позиций назад: первые N байт берутся из конца предыдущего блока
+        template <int N>
+        inline __m256i Previous(__m256i input, __m256i previous_input) noexcept
+        {
+            return _mm256_alignr_epi8(input, _mm256_permute2x128_si256(previous_input, input, 0x21), 16 - N);
+        }
+        
+        // Ошибки пар (предыдущий байт, текущий байт)
+        inline __m256i Special_Cases(__m256i input, __m256i previous1) noexcept
+        {
+            const __m256i byte_1_high = _mm256_shuffle_epi8(Table(
+                too_long, too_long, too_long, too_long, too_long, too_long, too_long, too_long, // 0_______ ASCII
+                two_conts, two_conts, two_conts, two_conts,                                     // 10______ продолжение
+                too_short | overlong_2,                                                         // 1100____
+                too_short,                                                                      // 1101____
+                too_short | overlong_3 | surrogate,                                             // 1110____
+                too_short | too_large | too_large_1000 | overlong_4                             // 1111____
+            ), High_Nibble(previous1));
+            
+            const __m256i byte_1_low = _mm256_shuffle_epi8(Table(
+                carry | overlong_3 | overlong_2 | overlong_4, // ____0000
+                carry | overlong_2,                           // ____0001
+                carry, carry,                                 // ____001_
+                carry | too_large,                            // ____0100
+                carry | too_large | too_large_1000,           // ____0101
+                carry | too_large | too_large_1000,           // ____011_
+                carry | too_large | too_large_1000,
+                carry | too_large | too_large_1000,           // ____1___
+                carry | too_large | too_large_1000,
+                carry | too_large | too_large_1000,
+                carry | too_large | too_large_1000,
+                carry | too_large | too_large_1000,
+                carry | too_large | too_large_1000 | surrogate, // ____1101
+                carry | too_large | too_large_1000,
+                carry | too_large | too_large_1000
+            ), _mm256_and_si256(previous1, _mm256_set1_epi8(0x0F)));
+            
+            const __m256i byte_2_high = _mm256_shuffle_epi8(Table(
+                too_short, too_short, too_short, too_short, too_short, too_short, too_short, too_short,  // 0_______ ASCII
+                too_long | overlong_2 | two_conts | overlong_3 | too_large_1000 | overlong_4,            // 1000____
+                too_long | overlong_2 | two_conts | overlong_3 | too_large,                              // 1001____
+                too_long | overlong_2 | two_conts | surrogate | too_large,                               // 101_____
+                too_long | overlong_2 | two_conts | surrogate | too_large,
+                too_short, too_short, too_short, too_short                                               // 11______
+            ), High_Nibble(input));
+            
+            return _mm256_and_si256(_mm256_and_si256(byte_1_high, byte_1_low), byte_2_high);
+        }
+        
+        // Байт продолжения обязан быть там, где за 2 позиции до него 3-байтовый лидер или за 3 позиции - 4-байтовый лидер
+        inline __m256i Multibyte_Lengths(__m256i input, __m256i previous_input, __m256i special_cases) noexcept
+        {
+            const __m256i previous2 = Previous<2>(input, previous_input);
+            const __m256i previous3 = Previous<3>(input, previous_input);
+            const __m256i third_byte = _mm256_subs_epu8(previous2, _mm256_set1_epi8(static_cast<char>(0xE0 - 0x80))); // >= 0x80 только для 111_____
+            const __m256i fourth_byte = _mm256_subs_epu8(previous3, _mm256_set1_epi8(static_cast<char>(0xF0 - 0x80))); // >= 0x80 только для 1111____
+            const __m256i must_be_continuation = _mm256_and_si256(_mm256_or_si256(third_byte, fourth_byte), _mm256_set1_epi8(static_cast<char>(0x80)));
+            return _mm256_xor_si256(must_be_continuation, special_cases);
+        }
+        
+        // Незавершенная последовательность в конце блока: лидирующий байт в последних 1-3 позициях
+        inline __m256i Incomplete(__m256i input) noexcept
+        {
+            const __m256i max_value = _mm256_setr_epi8(
+                -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+                -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+                static_cast<char>(0xF0 - 1), static_cast<char>(0xE0 - 1), static_cast<char>(0xC0 - 1));
+            return _mm256_subs_epu8(input, max_value);
+        }
+        
+        inline bool Validate(const char* data, size_t size) noexcept
+        {
+            __m256i error = _mm256_setzero_si256();
+            __m256i previous_input = _mm256_setzero_si256();
+            __m256i previous_incomplete = _mm256_setzero_si256();
+            auto Check = [&](__m256i input)
+            {
+                if (_mm256_movemask_epi8(input) == 0) // Только ASCII
+                {
+                    error = _mm256_or_si256(error, previous_incomplete);
+                    previous_incomplete = _mm256_setzero_si256();
+                }
+                else
+                {
+                    const __m256i special_cases = Special_Cases(input, Previous<1>(input, previous_input));
+                    error = _mm256_or_si256(error, Multibyte_Lengths(input, previous_input, special_cases));
+                    previous_incomplete = Incomplete(input);
+                }
+                previous_input = input;
+            };
+            
+            size_t i = 0;
+            for (; i + 32 <= size; i += 32)
+                Check(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i)));
+            
+            if (i < size)
+            {
+                char tail[32] = {}; // Хвост дополняется нулями (ASCII)
+                std::memcpy(tail, data + i, size - i);
+                Check(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(tail)));
+            }
+            
+            error = _mm256_or_si256(error, previous_incomplete);
+            return _mm256_testz_si256(error, error);
+        }
+    }
+#endif
+    
+    inline bool Validate(const char* data, size_t size) noexcept
+    {
+#if defined(__AVX2__)
+        return avx2::Validate(data, size);
+#elif defined(__SSE2__) || defined(_M_X64)
+        // Блоки ASCII пропускаются, участки с не ASCII проверяются scalar
+        size_t i = 0;
+        while (i + 16 <= size)
+        {
+            if (_mm_movemask_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i))) == 0)
+            {
+                i += 16;
+                continue;
+            }
+            
+            const size_t end = Scalar_End(data, size, i);
+            if (!scalar::Validate(data + i, end - i))
+                return false;
+            i = end;
+        }
+        return scalar::Validate(data + i, size - i);
+#else
+        return scalar::Validate(data, size);
+#endif
+    }
+    
+    // Количество символов (code points) в корректной UTF-8 строке
+    inline size_t Length(const char* data, size_t size) noexcept
+    {
+        size_t continuations = 0, i = 0;
+#if defined(__AVX2__)
+        const __m256i threshold = _mm256_set1_epi8(-64); // Байт продолжения 0x80..0xBF как int8_t: -128..-65
+        for (; i + 32 <= size; i += 32)
+        {
+            const __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+            continuations += static_cast<size_t>(std::popcount(static_cast<unsigned>(_mm256_movemask_epi8(_mm256_cmpgt_epi8(threshold, block)))));
+        }
+#elif defined(__SSE2__) || defined(_M_X64)
+        const __m128i threshold = _mm_set1_epi8(-64);
+        for (; i + 16 <= size; i += 16)
+        {
+            const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+            continuations += static_cast<size_t>(std::popcount(static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpgt_epi8(threshold, block)))));
+        }
+#endif
+        return i - continuations + scalar::Length(data + i, size - i);
+    }
+    
+    /*
+     Транскодирование: блоки ASCII обрабатываются SSE2, после не ASCII блока участок scalar_span байт - scalar.
+     Размер output: To_UTF16/To_UTF32 - не меньше size, From_UTF16 - 3 * size, From_UTF32 - 4 * size.
+     Возвращает количество записанных единиц или npos, если вход некорректен.
+     */
+    inline size_t To_UTF16(const char* data, size_t size, char16_t* output) noexcept
+    {
+        size_t i = 0, written = 0;
+#if defined(__SSE2__) || defined(_M_X64)
+        const __m128i zero = _mm_setzero_si128();
+        while (i + 16 <= size)
+        {
+            const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+            if (_mm_movemask_epi8(block) == 0) // ASCII: расширение байт до 16 бит
+            {
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(output + written), _mm_unpacklo_epi8(block, zero));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(output + written + 8), _mm_unpackhi_epi8(block, zero));
+                i += 16;
+                written += 16;
+                continue;
+            }
+            
+            const size_t end = Scalar_End(data, size, i);
+            const size_t units = scalar::To_UTF16(data + i, end - i, output + written);
+            if (units == npos)
+                return npos;
+            i = end;
+            written += units;
+        }
+#endif
+        const size_t tail = scalar::To_UTF16(data + i, size - i, output + written);
+        return tail == npos ? npos : written + tail;
+    }
+    
+    inline size_t To_UTF32(const char* data, size_t size, char32_t* output) noexcept
+    {
+        size_t i = 0, written = 0;
+#if defined(__SSE2__) || defined(_M_X64)
+        const __m128i zero = _mm_setzero_si128();
+        while (i + 16 <= size)
+        {
+            const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+            if (_mm_movemask_epi8(block) == 0) // ASCII: расширение байт до 32 бит
+            {
+                const __m128i low = _mm_unpacklo_epi8(block, zero);
+                const __m128i high = _mm_unpackhi_epi8(block, zero);
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(output + written), _mm_unpacklo_epi16(low, zero));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(output + written + 4), _mm_unpackhi_epi16(low, zero));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(output + written + 8), _mm_unpacklo_epi16(high, zero));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(output + written + 12), _mm_unpackhi_epi16(high, zero));
+                i += 16;
+                written += 16;
+                continue;
+            }
+            
+            const size_t end = Scalar_End(data, size, i);
+            const size_t units = scalar::To_UTF32(data + i, end - i, output + written);
+            if (units == npos)
+                return npos;
+            i = end;
+            written += units;
+        }
+#endif
+        const size_t tail = scalar::To_UTF32(data + i, size - i, output + written);
+        return tail == npos ? npos : written + tail;
+    }
+    
+    inline size_t From_UTF16(const char16_t* data, size_t size, char* output) noexcept
+    {
+        size_t i = 0, written = 0;
+#if defined(__SSE2__) || defined(_M_X64)
+        const __m128i ascii_mask = _mm_set1_epi16(static_cast<short>(0xFF80));
+        const __m128i zero = _mm_setzero_si128();
+        while (i + 8 <= size)
+        {
+            const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+            if (_mm_movemask_epi8(_mm_cmpeq_epi16(_mm_and_si128(block, ascii_mask), zero)) == 0xFFFF) // ASCII: сужение 16 бит до байт
+            {
+                _mm_storel_epi64(reinterpret_cast<__m128i*>(output + written), _mm_packus_epi16(block, block));
+                i += 8;
+                written += 8;
+                continue;
+            }
+            
+            for (const size_t end = i + 8; i < end;)
+            {
+                char32_t code_point = 0;
+                const size_t length = scalar::Decode(data + i, size - i, code_point);
+                if (length == 0)
+                    return npos;
+                i += length;
+                written += scalar::Encode(code_point, output + written);
+            }
+        }
+#endif
+        const size_t tail = scalar::From_UTF16(data + i, size - i, output + written);
+        return tail == npos ? npos : written + tail;
+    }
+    
+    inline size_t From_UTF32(const char32_t* data, size_t size, char* output) noexcept
+    {
+        size_t i = 0, written = 0;
+#if defined(__SSE2__) || defined(_M_X64)
+        const __m128i ascii_mask = _mm_set1_epi32(static_cast<int>(0xFFFFFF80));
+        const __m128i zero = _mm_setzero_si128();
+        for (; i + 4 <= size; i += 4)
+        {
+            const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+            if (_mm_movemask_epi8(_mm_cmpeq_epi32(_mm_and_si128(block, ascii_mask), zero)) == 0xFFFF) // ASCII: сужение 32 бит до байт
+            {
+                const int bytes = _mm_cvtsi128_si32(_mm_packus_epi16(_mm_packs_epi32(block, block), zero));
+                std::memcpy(output + written, &bytes, 4);
+                written += 4;
+                continue;
+            }
+            
+            for (size_t j = i; j < i + 4; ++j)
+            {
+                if (!scalar::Is_Valid(data[j]))
+                    return npos;
+                written += scalar::Encode(data[j], output + written);
+            }
+        }
+#endif
+        const size_t tail = scalar::From_UTF32(data + i, size - i, output + written);
+        return tail == npos ? npos : written + tail;
+    }
+}
+
+#endif /* Utf8_h */
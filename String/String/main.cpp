@@ -1,7 +1,18 @@
 #include "String.h"
 #include "Custom_String.h"
+#include "Fixed_String.h"
+#include "Interned_String.h"
+#include "Rope.h"
+#include "String_View.h"
+#include "Timer.h"
+#include "Unordered_Map.h"
 
 #include <string>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+    #include <sys/uio.h>
+#endif
 
 /*
  Сайты: https://habr.com/ru/companies/oleg-bunin/articles/352280/
@@ -10,6 +21,53 @@
         https://github.com/robhz786/api_string/blob/master/include/string.hpp
 */
 
+// Разбор журнала: поиск полей, вырезание значений и сборка результата
+template <class StringType>
+size_t Parse_Log(const std::vector<std::string>& lines)
+{
+    size_t errors = 0;
+    StringType result;
+    for (const auto& line : lines)
+    {
+        StringType string(line.data(), line.size()); // Копия строки, как при чтении из файла
+        if (string.find("[ERROR]") != StringType::npos)
+            ++errors;
+        
+        const size_t user = string.find("user=");
+        const size_t latency = string.rfind("latency=");
+        if (user == StringType::npos || latency == StringType::npos)
+            continue;
+        
+        const size_t end = string.find(' ', user);
+        result += std::string_view(string).substr(user + 5, end - user - 5);
+        result += ':';
+        result += std::string_view(string).substr(latency + 8);
+        result += ';';
+    }
+    return errors + result.size();
+}
+
+// Хэш String для Unordered_Map: по всем символам строки
+struct String_Hash
+{
+    size_t operator()(const String& string) const noexcept
+    {
+        return std::hash<std::string_view>()(string);
+    }
+};
+
+// Адаптер String к интерфейсу std::string для общего шаблона
+struct String_Adapter : String
+{
+    using String::String;
+    static constexpr size_t npos = String::npos;
+    size_t find(std::string_view view, size_t position = 0) const noexcept { return Find(view, position); }
+    size_t find(char ch, size_t position = 0) const noexcept { return Find(ch, position); }
+    size_t rfind(std::string_view view) const noexcept { return RFind(view); }
+    size_t size() const noexcept { return Size(); }
+    String_Adapter& operator+=(std::string_view view) { Append(view); return *this; }
+    String_Adapter& operator+=(char ch) { Push_Back(ch); return *this; }
+};
 
 int main()
 {
@@ -38,5 +96,362 @@ int main()
     std::cout << "string2: " << sizeof(string2) << std::endl;
     std::cout << "custom_string1: " << sizeof(custom_string1) << std::endl;
     std::cout << "custom_string2: " << sizeof(custom_string2) << std::endl;
+    std::cout << std::endl;
+    
+    // String
+    {
+        String string("small");
+        String big("string longer than twenty three characters");
+        string += ", ";
+        string += big; // Переход с SSO на кучу
+        string.Push_Back('!');
+        string.Append(string.Substr(0, 5)); // Добавление части самой себя
+        String copy = string;
+        String move = std::move(copy);
+        std::cout << "String: " << move << ", size: " << move.Size() << ", capacity: " << move.Capacity() << std::endl;
+        std::cout << "Find(\"twenty\"): " << move.Find("twenty") << ", RFind('s'): " << move.RFind('s') << ", Substr(7, 6): " << move.Substr(7, 6) << std::endl;
+        std::cout << "Compare: " << (String("abc") < "abd") << " " << (String("abc") == "abc") << std::endl;
+    }
+    
+    // Benchmark
+    {
+        static constexpr size_t lines_count = 200000;
+        static constexpr size_t repeats = 5;
+        
+        const char* levels[] = {"INFO", "WARNING", "ERROR"};
+        std::vector<std::string> lines;
+        lines.reserve(lines_count);
+        for (size_t i = 0; i < lines_count; ++i)
+        {
+            lines.push_back("2024-01-01 12:00:" + std::to_string(i % 60) + " [" + levels[i % 3] + "] request_id=" + std::to_string(i) +
+                            " user=user" + std::to_string(i % 1000) + " action=login latency=" + std::to_string(i % 500) + "ms");
+        }
+        
+        Timer timer;
+        size_t result1 = 0, result2 = 0;
+        timer.start();
+        for (size_t i = 0; i < repeats; ++i)
+            result1 += Parse_Log<std::string>(lines);
+        timer.stop();
+        std::cout << "std::string: " << timer.elapsedMilliseconds() << " ms" << std::endl;
+        
+        timer.start();
+        for (size_t i = 0; i < repeats; ++i)
+            result2 += Parse_Log<String_Adapter>(lines);
+        timer.stop();
+        std::cout << "String: " << timer.elapsedMilliseconds() << " ms, equal: " << (result1 == result2) << std::endl;
+    }
+    // Interned_String
+    {
+        static constexpr size_t keys_count = 1000000;
+        static constexpr size_t unique_count = 1000;
+        
+        std::vector<std::string> routes;
+        for (size_t i = 0; i < unique_count; ++i)
+            routes.push_back("/api/v1/service" + std::to_string(i % 10) + "/endpoint" + std::to_string(i) + "/metrics");
+        
+        // Память: каждая копия std::string хранит свой буфер, Interned_String - указатель на общую запись пула
+        std::vector<std::string> strings;
+        std::vector<Interned_String> interned;
+        strings.reserve(keys_count);
+        interned.reserve(keys_count);
+        size_t strings_bytes = 0;
+        for (size_t i = 0; i < keys_count; ++i)
+        {
+            strings.push_back(routes[i % unique_count]);
+            interned.emplace_back(routes[i % unique_count]);
+            strings_bytes += sizeof(std::string) + strings.back().capacity() + 1;
+        }
+        auto [pool_count, pool_bytes] = Interned_String::Pool_Statistics();
+        std::cout << "std::string: " << strings_bytes / 1024 << " KB" << std::endl;
+        std::cout << "Interned_String: " << (keys_count * sizeof(Interned_String) + pool_bytes) / 1024 << " KB, unique: " << pool_count << std::endl;
+        std::cout << "equal: " << (interned[0] == interned[unique_count]) << ", hash: " << (interned[0].Hash() == std::hash<Interned_String>()(interned[unique_count])) << std::endl;
+        
+        // Поиск в Unordered_Map: у std::string хэш вычисляется по всем символам и ключи сравниваются посимвольно
+        Unordered_Map<std::string, size_t> strings_map;
+        Unordered_Map<Interned_String, size_t> interned_map;
+        for (size_t i = 0; i < unique_count; ++i)
+        {
+            strings_map.Emplace(routes[i], i);
+            interned_map.Emplace(interned[i], i);
+        }
+        
+        Timer timer;
+        size_t sum1 = 0, sum2 = 0;
+        timer.start();
+        for (const auto& key : strings)
+            sum1 += strings_map.Find(key)->second;
+        timer.stop();
+        std::cout << "Unordered_Map<std::string>::Find: " << timer.elapsedMilliseconds() << " ms" << std::endl;
+        
+        timer.start();
+        for (const auto& key : interned)
+            sum2 += interned_map.Find(key)->second;
+        timer.stop();
+        std::cout << "Unordered_Map<Interned_String>::Find: " << timer.elapsedMilliseconds() << " ms, equal: " << (sum1 == sum2) << std::endl;
+        
+        [[maybe_unused]] auto missing = Interned_String::Lookup("/not/interned");
+        std::cout << "Lookup: " << missing.Empty() << std::endl;
+        std::cout << "empty equal: " << (Interned_String("") == Interned_String()) << ", hash: " << (Interned_String("").Hash() == Interned_String().Hash()) << std::endl;
+    }
+    
+    // Rope
+    {
+        Rope rope("Hello world");
+        rope.Insert(5, ",");
+        rope.Append("!");
+        rope.Erase(0, 1);
+        rope.Insert(0, "h");
+        Rope world = rope.Substr(7, 5); // Без копирования текста: общие листья
+        std::cout << "Rope: " << rope.To_String() << ", Substr: " << world.To_String() << ", Concat: " << Rope::Concat(rope, world).To_String() << std::endl;
+        
+#if defined(__unix__) || defined(__APPLE__)
+        // Куски Rope без копирования передаются в writev одним системным вызовом
+        std::vector<iovec> buffers;
+        for (auto it = rope.Begin(); it != rope.End(); ++it)
+            buffers.push_back(iovec{const_cast<char*>((*it).data()), (*it).size()});
+        buffers.push_back(iovec{const_cast<char*>("\n"), 1});
+        std::cout.flush();
+        [[maybe_unused]] auto written = writev(1, buffers.data(), static_cast<int>(buffers.size()));
+#endif
+        
+        // Шаблонизатор: тысячи вставок и удалений в середину большого ответа
+        static constexpr size_t text_size = 4 * 1024 * 1024;
+        static constexpr size_t splices = 20000;
+        
+        const std::string text(text_size, 'x');
+        const std::string fragment = "<div class=\"item\">{{value}}</div>";
+        std::vector<size_t> positions;
+        for (size_t i = 0, position = 0; i < splices; ++i)
+        {
+            position = (position * 1103515245 + 12345) % text_size;
+            positions.push_back(position);
+        }
+        
+        Timer timer;
+        std::string string = text;
+        timer.start();
+        for (size_t i = 0; i < splices; ++i)
+        {
+            string.insert(positions[i], fragment); // Сдвиг хвоста: O(N)
+            if (i % 4 == 0)
+                string.erase(positions[i] / 2, 16);
+        }
+        timer.stop();
+        std::cout << "std::string splices: " << timer.elapsedMilliseconds() << " ms" << std::endl;
+        
+        Rope large(text);
+        timer.start();
+        for (size_t i = 0; i < splices; ++i)
+        {
+            large.Insert(positions[i], fragment); // O(log(N))
+            if (i % 4 == 0)
+                large.Erase(positions[i] / 2, 16);
+        }
+        timer.stop();
+        std::cout << "Rope splices: " << timer.elapsedMilliseconds() << " ms, equal: " << (large.To_String() == string) << std::endl;
+    }
+    
+    // String_View: разбор CSV без выделения памяти
+    {
+        for (String_View field : Split("a,,b,", ','))
+            std::cout << "[" << field << "]";
+        std::cout << std::endl;
+        for (String_View token : Tokenize("  to be,\tor  not "))
+            std::cout << "[" << token << "]";
+        std::cout << std::endl;
+        
+        // Файл CSV в памяти (как после mmap): строки по 8 полей
+        static constexpr size_t csv_size = 128 * 1024 * 1024;
+        std::string csv;
+        csv.reserve(csv_size + 128);
+        for (size_t row = 0; csv.size() < csv_size; ++row)
+        {
+            csv += std::to_string(row);
+            csv += ",AAPL,189.25,";
+            csv += std::to_string(row * 7 % 1000);
+            csv += ",NASDAQ,,buy,2024-01-15T10:30:00Z\n";
+        }
+        const double gigabytes = static_cast<double>(csv.size()) / 1e9;
+        
+        Timer timer;
+        size_t fields = 0, bytes = 0;
+        timer.start();
+        for (size_t begin = 0; begin < csv.size();)
+        {
+            size_t end = csv.find('\n', begin);
+            if (end == std::string::npos)
+                end = csv.size();
+            const std::string line = csv.substr(begin, end - begin); // Копия строки и копия каждого поля
+            for (size_t field_begin = 0;;)
+            {
+                const size_t field_end = line.find(',', field_begin);
+                const std::string field = line.substr(field_begin, field_end == std::string::npos ? std::string::npos : field_end - field_begin);
+                ++fields;
+                bytes += field.size();
+                if (field_end == std::string::npos)
+                    break;
+                field_begin = field_end + 1;
+            }
+            begin = end + 1;
+        }
+        timer.stop();
+        std::cout << "std::string find + substr: " << gigabytes / (timer.elapsedMilliseconds() / 1000) << " GB/s, fields: " << fields << ", bytes: " << bytes << std::endl;
+        
+        fields = 0, bytes = 0;
+        timer.start();
+        for (String_View line : Tokenize(csv, "\n"))
+        {
+            for (String_View field : Split(line, ','))
+            {
+                ++fields;
+                bytes += field.Size();
+            }
+        }
+        timer.stop();
+        std::cout << "String_View Split: " << gigabytes / (timer.elapsedMilliseconds() / 1000) << " GB/s, fields: " << fields << ", bytes: " << bytes << std::endl;
+        
+        fields = 0, bytes = 0;
+        timer.start();
+        for (String_View field : Split(csv, ",\n")) // Один проход по множеству разделителей
+        {
+            ++fields;
+            bytes += field.Size();
+        }
+        timer.stop();
+        std::cout << "String_View Split by set: " << gigabytes / (timer.elapsedMilliseconds() / 1000) << " GB/s, fields: " << fields - 1 << ", bytes: " << bytes << std::endl; // -1: пустое поле после последнего \n
+    }
+    
+    // UTF-8: проверка и транскодирование
+    {
+        const String russian("Строка в кодировке UTF-8 😀");
+        std::cout << "Validate_UTF8: " << russian.Validate_UTF8() << ", bytes: " << russian.Size() << ", code points: " << russian.Length_Code_Points() << std::endl;
+        std::cout << "UTF-16 units: " << russian.To_UTF16().size() << ", back: " << String::From_UTF32(russian.To_UTF32()) << std::endl;
+        std::cout << "Invalid: " << String("\xD0\x9F\xD1").Validate_UTF8() << String("\xC0\x80").Validate_UTF8() << String("\xED\xA0\x80").Validate_UTF8() << std::endl;
+        
+        static constexpr size_t text_size = 64 * 1024 * 1024;
+        const std::pair<const char*, std::string_view> inputs[] =
+        {
+            {"ASCII", "2024-01-15 10:30:00 [INFO] request_id=42 user=alice path=/api/v1/orders latency=12ms\n"},
+            {"Cyrillic", "Проверка корректности строки выполняется до сохранения в String, комментарии проекта на русском.\n"},
+            {"Mixed", "user=alice сообщение: заказ №42 выполнен 😀 latency=12ms, статус=OK ✓\n"}
+        };
+        
+        for (const auto& [name, line] : inputs)
+        {
+            String text;
+            text.Reserve(text_size);
+            while (text.Size() + line.size() <= text_size)
+                text.Append(line);
+            const double gigabytes = static_cast<double>(text.Size()) / 1e9;
+            
+            Timer timer;
+            timer.start();
+            const bool scalar_valid = utf8::scalar::Validate(text.Data(), text.Size());
+            timer.stop();
+            const double scalar_validate = gigabytes / (timer.elapsedMilliseconds() / 1000);
+            
+            timer.start();
+            const bool valid = text.Validate_UTF8();
+            timer.stop();
+            const double simd_validate = gigabytes / (timer.elapsedMilliseconds() / 1000);
+            
+            std::u16string utf16(text.Size(), u'\0');
+            timer.start();
+            const size_t scalar_units = utf8::scalar::To_UTF16(text.Data(), text.Size(), utf16.data());
+            timer.stop();
+            const double scalar_transcode = gigabytes / (timer.elapsedMilliseconds() / 1000);
+            
+            timer.start();
+            const size_t units = utf8::To_UTF16(text.Data(), text.Size(), utf16.data());
+            timer.stop();
+            const double simd_transcode = gigabytes / (timer.elapsedMilliseconds() / 1000);
+            
+            std::cout << name << ": Validate scalar " << scalar_validate << " GB/s, simd " << simd_validate << " GB/s; To_UTF16 scalar " << scalar_transcode << " GB/s, simd " << simd_transcode << " GB/s; check: " << (scalar_valid == valid && scalar_units == units) << std::endl;
+        }
+    }
+    
+    // Fixed_String: короткие ключи без выделения памяти
+    {
+        static_assert(sizeof(Fixed_String<15>) == 16 && std::is_trivially_copyable_v<Fixed_String<15>>);
+        constexpr Fixed_String ticker = "AAPL"; // Fixed_String<4>, создан при компиляции
+        static_assert(ticker.Size() == 4 && ticker == Fixed_String("AAPL"));
+        std::cout << "Fixed_String: " << ticker << ", sizeof: " << sizeof(ticker) << ", sizeof(Fixed_String<15>): " << sizeof(Fixed_String<15>) << ", sizeof(String): " << sizeof(String) << std::endl;
+        
+        static constexpr size_t tickers_count = 5000;
+        static constexpr size_t lookups = 4000000;
+        
+        std::vector<std::string> tickers;
+        for (size_t i = 0; i < tickers_count; ++i)
+            tickers.push_back("TCK" + std::to_string(i) + (i % 2 ? ".US" : ".L"));
+        
+        Unordered_Map<String, size_t, String_Hash> strings_map;
+        Unordered_Map<Fixed_String<15>, size_t> fixed_map;
+        std::vector<String> string_keys;
+        std::vector<Fixed_String<15>> fixed_keys;
+        for (size_t i = 0; i < tickers_count; ++i)
+        {
+            string_keys.emplace_back(tickers[i]);
+            fixed_keys.emplace_back(tickers[i]);
+            strings_map.Emplace(string_keys.back(), i);
+            fixed_map.Emplace(fixed_keys.back(), i);
+        }
+        
+        Timer timer;
+        size_t sum1 = 0, sum2 = 0;
+        timer.start();
+        for (size_t i = 0; i < lookups; ++i)
+            sum1 += strings_map.Find(string_keys[(i * 7919) % tickers_count])->second;
+        timer.stop();
+        std::cout << "Unordered_Map<String>::Find: " << timer.elapsedMilliseconds() << " ms" << std::endl;
+        
+        timer.start();
+        for (size_t i = 0; i < lookups; ++i)
+            sum2 += fixed_map.Find(fixed_keys[(i * 7919) % tickers_count])->second;
+        timer.stop();
+        std::cout << "Unordered_Map<Fixed_String<15>>::Find: " << timer.elapsedMilliseconds() << " ms, equal: " << (sum1 == sum2) << std::endl;
+    }
+    
+    // Кэш хэша: длинные ключи (URL, пути) 64-256 байт
+    {
+        static constexpr size_t keys_count = 20000;
+        static constexpr size_t lookups = 2000000;
+        
+        std::vector<String> keys;
+        for (size_t i = 0; i < keys_count; ++i)
+        {
+            std::string url = "https://example.com/api/v2/users/" + std::to_string(i) + "/orders?sort=date&filter=";
+            url.append(32 + (i * 37) % 160, static_cast<char>('a' + i % 26)); // 64-256 байт
+            keys.emplace_back(url);
+        }
+        
+        auto Run = [&keys](auto& map, const char* name)
+        {
+            Timer timer;
+            timer.start();
+            for (size_t i = 0; i < keys_count; ++i)
+                map.Emplace(keys[i], i); // Rehash при росте использует сохраненные в узлах хэши
+            timer.stop();
+            const double insert = timer.elapsedMilliseconds();
+            
+            size_t sum = 0;
+            timer.start();
+            for (size_t i = 0; i < lookups; ++i)
+                sum += map.Find(keys[(i * 7919) % keys_count])->second;
+            timer.stop();
+            std::cout << name << ": Emplace " << insert << " ms, Find " << timer.elapsedMilliseconds() << " ms, sum: " << sum << std::endl;
+        };
+        
+        Unordered_Map<String, size_t, String_Hash> hash_every_time; // Хэш по всем символам при каждом поиске
+        Unordered_Map<String, size_t> cached_hash; // std::hash<String>: хэш большой строки кэшируется
+        Run(hash_every_time, "String_Hash (no cache)");
+        Run(cached_hash, "std::hash<String> (cached)");
+        
+        String key = keys[0];
+        const size_t hash = key.Hash();
+        key.Push_Back('x'); // Изменение сбрасывает кэш
+        std::cout << "Hash after change differs: " << (key.Hash() != hash) << ", equals std::hash<std::string_view>: " << (key.Hash() == std::hash<std::string_view>()(key)) << std::endl;
+    }
+    
     return 0;
 }
@@ -38,8 +38,9 @@ private:
     public:
         ListNode() = default;
         ~ListNode() = default;
-        ListNode(const value_type& iData, size_type iBucket):
+        ListNode(const value_type& iData, size_type iHash, size_type iBucket):
         data(iData),
+        hash(iHash),
         bucket(iBucket)
         {
             
@@ -62,6 +63,7 @@ private:
             
             *const_cast<Key*>(&data.first) = data.first;
             *const_cast<Value*>(&data.second) = data.second;
+            hash = other.hash;
             bucket = other.bucket;
             
             return *this;
@@ -74,6 +76,7 @@ private:
             
             *const_cast<Key*>(&data.first) = std::move(data.first);
             *const_cast<Value*>(&data.second) = std::move(data.second);
+            hash = std::exchange(other.hash, 0u);
             bucket = std::exchange(other.bucket, 0u);
             
             return *this;
@@ -85,6 +88,7 @@ private:
         }
         
         value_type data;
+        size_type hash; // полный хэш ключа: при поиске сравнивается до ключа, при Rehash ключ не хэшируется повторно
         size_type bucket; // принадлежность к bucket
     };
     
@@ -275,6 +279,11 @@ private:
         return _iterator->bucket;
     }
     
+    size_type hash() const
+    {
+        return _iterator->hash;
+    }
+    
 private:
     bool _isValid = false;
     list_type::iterator _iterator;
@@ -398,23 +407,23 @@ std::pair<typename Unordered_Map<Key, Value, Hash, Equal>::Iterator, bool> Unord
     if (Load_Factor() >= Max_Load_Factor())
         Rehash(Buckets_Count() * 2 + 1);
     
-    auto& [key, value] = element;
-    size_type bucket = Bucket(key);
+    const size_type hash = Hash()(element.first); // Ключ хэшируется один раз за время жизни узла
+    size_type bucket = hash % Buckets_Count();
     auto it = _buckets[bucket];
     if (it != Iterator())
     {
         while (it.get() != _list.end() && it.bucket() == bucket)
         {
-            if (Equal()(it->first, element.first))
+            if (it.hash() == hash && Equal()(it->first, element.first)) // Ключи сравниваются только при совпадении хэшей
                 return {it, false};
             ++it;
         }
         
-        it = _list.emplace(it.get(), std::move(element), bucket);
+        it = _list.emplace(it.get(), std::move(element), hash, bucket);
     }
     else
     {
-        _list.emplace_front(std::move(element), bucket);
+        _list.emplace_front(std::move(element), hash, bucket);
         _buckets[bucket] = _list.begin();
         it = _list.begin();
     }
@@ -440,17 +449,18 @@ std::pair<typename Unordered_Map<Key, Value, Hash, Equal>::Iterator, bool> Unord
 template <class Key, class Value, class Hash, class Equal>
 Unordered_Map<Key, Value, Hash, Equal>::Iterator Unordered_Map<Key, Value, Hash, Equal>::Find(const Key& key) const
 {
-    size_type bucket = Bucket(key);
-    if (bucket < _buckets.size())
+    if (_buckets.empty())
+        return Iterator();
+    
+    const size_type hash = Hash()(key);
+    size_type bucket = hash % _buckets.size();
+    if (auto it = _buckets[bucket]; it != Iterator())
     {
-        if (auto it = _buckets[bucket]; it != Iterator())
+        for (; it.get() != _list.end() && it.bucket() == bucket; ++it)
         {
-            for (; it.get() != _list.end() && it.bucket() == bucket; ++it)
+            if (it.hash() == hash && Equal()(it->first, key)) // Сравнение хэшей отсекает чужие ключи в bucket без сравнения строк
             {
-                if (Equal()(it->first, key))
-                {
-                    return Iterator(it);
-                }
+                return Iterator(it);
             }
         }
     }
@@ -523,21 +533,22 @@ void Unordered_Map<Key, Value, Hash, Equal>::Rehash(size_type count)
     buckets_t buckets(count);
     list_type list;
     
-    for (auto iter = _list.begin(); iter != _list.end(); ++iter)
+    for (auto iter = _list.begin(); iter != _list.end();)
     {
-        auto [key, value] = iter->data;
-        size_type bucket = Hash()(key) % buckets.size();
+        auto node = iter++;
+        size_type bucket = node->hash % buckets.size(); // Сохраненный хэш: ключи не хэшируются повторно
+        node->bucket = bucket;
         auto it = buckets[bucket];
         if (it != Iterator())
         {
             while (it != list.end() && it.bucket() == bucket)
                 ++it;
             
-            list.emplace(it.get(), std::move(iter->data), bucket);
+            list.splice(it.get(), _list, node); // Узел переносится без копирования и выделения памяти
         }
         else
         {
-            list.emplace_front(std::move(iter->data), bucket);
+            list.splice(list.begin(), _list, node);
             buckets[bucket] = list.begin();
         }
     }
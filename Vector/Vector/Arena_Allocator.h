@@ -0,0 +1,220 @@
+#ifndef Arena_Allocator_h
+#define Arena_Allocator_h
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+
+/*
+ Arena (monotonic/bump allocator) - память выделяется большими блоками, а внутри блока объекты размещаются простым сдвигом указателя (bump pointer), без поиска свободного места и без заголовков у каждого объекта.
+ Освобождение отдельного объекта ничего не делает (Deallocate - пустой), вся память возвращается разом через Reset (блоки остаются для повторного использования) или Release (блоки возвращаются системе).
+ Плюсы:
+ - выделение памяти - это сравнение и сложение указателей, на порядок быстрее operator new.
+ - объекты одного запроса лежат рядом в памяти (локальность кэша).
+ - все временные объекты освобождаются одним вызовом Reset.
+ Минусы:
+ - память не переиспользуется до Reset: Vector при росте оставляет в арене старые буферы.
+ - Arena не потокобезопасна: одна арена на поток/обработчик запроса.
+ - после Reset нельзя обращаться к объектам, созданным в арене, поэтому контейнеры должны быть разрушены до Reset.
+ */
+class Arena
+{
+    Arena(const Arena&) = delete;
+    Arena(Arena&&) noexcept = delete;
+    Arena& operator=(const Arena&) = delete;
+    Arena& operator=(Arena&&) noexcept = delete;
+
+    // Заголовок блока, сразу за ним идет память под объекты
+    struct Block
+    {
+        Block* next = nullptr;
+        size_t size = 0; // размер памяти под объекты без заголовка
+    };
+
+public:
+    // Позиция в арене для Rollback
+    struct Mark
+    {
+        Block* block = nullptr;
+        char* current = nullptr;
+        char* end = nullptr;
+    };
+
+    explicit Arena(size_t block_size = 64 * 1024) noexcept :
+    _block_size(block_size)
+    {
+
+    }
+
+    ~Arena()
+    {
+        Release();
+    }
+
+    // Выделение сырой памяти сдвигом указателя, при нехватке места - переход в следующий блок
+    void* Allocate(size_t bytes, size_t alignment = alignof(std::max_align_t))
+    {
+        char* ptr = Align(_current, alignment);
+        if (!_current || ptr + bytes > _end)
+        {
+            Next_Block(bytes + alignment);
+            ptr = Align(_current, alignment);
+        }
+
+        _current = ptr + bytes;
+        return ptr;
+    }
+
+    // Откат всех блоков в начало: память не возвращается системе и переиспользуется следующими выделениями. Time: O(1)
+    void Reset() noexcept
+    {
+        _block = _head;
+        _current = _head ? Begin(_head) : nullptr;
+        _end = _head ? Begin(_head) + _head->size : nullptr;
+    }
+
+    Mark Save() const noexcept
+    {
+        return Mark{_block, _current, _end};
+    }
+
+    // Откат к позиции Save: память, выделенная после нее, переиспользуется следующими выделениями. Time: O(1)
+    void Rollback(const Mark& mark) noexcept
+    {
+        _block = mark.block;
+        _current = mark.current;
+        _end = mark.end;
+    }
+
+    // Возвращение всех блоков системе
+    void Release() noexcept
+    {
+        while (_head)
+        {
+            Block* next = _head->next;
+            operator delete(_head);
+            _head = next;
+        }
+
+        _block = nullptr;
+        _current = nullptr;
+        _end = nullptr;
+    }
+
+    // Сколько памяти занято во всех блоках, включая текущий
+    size_t Used() const noexcept
+    {
+        size_t used = 0;
+        for (Block* block = _head; block && block != _block; block = block->next)
+            used += block->size;
+
+        return _block ? used + static_cast<size_t>(_current - Begin(_block)) : used;
+    }
+
+private:
+    static char* Begin(Block* block) noexcept
+    {
+        return reinterpret_cast<char*>(block + 1);
+    }
+
+    static char* Align(char* ptr, size_t alignment) noexcept
+    {
+        auto address = reinterpret_cast<std::uintptr_t>(ptr);
+        return reinterpret_cast<char*>((address + alignment - 1) & ~(alignment - 1)); // alignment - степень двойки
+    }
+
+    // После Reset сначала переиспользуются уже выделенные блоки, новый блок выделяется только если в следующем блоке недостаточно места
+    void Next_Block(size_t bytes)
+    {
+        Block* next = _block ? _block->next : _head;
+        if (!next || next->size < bytes)
+        {
+            const size_t size = std::max(bytes, _block_size);
+            Block* block = new (operator new(sizeof(Block) + size)) Block{next, size};
+            if (_block)
+                _block->next = block;
+            else
+                _head = block;
+            next = block;
+        }
+
+        _block = next;
+        _current = Begin(_block);
+        _end = _current + _block->size;
+    }
+
+private:
+    Block* _head = nullptr;  // первый блок
+    Block* _block = nullptr; // текущий блок
+    char* _current = nullptr;
+    char* _end = nullptr;
+    size_t _block_size = 0;
+};
+
+// Аллокатор с тем же интерфейсом, что и Allocator, но память берется из Arena
+template <typename T>
+struct Arena_Allocator
+{
+    using value_type = T;
+    using size_type = std::size_t;
+
+    Arena_Allocator() noexcept = default;
+    explicit Arena_Allocator(Arena& arena) noexcept : _arena(&arena) {}
+    template <typename U>
+    Arena_Allocator(const Arena_Allocator<U>& other) noexcept : _arena(other._arena) {}
+
+    // Выделение сырой памяти без вызовов конструкторов
+    T* Allocate(size_type capacity);
+    // Освобождение памяти происходит через Arena::Reset
+    void Deallocate(T* ptr);
+    // Вызов конструктора
+    template <typename ...Args>
+    void Constructor(T* ptr, Args&& ...args);
+    // Вызов деструктора
+    void Destructor(T* ptr);
+    // Позволяет создавать аллокатор для другого типа
+    template <typename U>
+    struct Rebind
+    {
+        using other = Arena_Allocator<U>;
+    };
+
+    Arena* _arena = nullptr;
+};
+
+// Выделение сырой памяти без вызовов конструкторов
+template <typename T>
+T* Arena_Allocator<T>::Allocate(size_type capacity)
+{
+    if (capacity == 0)
+        return nullptr;
+    if (!_arena)
+        throw std::logic_error("Arena is not set");
+
+    return static_cast<T*>(_arena->Allocate(capacity * sizeof(T), alignof(T)));
+}
+
+// Освобождение памяти происходит через Arena::Reset
+template <typename T>
+void Arena_Allocator<T>::Deallocate(T*)
+{
+
+}
+
+// Вызов конструктора
+template <class T>
+template <typename ...Args>
+void Arena_Allocator<T>::Constructor(T* ptr, Args&& ...args)
+{
+    new (ptr) T(std::forward<Args>(args)...); // placement new: создаем объект в выделенной памяти
+}
+
+// Вызов деструктора
+template <class T>
+void Arena_Allocator<T>::Destructor(T* ptr)
+{
+    ptr->~T();
+}
+
+#endif /* Arena_Allocator_h */
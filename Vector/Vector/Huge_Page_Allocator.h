@@ -0,0 +1,154 @@
+#ifndef Huge_Page_Allocator_h
+#define Huge_Page_Allocator_h
+
+#include <cstddef>
+#include <iostream>
+#include <new>
+
+#if defined(_WIN32)
+    #include <windows.h>
+#else
+    #include <sys/mman.h>
+#endif
+
+/*
+ Huge pages (большие страницы 2 МБ вместо 4 КБ) - для больших буферов уменьшают количество записей в TLB (Translation Lookaside Buffer - кэш трансляции виртуальных адресов в физические): на буфер 1 ГБ нужно 512 записей вместо 262144, поэтому случайный доступ к большому Vector реже промахивается мимо TLB.
+ Стратегия выделения:
+ - буферы меньше huge_page_size выделяются через operator new, т.к. для них выигрыша нет.
+ - Linux: mmap(MAP_HUGETLB) - явные huge pages из заранее зарезервированного пула (vm.nr_hugepages), если пул пуст - обычный mmap + madvise(MADV_HUGEPAGE), чтобы ядро использовало Transparent Huge Pages.
+ - Windows: VirtualAlloc(MEM_LARGE_PAGES) требует привилегии SeLockMemoryPrivilege, без неё - обычный VirtualAlloc.
+ - macOS: обычный mmap.
+ Перед данными хранится заголовок с размером отображения, т.к. Deallocate не получает размер, а munmap требует его.
+ */
+namespace huge_page
+{
+    static constexpr size_t huge_page_size = 2 * 1024 * 1024;
+    
+    // Заголовок перед данными, выровнен на 64 байта (кэш-линия)
+    struct alignas(64) Header
+    {
+        size_t bytes; // размер отображения, 0 - память выделена через operator new
+    };
+    
+    inline void* Map(size_t bytes)
+    {
+#if defined(_WIN32)
+        void* ptr = nullptr;
+        if (SIZE_T large_page = GetLargePageMinimum(); large_page > 0 && bytes % large_page == 0)
+            ptr = VirtualAlloc(nullptr, bytes, MEM_RESERVE | MEM_COMMIT | MEM_LARGE_PAGES, PAGE_READWRITE);
+        if (!ptr)
+            ptr = VirtualAlloc(nullptr, bytes, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+        return ptr;
+#else
+        void* ptr = MAP_FAILED;
+    #if defined(__linux__)
+        ptr = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+        if (ptr == MAP_FAILED)
+        {
+            ptr = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+            if (ptr != MAP_FAILED)
+                madvise(ptr, bytes, MADV_HUGEPAGE);
+        }
+    #else
+        ptr = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    #endif
+        return ptr == MAP_FAILED ? nullptr : ptr;
+#endif
+    }
+    
+    inline void Unmap(void* ptr, [[maybe_unused]] size_t bytes) noexcept
+    {
+#if defined(_WIN32)
+        VirtualFree(ptr, 0, MEM_RELEASE);
+#else
+        munmap(ptr, bytes);
+#endif
+    }
+}
+
+// Аллокатор с тем же интерфейсом, что и Allocator, но большие буферы выделяются на huge pages
+template <typename T>
+struct Huge_Page_Allocator
+{
+    using value_type = T;
+    using size_type = std::size_t;
+    
+    static_assert(alignof(T) <= alignof(huge_page::Header), "Huge_Page_Allocator: over-aligned types are not supported");
+    
+    // Выделение сырой памяти без вызовов конструкторов
+    T* Allocate(size_type capacity);
+    // Освобождение памяти без вызовов деструкторов
+    void Deallocate(T* ptr);
+    // Вызов конструктора
+    template <typename ...Args>
+    void Constructor(T* ptr, Args&& ...args);
+    // Вызов деструктора
+    void Destructor(T* ptr);
+    // Позволяет создавать аллокатор для другого типа
+    template <typename U>
+    struct Rebind
+    {
+        using other = Huge_Page_Allocator<U>;
+    };
+};
+
+// Выделение сырой памяти без вызовов конструкторов
+template <typename T>
+T* Huge_Page_Allocator<T>::Allocate(size_type capacity)
+{
+    using namespace huge_page;
+    
+    if (capacity == 0)
+        return nullptr;
+    
+    size_t bytes = sizeof(Header) + capacity * sizeof(T);
+    Header* header = nullptr;
+    if (bytes < huge_page_size)
+    {
+        header = static_cast<Header*>(operator new(bytes, std::align_val_t(alignof(Header))));
+        header->bytes = 0;
+    }
+    else
+    {
+        bytes = (bytes + huge_page_size - 1) / huge_page_size * huge_page_size; // Округление до целого числа huge pages
+        header = static_cast<Header*>(Map(bytes));
+        if (!header)
+            throw std::bad_alloc();
+        header->bytes = bytes;
+    }
+    
+    return reinterpret_cast<T*>(header + 1);
+}
+
+// Освобождение памяти без вызовов деструкторов
+template <typename T>
+void Huge_Page_Allocator<T>::Deallocate(T* ptr)
+{
+    using namespace huge_page;
+    
+    if (!ptr)
+        return;
+    
+    Header* header = reinterpret_cast<Header*>(ptr) - 1;
+    if (header->bytes == 0)
+        operator delete(header, std::align_val_t(alignof(Header)));
+    else
+        Unmap(header, header->bytes);
+}
+
+// Вызов конструктора
+template <class T>
+template <typename ...Args>
+void Huge_Page_Allocator<T>::Constructor(T* ptr, Args&& ...args)
+{
+    new (ptr) T(std::forward<Args>(args)...); // placement new: создаем объект в выделенной памяти
+}
+
+// Вызов деструктора
+template <class T>
+void Huge_Page_Allocator<T>::Destructor(T* ptr)
+{
+    ptr->~T();
+}
+
+#endif /* Huge_Page_Allocator_h */
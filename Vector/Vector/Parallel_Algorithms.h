@@ -0,0 +1,269 @@
+#ifndef Parallel_Algorithms_h
+#define Parallel_Algorithms_h
+
+#include <algorithm>
+#include <functional>
+#include <iostream>
+#include <iterator>
+#include <memory>
+#include <numeric>
+#include <optional>
+#include <thread>
+#include <vector>
+
+/*
+ Параллельные алгоритмы над непрерывными диапазонами: Vector, Custom_Vector, Array и любой контейнер с методами Data() и Size().
+ Диапазон делится на равные части по числу потоков, каждая часть обрабатывается в своем потоке, последнюю часть обрабатывает вызывающий поток.
+ Если элементов меньше, чем grain_size на поток, то потоков запускается меньше, вплоть до последовательного выполнения без создания потоков: накладные расходы на запуск потока (~десятки мкс) больше выигрыша на маленьких диапазонах.
+ Функции не должны бросать исключения: исключение в дочернем потоке вызовет std::terminate.
+ */
+namespace parallel
+{
+    static constexpr size_t grain_size = 1 << 15; // минимальное число элементов на поток
+    
+    // Контейнер с непрерывной памятью
+    template <class Container>
+    concept Contiguous = requires(Container& container)
+    {
+        container.Data();
+        container.Size();
+    };
+    
+    // Число потоков для диапазона из count элементов
+    inline size_t Threads(size_t count) noexcept
+    {
+        const size_t hardware = std::max<size_t>(std::thread::hardware_concurrency(), 1);
+        return std::clamp<size_t>(count / grain_size, 1, hardware);
+    }
+    
+    // Разбиение [first, last) на threads частей, function(begin, end, index) вызывается для каждой части
+    template <class Iterator, class Function>
+    void For_Chunks(Iterator first, Iterator last, size_t threads, Function&& function)
+    {
+        const size_t count = static_cast<size_t>(last - first);
+        if (threads <= 1)
+        {
+            function(first, last, size_t(0));
+            return;
+        }
+        
+        std::vector<std::jthread> workers;
+        workers.reserve(threads - 1);
+        for (size_t i = 0; i < threads - 1; ++i)
+        {
+            Iterator begin = first + count * i / threads;
+            Iterator end = first + count * (i + 1) / threads;
+            workers.emplace_back([&function, begin, end, i]() { function(begin, end, i); });
+        }
+        function(first + count * (threads - 1) / threads, last, threads - 1);
+    } // jthread дожидается завершения потоков в деструкторе
+    
+    /*
+     Разбиение слияния [first1, first1 + size1) и [first2, first2 + size2) по позиции k результата (merge path): возвращает количество элементов первого диапазона среди первых k элементов результата.
+     Бинарный поиск наименьшего i, при котором b[k - i - 1] < a[i]: как у std::merge, при равенстве первым идет элемент первого диапазона. Time: O(log(min(size1, size2)))
+     */
+    template <class Iterator, class Compare>
+    size_t Merge_Split(Iterator first1, size_t size1, Iterator first2, size_t size2, size_t k, Compare& compare)
+    {
+        size_t low = k > size2 ? k - size2 : 0;
+        size_t high = std::min(k, size1);
+        while (low < high)
+        {
+            const size_t middle = low + (high - low) / 2;
+            if (compare(first2[k - middle - 1], first1[middle]))
+                high = middle;
+            else
+                low = middle + 1;
+        }
+        return low;
+    }
+    
+    // Слияние
+    template <class Source, class Destination>
+    struct Merge_Task
+    {
+        Source first1, last1, first2, last2;
+        Destination output;
+    };
+    
+    /*
+     Один шаг сортировки слиянием: соседние отсортированные части source [bounds[i], bounds[i + step]) и [bounds[i + step], bounds[i + 2 * step]) сливаются в destination по тем же смещениям.
+     Каждое слияние делится на части по ~count / threads элементов результата (Merge_Split), поэтому все потоки заняты на каждом шаге, в том числе на последнем, где слияние одно.
+     */
+    template <class Source, class Destination, class Compare>
+    void Merge_Step(Source source, Destination destination, const std::vector<size_t>& bounds, size_t step, size_t threads, Compare& compare)
+    {
+        const size_t parts = bounds.size() - 1;
+        const size_t count = bounds.back();
+        const size_t piece = std::max<size_t>(count / threads, 1);
+        std::vector<Merge_Task<Source, Destination>> tasks;
+        for (size_t i = 0; i < parts; i += 2 * step)
+        {
+            const size_t begin = bounds[i];
+            const size_t middle = bounds[std::min(i + step, parts)];
+            const size_t end = bounds[std::min(i + 2 * step, parts)];
+            const size_t size1 = middle - begin;
+            const size_t size2 = end - middle;
+            for (size_t k = 0; k < size1 + size2; k += piece)
+            {
+                const size_t next = std::min(k + piece, size1 + size2);
+                const size_t i1 = Merge_Split(source + begin, size1, source + middle, size2, k, compare);
+                const size_t i2 = Merge_Split(source + begin, size1, source + middle, size2, next, compare);
+                tasks.push_back({source + begin + i1, source + begin + i2, source + middle + (k - i1), source + middle + (next - i2), destination + begin + k});
+            }
+        }
+        
+        For_Chunks(tasks.begin(), tasks.end(), std::min(threads, tasks.size()), [&compare](auto begin, auto end, size_t)
+        {
+            for (auto task = begin; task != end; ++task)
+                std::merge(std::make_move_iterator(task->first1), std::make_move_iterator(task->last1), std::make_move_iterator(task->first2), std::make_move_iterator(task->last2), task->output, compare);
+        });
+    }
+}
+
+// Вызов function(element) для каждого элемента. Time: O(N / threads)
+template <class Iterator, class Function>
+void Parallel_For(Iterator first, Iterator last, Function function)
+{
+    parallel::For_Chunks(first, last, parallel::Threads(static_cast<size_t>(last - first)), [&function](Iterator begin, Iterator end, size_t)
+    {
+        std::for_each(begin, end, function);
+    });
+}
+
+// Запись function(input[i]) в output[i]. Time: O(N / threads)
+template <class InputIterator, class OutputIterator, class Function>
+OutputIterator Parallel_Transform(InputIterator first, InputIterator last, OutputIterator output, Function function)
+{
+    parallel::For_Chunks(first, last, parallel::Threads(static_cast<size_t>(last - first)), [first, output, &function](InputIterator begin, InputIterator end, size_t)
+    {
+        std::transform(begin, end, output + (begin - first), function);
+    });
+    return output + (last - first);
+}
+
+// Свертка: каждая часть сворачивается в своем потоке, затем частичные результаты сворачиваются последовательно. Операция должна быть ассоциативной. Time: O(N / threads + threads)
+template <class Iterator, class T, class BinaryOperation = std::plus<>>
+T Parallel_Reduce(Iterator first, Iterator last, T init, BinaryOperation operation = {})
+{
+    const size_t count = static_cast<size_t>(last - first);
+    if (count == 0)
+        return init;
+    
+    const size_t threads = parallel::Threads(count);
+    struct alignas(64) Partial // на отдельной кэш-линии, чтобы избежать false sharing
+    {
+        std::optional<T> value; // T может не иметь конструктора по умолчанию: значение создается в потоке части
+    };
+    std::vector<Partial> partials(threads);
+    parallel::For_Chunks(first, last, threads, [&partials, &operation](Iterator begin, Iterator end, size_t index)
+    {
+        partials[index].value.emplace(std::accumulate(std::next(begin), end, T(*begin), operation)); // части не пустые: в каждой не меньше grain_size элементов
+    });
+    
+    for (auto& partial : partials)
+        init = operation(std::move(init), std::move(*partial.value));
+    return init;
+}
+
+// Заполнение значением value. Time: O(N / threads)
+template <class Iterator, class T>
+void Parallel_Fill(Iterator first, Iterator last, const T& value)
+{
+    parallel::For_Chunks(first, last, parallel::Threads(static_cast<size_t>(last - first)), [&value](Iterator begin, Iterator end, size_t)
+    {
+        std::fill(begin, end, value);
+    });
+}
+
+/*
+ Параллельная сортировка слиянием:
+ 1. Каждая часть сортируется в своем потоке std::sort.
+ 2. Соседние отсортированные части попарно сливаются, на каждом шаге число частей уменьшается в 2 раза. Слияние выполняется из диапазона в буфер и обратно (std::merge не работает на месте),
+ и каждое слияние делится между всеми потоками бинарным поиском точек разбиения (merge path): последний шаг - одно слияние всех N элементов - тоже параллельный.
+ Буфер - сырая память на N элементов, в которую элементы перемещаются параллельно, поэтому конструктор по умолчанию у элементов не нужен.
+ Time: O(N/threads * log(N/threads) + N/threads * log(threads)), Memory: O(N)
+ */
+template <class Iterator, class Compare = std::less<>>
+void Parallel_Sort(Iterator first, Iterator last, Compare compare = {})
+{
+    using Value = typename std::iterator_traits<Iterator>::value_type;
+    
+    const size_t count = static_cast<size_t>(last - first);
+    const size_t threads = parallel::Threads(count);
+    if (threads <= 1)
+    {
+        std::sort(first, last, compare);
+        return;
+    }
+    
+    std::vector<size_t> bounds(threads + 1);
+    for (size_t i = 0; i <= threads; ++i)
+        bounds[i] = count * i / threads;
+    
+    parallel::For_Chunks(bounds.begin(), bounds.end() - 1, threads, [first, &compare](auto begin, auto end, size_t)
+    {
+        for (auto it = begin; it != end; ++it)
+            std::sort(first + *it, first + *std::next(it), compare);
+    });
+    
+    std::allocator<Value> allocator;
+    Value* buffer = allocator.allocate(count);
+    parallel::For_Chunks(first, last, threads, [first, buffer](Iterator begin, Iterator end, size_t)
+    {
+        std::uninitialized_move(begin, end, buffer + (begin - first));
+    });
+    
+    bool in_buffer = true; // Где лежат отсортированные части: после перемещения - в буфере
+    for (size_t step = 1; step < threads; step *= 2, in_buffer = !in_buffer)
+    {
+        if (in_buffer)
+            parallel::Merge_Step(buffer, first, bounds, step, threads, compare);
+        else
+            parallel::Merge_Step(first, buffer, bounds, step, threads, compare);
+    }
+    
+    parallel::For_Chunks(buffer, buffer + count, threads, [first, buffer, in_buffer](Value* begin, Value* end, size_t)
+    {
+        if (in_buffer)
+            std::move(begin, end, first + (begin - buffer));
+        std::destroy(begin, end);
+    });
+    allocator.deallocate(buffer, count);
+}
+
+// Перегрузки для контейнеров с Data() и Size(): Vector, Custom_Vector, Array
+template <parallel::Contiguous Container, class Function>
+void Parallel_For(Container& container, Function function)
+{
+    Parallel_For(container.Data(), container.Data() + container.Size(), std::move(function));
+}
+
+template <parallel::Contiguous InputContainer, parallel::Contiguous OutputContainer, class Function>
+void Parallel_Transform(const InputContainer& input, OutputContainer& output, Function function)
+{
+    if (output.Size() < input.Size())
+        throw std::out_of_range("output is smaller than input");
+    
+    Parallel_Transform(input.Data(), input.Data() + input.Size(), output.Data(), std::move(function));
+}
+
+template <parallel::Contiguous Container, class T, class BinaryOperation = std::plus<>>
+T Parallel_Reduce(const Container& container, T init, BinaryOperation operation = {})
+{
+    return Parallel_Reduce(container.Data(), container.Data() + container.Size(), std::move(init), std::move(operation));
+}
+
+template <parallel::Contiguous Container, class T>
+void Parallel_Fill(Container& container, const T& value)
+{
+    Parallel_Fill(container.Data(), container.Data() + container.Size(), value);
+}
+
+template <parallel::Contiguous Container, class Compare = std::less<>>
+void Parallel_Sort(Container& container, Compare compare = {})
+{
+    Parallel_Sort(container.Data(), container.Data() + container.Size(), std::move(compare));
+}
+
+#endif /* Parallel_Algorithms_h */
@@ -0,0 +1,280 @@
+#ifndef Pool_Allocator_h
+#define Pool_Allocator_h
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <utility>
+
+/*
+ Pool (пул блоков фиксированного размера) - у каждого потока свой пул, поэтому выделение и освобождение в своем потоке не требуют блокировок и атомарных операций.
+ Запрошенный размер округляется вверх до класса размера (16, 32, 64, ... 4096 байт), на каждый класс ведется односвязный список свободных блоков (free list). Свободные блоки нарезаются из больших кусков (chunk).
+ Запросы больше максимального класса идут напрямую в operator new.
+ Перед каждым блоком хранится заголовок с номером класса (Deallocate не получает размер) и пулом-владельцем.
+ Освобождение в другом потоке: блок возвращается своему владельцу через атомарный список удаленных освобождений (_remote, стек Трейбера), владелец забирает его целиком одним exchange, когда в его free list нет блоков.
+ Время жизни: пул создается в куче, thread_local хранит только указатель на него. При завершении потока пул отсоединяется от потока и удаляется, когда вернутся все выданные им блоки,
+ поэтому контейнер может пережить поток, в котором выделил память (в том числе статический контейнер, разрушаемый после thread_local пулов main).
+ Счетчик невозвращенных блоков: поток-владелец ведет его без атомарных операций (_live), другие потоки вычитают из атомарного _pending, при завершении владелец прибавляет _live к _pending: ноль означает, что блоков не осталось.
+ Плюсы:
+ - Allocate/Deallocate в своем потоке - это взятие/возврат головы списка, без системных вызовов и блокировок.
+ - память переиспользуется сразу после Deallocate (в отличии от Arena).
+ Минусы:
+ - внутренняя фрагментация до 2 раз из-за округления до степени двойки.
+ - освобождение в чужом потоке - CAS в общий для всех потоков список владельца.
+ - Allocate нельзя вызывать после разрушения thread_local объектов потока (из деструкторов статических объектов).
+ */
+class Pool
+{
+    Pool(const Pool&) = delete;
+    Pool(Pool&&) noexcept = delete;
+    Pool& operator=(const Pool&) = delete;
+    Pool& operator=(Pool&&) noexcept = delete;
+
+    static constexpr size_t min_shift = 4;     // минимальный класс: 16 байт
+    static constexpr size_t classes = 9;       // 16, 32, 64, 128, 256, 512, 1024, 2048, 4096
+    static constexpr size_t chunk_size = 64 * 1024;
+    static constexpr size_t large = classes;   // номер класса для больших блоков, которые выделяются через operator new
+
+    // Заголовок перед каждым блоком, выровнен как max_align_t, чтобы данные после него тоже были выровнены
+    struct alignas(std::max_align_t) Header
+    {
+        Pool* pool;        // Владелец, nullptr - большой блок
+        size_t size_class;
+    };
+
+    // Свободный блок хранит указатель на следующий свободный блок на месте поля pool, size_class заголовка сохраняется
+    struct Free_Block
+    {
+        Free_Block* next;
+    };
+
+    // Кусок памяти, из которого нарезаются блоки
+    struct Chunk
+    {
+        Chunk* next;
+    };
+
+    // Владелец пула потока: при завершении потока отсоединяет пул, а удаляет его последний возвращенный блок
+    struct Local_Pool
+    {
+        Local_Pool() : pool(new Pool()) { _current = pool; }
+        ~Local_Pool() { _current = nullptr; pool->Detach(); }
+
+        Pool* const pool;
+    };
+
+public:
+    // Пул текущего потока
+    static Pool& Local()
+    {
+        thread_local Local_Pool local;
+        return *local.pool;
+    }
+
+    void* Allocate(size_t bytes)
+    {
+        const size_t size_class = Size_Class(bytes);
+        Header* header = nullptr;
+        if (size_class == large)
+        {
+            header = static_cast<Header*>(operator new(sizeof(Header) + bytes));
+            header->pool = nullptr;
+        }
+        else
+        {
+            if (!_free[size_class])
+                Refill(size_class);
+
+            header = reinterpret_cast<Header*>(std::exchange(_free[size_class], _free[size_class]->next));
+            header->pool = this;
+            ++_live;
+        }
+
+        header->size_class = size_class;
+        return header + 1;
+    }
+
+    // Блок возвращается пулу, который его выделил, в любом потоке
+    static void Deallocate(void* ptr) noexcept
+    {
+        if (!ptr)
+            return;
+
+        Header* header = static_cast<Header*>(ptr) - 1;
+        Pool* pool = header->pool;
+        if (!pool)
+            operator delete(header);
+        else if (pool == _current)
+            pool->Free_Local(header);
+        else
+            pool->Free_Remote(header);
+    }
+
+private:
+    Pool() = default;
+
+    ~Pool()
+    {
+        while (_chunks)
+        {
+            Chunk* next = _chunks->next;
+            operator delete(_chunks);
+            _chunks = next;
+        }
+    }
+
+    // Размер блока вместе с заголовком
+    static constexpr size_t Block_Size(size_t size_class) noexcept
+    {
+        return sizeof(Header) + (size_t(1) << (size_class + min_shift));
+    }
+
+    // Номер класса: наименьшая степень двойки >= bytes
+    static size_t Size_Class(size_t bytes) noexcept
+    {
+        size_t size_class = 0;
+        while (size_class < classes && (size_t(1) << (size_class + min_shift)) < bytes)
+            ++size_class;
+        return size_class;
+    }
+
+    void Push_Free(Header* header) noexcept
+    {
+        const size_t size_class = header->size_class;
+        Free_Block* block = reinterpret_cast<Free_Block*>(header);
+        block->next = _free[size_class];
+        _free[size_class] = block;
+    }
+
+    void Free_Local(Header* header) noexcept
+    {
+        Push_Free(header);
+        --_live;
+    }
+
+    // release: запись next видна владельцу, который заберет список с acquire
+    void Free_Remote(Header* header) noexcept
+    {
+        Free_Block* block = reinterpret_cast<Free_Block*>(header);
+        block->next = _remote.load(std::memory_order_relaxed);
+        while (!_remote.compare_exchange_weak(block->next, block, std::memory_order_release, std::memory_order_relaxed))
+        {
+        }
+
+        if (_pending.fetch_sub(1, std::memory_order_acq_rel) == 1) // Последний блок пула, поток-владелец уже завершился
+            delete this;
+    }
+
+    // Блоки, освобожденные другими потоками, переходят в free list владельца
+    void Drain_Remote() noexcept
+    {
+        Free_Block* block = _remote.exchange(nullptr, std::memory_order_acquire);
+        while (block)
+        {
+            Free_Block* next = block->next;
+            Push_Free(reinterpret_cast<Header*>(block));
+            block = next;
+        }
+    }
+
+    // Поток-владелец завершился: _live невозвращенных блоков добавляются к освобожденным другими потоками (отрицательный _pending)
+    void Detach() noexcept
+    {
+        if (_pending.fetch_add(_live, std::memory_order_acq_rel) + _live == 0)
+            delete this;
+    }
+
+    // Новые блоки класса: сначала освобожденные другими потоками, затем нарезка нового куска
+    void Refill(size_t size_class)
+    {
+        if (_remote.load(std::memory_order_relaxed))
+        {
+            Drain_Remote();
+            if (_free[size_class])
+                return;
+        }
+
+        const size_t block_size = Block_Size(size_class);
+        const size_t count = std::max<size_t>((chunk_size - sizeof(Header)) / block_size, 1);
+        char* memory = static_cast<char*>(operator new(sizeof(Header) + count * block_size));
+        Chunk* chunk = reinterpret_cast<Chunk*>(memory);
+        chunk->next = _chunks;
+        _chunks = chunk;
+
+        char* begin = memory + sizeof(Header); // первый заголовок занимает Chunk
+        for (size_t i = count; i-- > 0;)
+        {
+            Header* header = reinterpret_cast<Header*>(begin + i * block_size);
+            header->size_class = size_class;
+            Push_Free(header);
+        }
+    }
+
+private:
+    Free_Block* _free[classes] = {};
+    Chunk* _chunks = nullptr;
+    int64_t _live = 0; // Выдано - освобождено в потоке-владельце
+    alignas(64) std::atomic<Free_Block*> _remote = nullptr; // Освобожденные другими потоками
+    std::atomic<int64_t> _pending = 0; // Минус освобожденные другими потоками, после завершения владельца + _live
+
+    inline static thread_local Pool* _current = nullptr; // Пул текущего потока, nullptr - еще не создан или уже отсоединен
+};
+
+// Аллокатор с тем же интерфейсом, что и Allocator, но память берется из пула текущего потока
+template <typename T>
+struct Pool_Allocator
+{
+    using value_type = T;
+    using size_type = std::size_t;
+
+    static_assert(alignof(T) <= alignof(std::max_align_t), "Pool_Allocator: over-aligned types are not supported");
+
+    // Выделение сырой памяти без вызовов конструкторов
+    T* Allocate(size_type capacity);
+    // Освобождение памяти без вызовов деструкторов
+    void Deallocate(T* ptr);
+    // Вызов конструктора
+    template <typename ...Args>
+    void Constructor(T* ptr, Args&& ...args);
+    // Вызов деструктора
+    void Destructor(T* ptr);
+    // Позволяет создавать аллокатор для другого типа
+    template <typename U>
+    struct Rebind
+    {
+        using other = Pool_Allocator<U>;
+    };
+};
+
+// Выделение сырой памяти без вызовов конструкторов
+template <typename T>
+T* Pool_Allocator<T>::Allocate(size_type capacity)
+{
+    return capacity > 0 ? static_cast<T*>(Pool::Local().Allocate(capacity * sizeof(T))) : nullptr;
+}
+
+// Освобождение памяти без вызовов деструкторов: блок возвращается в пул потока, который его выделил
+template <typename T>
+void Pool_Allocator<T>::Deallocate(T* ptr)
+{
+    Pool::Deallocate(ptr);
+}
+
+// Вызов конструктора
+template <class T>
+template <typename ...Args>
+void Pool_Allocator<T>::Constructor(T* ptr, Args&& ...args)
+{
+    new (ptr) T(std::forward<Args>(args)...); // placement new: создаем объект в выделенной памяти
+}
+
+// Вызов деструктора
+template <class T>
+void Pool_Allocator<T>::Destructor(T* ptr)
+{
+    ptr->~T();
+}
+
+#endif /* Pool_Allocator_h */
@@ -0,0 +1,257 @@
+#ifndef Segmented_Vector_h
+#define Segmented_Vector_h
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <iostream>
+#include <utility>
+
+/*
+ Segmented_Vector (сегментированный вектор) - элементы хранятся в чанках фиксированного размера Chunk_Size, указатели на чанки хранятся в каталоге (directory).
+ element[index] = directory[index / Chunk_Size][index % Chunk_Size], Chunk_Size - степень двойки, поэтому деление и остаток - это сдвиг и маска.
+ В отличии от Vector:
+ - при росте элементы никогда не перемещаются: выделяется только новый чанк, поэтому указатели/ссылки на элементы остаются валидными всё время жизни элемента.
+ - нет копирования всех элементов при реаллокации, худшее время Emplace_Back - O(размер каталога), а не O(N).
+ - доступ по индексу - это 2 обращения к памяти вместо 1.
+ Потокобезопасность: один писатель и много читателей без блокировок (single-writer/multi-reader).
+ - писатель создает элемент и только потом публикует новый размер (_size.store release), читатель читает размер (_size.load acquire) и обращается только к индексам < Size(), поэтому видит полностью созданные элементы.
+ - при росте каталога старый каталог не удаляется до разрушения Segmented_Vector, т.к. читатель может еще его использовать (каталог растет в 2 раза, поэтому все старые каталоги занимают меньше текущего).
+ - несколько писателей должны синхронизироваться снаружи, Release_Front и Clear не должны выполняться одновременно с чтением освобождаемых элементов.
+ */
+template <class T, size_t Chunk_Size = 1024>
+class Segmented_Vector
+{
+    static_assert(Chunk_Size > 0 && (Chunk_Size & (Chunk_Size - 1)) == 0, "Chunk_Size must be a power of two");
+    
+    Segmented_Vector(const Segmented_Vector&) = delete;
+    Segmented_Vector(Segmented_Vector&&) noexcept = delete;
+    Segmented_Vector& operator=(const Segmented_Vector&) = delete;
+    Segmented_Vector& operator=(Segmented_Vector&&) noexcept = delete;
+    
+    using size_type = size_t;
+    using value_type = T;
+    using reference = value_type&;
+    using const_reference = const value_type&;
+    
+    static constexpr size_type shift = std::countr_zero(Chunk_Size);
+    static constexpr size_type mask = Chunk_Size - 1;
+    
+    // Каталог указателей на чанки, старые каталоги связаны в список через previous
+    struct Directory
+    {
+        Directory* previous = nullptr;
+        size_type capacity = 0;
+        T** chunks = nullptr;
+    };
+
+public:
+    Segmented_Vector() = default;
+    ~Segmented_Vector();
+    
+    reference operator[](size_type index);
+    const_reference operator[](size_type index) const;
+    reference At(size_type index);
+    const_reference At(size_type index) const;
+    reference Front();
+    reference Back();
+    
+    void Push_Back(const T& value);
+    void Push_Back(T&& value);
+    template <typename ...Args>
+    reference Emplace_Back(Args&& ...args); // Существующие элементы не перемещаются
+    bool Empty() const noexcept;
+    size_type Size() const noexcept;
+    size_type Chunks() const noexcept;
+    size_type Begin_Index() const noexcept; // Первый не освобожденный индекс
+    void Release_Front(size_type index); // Освобождение целых чанков, все элементы которых имеют индекс < index
+    void Clear();
+
+private:
+    void Grow_Directory();
+    void Destroy_Chunk(size_type chunk, size_type count) noexcept;
+
+private:
+    std::atomic<Directory*> _directory = nullptr;
+    std::atomic<size_type> _size = 0u;
+    size_type _chunks = 0u;   // количество выделенных чанков, включая освобожденные Release_Front
+    size_type _released = 0u; // количество освобожденных чанков в начале
+};
+
+template <class T, size_t Chunk_Size>
+Segmented_Vector<T, Chunk_Size>::~Segmented_Vector()
+{
+    Clear();
+    for (Directory* directory = _directory.load(std::memory_order_relaxed); directory;)
+    {
+        Directory* previous = directory->previous;
+        delete[] directory->chunks;
+        delete directory;
+        directory = previous;
+    }
+}
+
+template <class T, size_t Chunk_Size>
+Segmented_Vector<T, Chunk_Size>::reference Segmented_Vector<T, Chunk_Size>::operator[](size_type index)
+{
+    return _directory.load(std::memory_order_acquire)->chunks[index >> shift][index & mask];
+}
+
+template <class T, size_t Chunk_Size>
+Segmented_Vector<T, Chunk_Size>::const_reference Segmented_Vector<T, Chunk_Size>::operator[](size_type index) const
+{
+    return _directory.load(std::memory_order_acquire)->chunks[index >> shift][index & mask];
+}
+
+template <class T, size_t Chunk_Size>
+Segmented_Vector<T, Chunk_Size>::reference Segmented_Vector<T, Chunk_Size>::At(size_type index)
+{
+    if (index >= Size() || index < Begin_Index())
+        throw std::out_of_range("Index is out of range!");
+    
+    return (*this)[index];
+}
+
+template <class T, size_t Chunk_Size>
+Segmented_Vector<T, Chunk_Size>::const_reference Segmented_Vector<T, Chunk_Size>::At(size_type index) const
+{
+    if (index >= Size() || index < Begin_Index())
+        throw std::out_of_range("Index is out of range!");
+    
+    return (*this)[index];
+}
+
+template <class T, size_t Chunk_Size>
+Segmented_Vector<T, Chunk_Size>::reference Segmented_Vector<T, Chunk_Size>::Front()
+{
+    if (Empty())
+        throw std::range_error("Segmented_Vector is empty");
+    
+    return (*this)[Begin_Index()];
+}
+
+template <class T, size_t Chunk_Size>
+Segmented_Vector<T, Chunk_Size>::reference Segmented_Vector<T, Chunk_Size>::Back()
+{
+    if (Empty())
+        throw std::range_error("Segmented_Vector is empty");
+    
+    return (*this)[Size() - 1];
+}
+
+template <class T, size_t Chunk_Size>
+void Segmented_Vector<T, Chunk_Size>::Push_Back(const T& value)
+{
+    Emplace_Back(value);
+}
+
+template <class T, size_t Chunk_Size>
+void Segmented_Vector<T, Chunk_Size>::Push_Back(T&& value)
+{
+    Emplace_Back(std::move(value));
+}
+
+template <class T, size_t Chunk_Size>
+template <typename ...Args>
+Segmented_Vector<T, Chunk_Size>::reference Segmented_Vector<T, Chunk_Size>::Emplace_Back(Args&& ...args)
+{
+    const size_type size = _size.load(std::memory_order_relaxed); // Писатель один, поэтому свой размер читает без синхронизации
+    const size_type chunk = size >> shift;
+    if (chunk == _chunks)
+    {
+        Directory* directory = _directory.load(std::memory_order_relaxed);
+        if (!directory || chunk == directory->capacity)
+        {
+            Grow_Directory();
+            directory = _directory.load(std::memory_order_relaxed);
+        }
+        
+        // Не вызовет дефолтный конструктор, а выделит сырую память
+        directory->chunks[chunk] = static_cast<T*>(operator new(Chunk_Size * sizeof(T)));
+        ++_chunks;
+    }
+    
+    T* ptr = _directory.load(std::memory_order_relaxed)->chunks[chunk] + (size & mask);
+    new (ptr) T(std::forward<Args>(args)...); // placement new: создаем объект в выделенной памяти
+    _size.store(size + 1, std::memory_order_release); // Публикация: читатель, увидевший новый размер, увидит и созданный элемент
+    return *ptr;
+}
+
+template <class T, size_t Chunk_Size>
+bool Segmented_Vector<T, Chunk_Size>::Empty() const noexcept
+{
+    return Size() == Begin_Index();
+}
+
+template <class T, size_t Chunk_Size>
+Segmented_Vector<T, Chunk_Size>::size_type Segmented_Vector<T, Chunk_Size>::Size() const noexcept
+{
+    return _size.load(std::memory_order_acquire);
+}
+
+template <class T, size_t Chunk_Size>
+Segmented_Vector<T, Chunk_Size>::size_type Segmented_Vector<T, Chunk_Size>::Chunks() const noexcept
+{
+    return _chunks - _released;
+}
+
+template <class T, size_t Chunk_Size>
+Segmented_Vector<T, Chunk_Size>::size_type Segmented_Vector<T, Chunk_Size>::Begin_Index() const noexcept
+{
+    return _released << shift;
+}
+
+/*
+ Освобождение чанков целиком: для журналов, из которых удаляются самые старые записи.
+ Индексы оставшихся элементов не меняются, освобожденные индексы становятся недоступны (At бросает исключение).
+ Time: O(количество освобожденных элементов) - вызов деструкторов
+ */
+template <class T, size_t Chunk_Size>
+void Segmented_Vector<T, Chunk_Size>::Release_Front(size_type index)
+{
+    const size_type size = _size.load(std::memory_order_relaxed);
+    const size_type chunks = std::min(index, size) >> shift; // Только полностью заполненные чанки
+    for (; _released < chunks; ++_released)
+        Destroy_Chunk(_released, Chunk_Size);
+}
+
+template <class T, size_t Chunk_Size>
+void Segmented_Vector<T, Chunk_Size>::Clear()
+{
+    const size_type size = _size.load(std::memory_order_relaxed);
+    for (; _released < _chunks; ++_released)
+        Destroy_Chunk(_released, std::min(size - (_released << shift), Chunk_Size));
+    
+    _size.store(0, std::memory_order_release);
+    _chunks = 0;
+    _released = 0;
+}
+
+// Новый каталог в 2 раза больше, старый остается для читателей, которые его еще используют
+template <class T, size_t Chunk_Size>
+void Segmented_Vector<T, Chunk_Size>::Grow_Directory()
+{
+    Directory* previous = _directory.load(std::memory_order_relaxed);
+    Directory* directory = new Directory{previous, previous ? previous->capacity * 2 : 8, nullptr};
+    directory->chunks = new T*[directory->capacity]();
+    if (previous)
+        std::copy(previous->chunks, previous->chunks + previous->capacity, directory->chunks);
+    
+    _directory.store(directory, std::memory_order_release);
+}
+
+template <class T, size_t Chunk_Size>
+void Segmented_Vector<T, Chunk_Size>::Destroy_Chunk(size_type chunk, size_type count) noexcept
+{
+    Directory* directory = _directory.load(std::memory_order_relaxed);
+    T* data = directory->chunks[chunk];
+    for (size_type i = 0; i < count; ++i)
+        data[i].~T();
+    operator delete(data);
+    
+    // Обнуляем указатель во всех каталогах, чтобы обращение к освобожденному чанку было заметно
+    for (; directory && chunk < directory->capacity; directory = directory->previous)
+        directory->chunks[chunk] = nullptr;
+}
+
+#endif /* Segmented_Vector_h */
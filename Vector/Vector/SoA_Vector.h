@@ -0,0 +1,282 @@
+#ifndef SoA_Vector_h
+#define SoA_Vector_h
+
+#include "Tuple.h"
+#include "Vector.h"
+
+#include <algorithm>
+#include <iostream>
+#include <numeric>
+#include <span>
+
+/*
+ SoA (Structure of Arrays) - вместо одного массива структур (AoS - Array of Structures: Vector<Struct>) каждое поле хранится в своем непрерывном массиве:
+ AoS: x0 y0 z0 | x1 y1 z1 | x2 y2 z2 ...
+ SoA: x0 x1 x2 ... | y0 y1 y2 ... | z0 z1 z2 ...
+ Плюсы:
+ - при проходе по одному полю в кэш загружаются только значения этого поля, а не вся структура: на каждую кэш-линию (64 байта) приходится 16 float, а не 64 / sizeof(Struct).
+ - компилятор может автовекторизовать (SIMD) цикл по одному столбцу, т.к. значения лежат подряд без пропусков.
+ Минусы:
+ - доступ к целой строке обращается к sizeof...(Fields) разным массивам.
+ - вставка/удаление/сортировка выполняются для каждого столбца.
+ Столбцы хранятся в Tuple<Vector<Fields>...>, строка - это Tuple<Fields...>, ссылка на строку (proxy) - Tuple<Fields&...>.
+ */
+template <typename ...Fields>
+class SoA_Vector
+{
+    using size_type = size_t;
+    using Index = tuple::third_implementation::MakeIndexSequence<sizeof...(Fields)>;
+    using Columns = tuple::third_implementation::Tuple<Vector<Fields>...>;
+
+public:
+    using Row = tuple::third_implementation::Tuple<Fields...>;
+    using Reference = tuple::third_implementation::Tuple<Fields&...>;
+    using Const_Reference = tuple::third_implementation::Tuple<const Fields&...>;
+    
+    // Тип поля с номером column
+    template <size_t column>
+    using Field = std::remove_cvref_t<decltype(tuple::third_implementation::Get<column>(std::declval<Row&>()))>;
+    
+    SoA_Vector() = default;
+    
+    void Push_Back(const Row& row);
+    template <typename ...Args>
+    void Emplace_Back(Args&& ...args); // по одному аргументу на каждое поле
+    void Pop_Back();
+    Reference operator[](size_type index);
+    Const_Reference operator[](size_type index) const;
+    Reference At(size_type index);
+    Const_Reference At(size_type index) const;
+    bool Empty() const noexcept;
+    size_type Size() const noexcept;
+    void Reserve(size_type capacity);
+    void Clear();
+    
+    // Непрерывный массив одного поля
+    template <size_t column>
+    std::span<Field<column>> Column();
+    template <size_t column>
+    std::span<const Field<column>> Column() const;
+    
+    // Сортировка строк по значению поля column
+    template <size_t column, typename Compare = std::less<>>
+    void Sort_By(Compare compare = {});
+
+private:
+    template <size_t... index>
+    void Push_Back(const Row& row, tuple::third_implementation::IndexSequence<index...>);
+    template <size_t... column>
+    Reference Get_Row(size_type index, tuple::third_implementation::IndexSequence<column...>);
+    template <size_t... column>
+    Const_Reference Get_Row(size_type index, tuple::third_implementation::IndexSequence<column...>) const;
+    template <size_t... index>
+    void Permute(const Vector<size_type>& order, tuple::third_implementation::IndexSequence<index...>);
+    
+    // Применение function к каждому столбцу
+    template <typename Function, size_t... index>
+    void For_Each_Column(Function&& function, tuple::third_implementation::IndexSequence<index...>);
+    // Удаление из столбцов элементов после size: откат частично добавленной строки
+    void Truncate(size_type size);
+
+private:
+    Columns _columns;
+};
+
+template <typename ...Fields>
+void SoA_Vector<Fields...>::Push_Back(const Row& row)
+{
+    Push_Back(row, Index());
+}
+
+template <typename ...Fields>
+template <size_t... index>
+void SoA_Vector<Fields...>::Push_Back(const Row& row, tuple::third_implementation::IndexSequence<index...>)
+{
+    using tuple::third_implementation::Get;
+    const size_type size = Size();
+    try
+    {
+        (Get<index>(_columns).Push_Back(Get<index>(row)), ...);
+    }
+    catch (...)
+    {
+        Truncate(size); // Столбцы, в которые строка уже добавлена, должны остаться одного размера с остальными
+        throw;
+    }
+}
+
+template <typename ...Fields>
+template <typename ...Args>
+void SoA_Vector<Fields...>::Emplace_Back(Args&& ...args)
+{
+    static_assert(sizeof...(Args) == sizeof...(Fields), "SoA_Vector: one argument per field is required");
+    
+    [this]<size_t... index>(tuple::third_implementation::IndexSequence<index...>, auto&& ...values)
+    {
+        using tuple::third_implementation::Get;
+        const size_type size = Size();
+        try
+        {
+            (Get<index>(_columns).Emplace_Back(std::forward<decltype(values)>(values)), ...);
+        }
+        catch (...)
+        {
+            Truncate(size);
+            throw;
+        }
+    }(Index(), std::forward<Args>(args)...);
+}
+
+template <typename ...Fields>
+void SoA_Vector<Fields...>::Pop_Back()
+{
+    if (Empty())
+        throw std::range_error("SoA_Vector is empty");
+    
+    For_Each_Column([](auto& column) { column.Pop_Back(); }, Index());
+}
+
+template <typename ...Fields>
+SoA_Vector<Fields...>::Reference SoA_Vector<Fields...>::operator[](size_type index)
+{
+    return Get_Row(index, Index());
+}
+
+template <typename ...Fields>
+SoA_Vector<Fields...>::Const_Reference SoA_Vector<Fields...>::operator[](size_type index) const
+{
+    return Get_Row(index, Index());
+}
+
+template <typename ...Fields>
+SoA_Vector<Fields...>::Reference SoA_Vector<Fields...>::At(size_type index)
+{
+    if (index >= Size())
+        throw std::out_of_range("Index is out of range!");
+    
+    return Get_Row(index, Index());
+}
+
+template <typename ...Fields>
+SoA_Vector<Fields...>::Const_Reference SoA_Vector<Fields...>::At(size_type index) const
+{
+    if (index >= Size())
+        throw std::out_of_range("Index is out of range!");
+    
+    return Get_Row(index, Index());
+}
+
+template <typename ...Fields>
+template <size_t... column>
+SoA_Vector<Fields...>::Reference SoA_Vector<Fields...>::Get_Row(size_type index, tuple::third_implementation::IndexSequence<column...>)
+{
+    using tuple::third_implementation::Get;
+    return Reference(Get<column>(_columns)[index]...);
+}
+
+template <typename ...Fields>
+template <size_t... column>
+SoA_Vector<Fields...>::Const_Reference SoA_Vector<Fields...>::Get_Row(size_type index, tuple::third_implementation::IndexSequence<column...>) const
+{
+    using tuple::third_implementation::Get;
+    return Const_Reference(Get<column>(_columns)[index]...);
+}
+
+template <typename ...Fields>
+bool SoA_Vector<Fields...>::Empty() const noexcept
+{
+    return Size() == 0;
+}
+
+template <typename ...Fields>
+SoA_Vector<Fields...>::size_type SoA_Vector<Fields...>::Size() const noexcept
+{
+    return tuple::third_implementation::Get<0>(_columns).Size(); // Все столбцы одного размера
+}
+
+template <typename ...Fields>
+void SoA_Vector<Fields...>::Reserve(size_type capacity)
+{
+    For_Each_Column([capacity](auto& column) { column.Reserve(capacity); }, Index());
+}
+
+template <typename ...Fields>
+void SoA_Vector<Fields...>::Clear()
+{
+    For_Each_Column([](auto& column) { column.Clear(); }, Index());
+}
+
+template <typename ...Fields>
+template <size_t column>
+std::span<typename SoA_Vector<Fields...>::template Field<column>> SoA_Vector<Fields...>::Column()
+{
+    auto& vector = tuple::third_implementation::Get<column>(_columns);
+    return std::span<Field<column>>(vector.Data(), vector.Size());
+}
+
+template <typename ...Fields>
+template <size_t column>
+std::span<const typename SoA_Vector<Fields...>::template Field<column>> SoA_Vector<Fields...>::Column() const
+{
+    const auto& vector = tuple::third_implementation::Get<column>(_columns);
+    return std::span<const Field<column>>(vector.Data(), vector.Size());
+}
+
+/*
+ Сортировка в 2 этапа:
+ 1. Сортируются только индексы строк по значению столбца column: сравнения идут по одному непрерывному массиву.
+ 2. Каждый столбец переставляется по отсортированным индексам.
+ Time: O(N * log(N)) сравнений + O(N * sizeof...(Fields)) перемещений
+ */
+template <typename ...Fields>
+template <size_t column, typename Compare>
+void SoA_Vector<Fields...>::Sort_By(Compare compare)
+{
+    Vector<size_type> order;
+    order.Resize_Default_Init(Size());
+    std::iota(order.Begin(), order.End(), size_type(0));
+    
+    const auto values = Column<column>();
+    std::stable_sort(order.Begin(), order.End(), [&values, &compare](size_type lhs, size_type rhs)
+    {
+        return compare(values[lhs], values[rhs]);
+    });
+    
+    Permute(order, Index());
+}
+
+template <typename ...Fields>
+template <size_t... index>
+void SoA_Vector<Fields...>::Permute(const Vector<size_type>& order, tuple::third_implementation::IndexSequence<index...>)
+{
+    using tuple::third_implementation::Get;
+    auto permute = [&order](auto& column)
+    {
+        std::remove_reference_t<decltype(column)> sorted;
+        sorted.Reserve(column.Size());
+        for (size_type i = 0, I = order.Size(); i < I; ++i)
+            sorted.Push_Back(std::move(column[order[i]]));
+        column.Swap(sorted);
+    };
+    (permute(Get<index>(_columns)), ...);
+}
+
+template <typename ...Fields>
+template <typename Function, size_t... index>
+void SoA_Vector<Fields...>::For_Each_Column(Function&& function, tuple::third_implementation::IndexSequence<index...>)
+{
+    using tuple::third_implementation::Get;
+    (function(Get<index>(_columns)), ...);
+}
+
+template <typename ...Fields>
+void SoA_Vector<Fields...>::Truncate(size_type size)
+{
+    For_Each_Column([size](auto& column)
+    {
+        while (column.Size() > size)
+            column.Pop_Back();
+    }, Index());
+}
+
+#endif /* SoA_Vector_h */
@@ -6,6 +6,7 @@
 
 #include <algorithm>
 #include <iostream>
+#include <span>
 
 /*
  Лекция: https://www.youtube.com/watch?v=kUqXNSgdd5A&ysclid=lu8lgbqu7g137468251
@@ -26,16 +27,22 @@ class Vector_Base
 public:
     Vector_Base() = default;
     
-    explicit Vector_Base(size_t capacity) :
-    _allocator(Allocator()),
+    explicit Vector_Base(size_t capacity, const Allocator& allocator = Allocator()) :
+    _allocator(allocator),
     _data(_allocator.Allocate(capacity)),
     _capacity(capacity)
     {
         
     }
     
+    explicit Vector_Base(const Allocator& allocator) noexcept :
+    _allocator(allocator)
+    {
+        
+    }
+    
     Vector_Base(Vector_Base&& other) noexcept :
-    _allocator(std::exchange(other._allocator, {})),
+    _allocator(other._allocator), // Аллокатор с состоянием (например, Arena_Allocator) должен остаться рабочим и у other
     _data(std::exchange(other._data, nullptr)), // move не работает с указателями
     _size(std::exchange(other._size, 0u)),
     _capacity(std::exchange(other._capacity, 0u))
@@ -56,7 +63,7 @@ public:
         if (this == &other) // object = object
             return *this;
         
-        _allocator = std::exchange(other._allocator, {});
+        _allocator = other._allocator;
         _data = std::exchange(other._data, nullptr); // move не работает с указателями
         _size = std::exchange(other._size, 0u);
         _capacity = std::exchange(other._capacity, 0u);
@@ -106,14 +113,14 @@ protected:
 };
 
 
-template <class T>
-class Vector : private Vector_Base<T>
+template <class T, typename Allocator = Allocator<T>>
+class Vector : private Vector_Base<T, Allocator>
 {
-    // Выносим на 2 стадию инстанцирования, чтобы можно было использовать protected члены без Vector_Base<T>
-    using Vector_Base<T>::_allocator;
-    using Vector_Base<T>::_data;
-    using Vector_Base<T>::_size;
-    using Vector_Base<T>::_capacity;
+    // Выносим на 2 стадию инстанцирования, чтобы можно было использовать protected члены без Vector_Base<T, Allocator>
+    using Vector_Base<T, Allocator>::_allocator;
+    using Vector_Base<T, Allocator>::_data;
+    using Vector_Base<T, Allocator>::_size;
+    using Vector_Base<T, Allocator>::_capacity;
     
     using size_type = size_t;
     using value_type = T;
@@ -126,13 +133,14 @@ class Vector : private Vector_Base<T>
     using const_reverse_iterator = ReverseIterator<T>;
     
     // В качестве примера можно создать аллокатор на другой тип
-    using custom_allocator = Allocator<T>::template Rebind<size_type>::other;
+    using custom_allocator = typename Allocator::template Rebind<size_type>::other;
     
 public:
     Vector() = default;
     ~Vector() = default;
-    explicit Vector(size_type count, const value_type& value = value_type()); // Вызовется на +1 больше конструктор по умолчанию!!! Обычно это выносится в отдельный конструктор
-    Vector(const std::initializer_list<T>& vector);
+    explicit Vector(const Allocator& allocator) noexcept;
+    explicit Vector(size_type count, const value_type& value = value_type(), const Allocator& allocator = Allocator()); // Вызовется на +1 больше конструктор по умолчанию!!! Обычно это выносится в отдельный конструктор
+    Vector(const std::initializer_list<T>& vector, const Allocator& allocator = Allocator());
     Vector(const Vector& other);
     Vector(Vector&& other) noexcept;
     Vector& operator=(const Vector& other);
@@ -157,6 +165,8 @@ public:
     bool Empty() const noexcept;
     size_type Size() const noexcept;
     void Resize(size_type size);
+    void Resize_Default_Init(size_type size); // Resize без заполнения новых элементов тривиальных типов
+    std::span<T> Append_Uninitialized(size_type count); // Добавление count элементов без заполнения, возвращает область для записи
     size_type Capacity() const noexcept;
     void Reserve(size_type capacity);
     void Shrink_To_Fit();
@@ -164,6 +174,7 @@ public:
     const_iterator Data() const;
     void Fill(const value_type& value);
     void Clear();
+    Allocator Get_Allocator() const noexcept;
     
     template <typename ...Args>
     iterator Emplace(const_iterator it, Args&& ...args);
@@ -188,24 +199,31 @@ private:
 };
 
 
-template <class T>
-void Vector<T>::Destroy()
+template <class T, typename Allocator>
+void Vector<T, Allocator>::Destroy()
 {
     // Перед удаление нужно вызвать деструкторы для элементов < size, для остальных элементов выделялась только сырая память
     if (_data)
     {
         for (size_type i = 0; i < _size; ++i)
             _allocator.Destructor(_data + i);
-        operator delete(_data);
+        _allocator.Deallocate(_data);
         _data = nullptr;
         _size = 0u;
         _capacity = 0u;
     }
 }
 
-template <class T>
-Vector<T>::Vector(size_type count, const T& value):
-Vector_Base<T>(count)
+template <class T, typename Allocator>
+Vector<T, Allocator>::Vector(const Allocator& allocator) noexcept:
+Vector_Base<T, Allocator>(allocator)
+{
+    
+}
+
+template <class T, typename Allocator>
+Vector<T, Allocator>::Vector(size_type count, const T& value, const Allocator& allocator):
+Vector_Base<T, Allocator>(count, allocator)
 {
     for (size_type i = 0; i < count; ++i)
     {
@@ -214,9 +232,9 @@ Vector_Base<T>(count)
     }
 }
 
-template <class T>
-Vector<T>::Vector(const std::initializer_list<T>& vector):
-Vector_Base<T>(vector.size())
+template <class T, typename Allocator>
+Vector<T, Allocator>::Vector(const std::initializer_list<T>& vector, const Allocator& allocator):
+Vector_Base<T, Allocator>(vector.size(), allocator)
 {
     for (const auto &elem : vector)
     {
@@ -225,9 +243,9 @@ Vector_Base<T>(vector.size())
     }
 }
 
-template <class T>
-Vector<T>::Vector(const Vector& other) :
-Vector_Base<T>(other._capacity)
+template <class T, typename Allocator>
+Vector<T, Allocator>::Vector(const Vector& other) :
+Vector_Base<T, Allocator>(other._capacity, other._allocator)
 {
     while (_size < other._size)
     {
@@ -237,15 +255,15 @@ Vector_Base<T>(other._capacity)
 }
 
 // Можно использовать default в C++20
-template <class T>
-Vector<T>::Vector(Vector&& other) noexcept:
-Vector_Base<T>(std::move(other))
+template <class T, typename Allocator>
+Vector<T, Allocator>::Vector(Vector&& other) noexcept:
+Vector_Base<T, Allocator>(std::move(other))
 {
     _size = std::exchange(other._size, 0u);
 }
 
-template <class T>
-Vector<T>& Vector<T>::operator=(const Vector& other)
+template <class T, typename Allocator>
+Vector<T, Allocator>& Vector<T, Allocator>::operator=(const Vector& other)
 {
     if (this == &other) // object = object
         return *this;
@@ -256,20 +274,20 @@ Vector<T>& Vector<T>::operator=(const Vector& other)
 }
 
 // Можно использовать default в C++20
-template <class T>
-Vector<T>& Vector<T>::operator=(Vector&& other) noexcept
+template <class T, typename Allocator>
+Vector<T, Allocator>& Vector<T, Allocator>::operator=(Vector&& other) noexcept
 {
     if (this == &other) // object = object
         return *this;
     
-    Vector_Base<T>::operator=(std::move(other));
+    Vector_Base<T, Allocator>::operator=(std::move(other));
     _size = std::exchange(other._size, 0u);
     
     return *this;
 }
 
-template <class T>
-bool Vector<T>::operator==(const Vector& other) const
+template <class T, typename Allocator>
+bool Vector<T, Allocator>::operator==(const Vector& other) const
 {
     if (this == &other) // object = object
         return true;
@@ -286,40 +304,40 @@ bool Vector<T>::operator==(const Vector& other) const
     return true;
 }
 
-template <class T>
-bool Vector<T>::operator!=(const Vector& other) const
+template <class T, typename Allocator>
+bool Vector<T, Allocator>::operator!=(const Vector& other) const
 {
     return !(*this == other);
 }
 
-template <class T>
-Vector<T>::reference Vector<T>::operator[](size_type index)
+template <class T, typename Allocator>
+Vector<T, Allocator>::reference Vector<T, Allocator>::operator[](size_type index)
 {
     return _data[index];
 }
 
-template <class T>
-Vector<T>::const_reference Vector<T>::operator[](size_type index) const
+template <class T, typename Allocator>
+Vector<T, Allocator>::const_reference Vector<T, Allocator>::operator[](size_type index) const
 {
     return _data[index];
 }
 
-template <class T>
-void Vector<T>::Push_Back(const T& value)
+template <class T, typename Allocator>
+void Vector<T, Allocator>::Push_Back(const T& value)
 {
     T tmp(value); // В Push_Back(T&& value) будет проверка на noexcept в перемещении, иначе будет копирование
     Emplace_Back(std::move(tmp));
 }
 
-template <class T>
-void Vector<T>::Push_Back(T&& value)
+template <class T, typename Allocator>
+void Vector<T, Allocator>::Push_Back(T&& value)
 {
     Emplace_Back(std::move(value));
 }
 
-template <class T>
+template <class T, typename Allocator>
 template <typename ...Args>
-decltype(auto) Vector<T>::Emplace_Back(Args&& ...args) // decltype(auto) - не отбрасывает ссылки и возвращает lvalue, иначе rvalue
+decltype(auto) Vector<T, Allocator>::Emplace_Back(Args&& ...args) // decltype(auto) - не отбрасывает ссылки и возвращает lvalue, иначе rvalue
 {
     if (_size == _capacity)
     {
@@ -338,18 +356,17 @@ decltype(auto) Vector<T>::Emplace_Back(Args&& ...args) // decltype(auto) - не
     return Back();
 }
 
-template <class T>
-void Vector<T>::Pop_Back()
+template <class T, typename Allocator>
+void Vector<T, Allocator>::Pop_Back()
 {
     if (Empty())
         throw std::range_error("Vector is empty");
     
-    Destructor(End());
-    --_size;
+    _allocator.Destructor(_data + --_size);
 }
 
-template <class T>
-Vector<T>::reference Vector<T>::At(size_type index)
+template <class T, typename Allocator>
+Vector<T, Allocator>::reference Vector<T, Allocator>::At(size_type index)
 {
     if (index >= _size)
         throw std::out_of_range("Index is out of range!");
@@ -357,8 +374,8 @@ Vector<T>::reference Vector<T>::At(size_type index)
     return _data[index];
 }
 
-template <class T>
-Vector<T>::const_reference Vector<T>::At(size_type index) const
+template <class T, typename Allocator>
+Vector<T, Allocator>::const_reference Vector<T, Allocator>::At(size_type index) const
 {
     if (index >= _size)
         throw std::out_of_range("Index is out of range!");
@@ -366,53 +383,53 @@ Vector<T>::const_reference Vector<T>::At(size_type index) const
     return _data[index];
 }
 
-template <class T>
-Vector<T>::reference Vector<T>::Front()
+template <class T, typename Allocator>
+Vector<T, Allocator>::reference Vector<T, Allocator>::Front()
 {
     return _data[0];
 }
 
-template <class T>
-Vector<T>::const_reference Vector<T>::Front() const
+template <class T, typename Allocator>
+Vector<T, Allocator>::const_reference Vector<T, Allocator>::Front() const
 {
     return _data[0];
 }
 
-template <class T>
-Vector<T>::reference Vector<T>::Back()
+template <class T, typename Allocator>
+Vector<T, Allocator>::reference Vector<T, Allocator>::Back()
 {
     return _data[_size - 1];
 }
 
-template <class T>
-Vector<T>::const_reference Vector<T>::Back() const
+template <class T, typename Allocator>
+Vector<T, Allocator>::const_reference Vector<T, Allocator>::Back() const
 {
     return _data[_size - 1];
 }
 
-template <class T>
-void Vector<T>::Swap(Vector& other) noexcept
+template <class T, typename Allocator>
+void Vector<T, Allocator>::Swap(Vector& other) noexcept
 {
     if (this == &other) // object.Swap(object)
         return;
     
-    Vector_Base<T>::Swap(other);
+    Vector_Base<T, Allocator>::Swap(other);
 }
 
-template <class T>
-bool Vector<T>::Empty() const noexcept
+template <class T, typename Allocator>
+bool Vector<T, Allocator>::Empty() const noexcept
 {
     return Size() == 0;
 }
 
-template <class T>
-Vector<T>::size_type Vector<T>::Size() const noexcept
+template <class T, typename Allocator>
+Vector<T, Allocator>::size_type Vector<T, Allocator>::Size() const noexcept
 {
     return _size;
 }
 
-template <class T>
-void Vector<T>::Resize(size_type size)
+template <class T, typename Allocator>
+void Vector<T, Allocator>::Resize(size_type size)
 {
     if (size < _size)
     {
@@ -421,8 +438,8 @@ void Vector<T>::Resize(size_type size)
          std::destroy_n(_data + size, _size - size);
          */
         {
-            while (_size-- < size)
-                Destructor(_data + _size);
+            while (size < _size)
+                _allocator.Destructor(_data + --_size);
         }
     } 
     else if (_size < size)
@@ -435,27 +452,73 @@ void Vector<T>::Resize(size_type size)
         {
             while (_size < size)
             {
-                Constructor(_data + _size); // Вызов конструктора по умолчанию
+                _allocator.Constructor(_data + _size); // Вызов конструктора по умолчанию
                 ++_size;
             }
         }
     }
 }
 
-template <class T>
-Vector<T>::size_type Vector<T>::Capacity() const noexcept
+/*
+ В отличии от Resize новые элементы тривиальных типов не инициализируются (default-initialization: new (ptr) T), а не заполняются значением (value-initialization: new (ptr) T()).
+ Для тривиальных типов (char, int, float) память не заполняется нулями: экономится целый проход записи по буферу, который все равно будет перезаписан (read, декодирование). Значения таких элементов не определены до записи.
+ Для нетривиальных типов вызывается конструктор по умолчанию через _allocator.Constructor, как и в Resize: аллокатор с состоянием видит каждое конструирование.
+ */
+template <class T, typename Allocator>
+void Vector<T, Allocator>::Resize_Default_Init(size_type size)
+{
+    if (size <= _size)
+    {
+        Resize(size);
+        return;
+    }
+    
+    Reserve(size);
+    /*
+     Делает тоже самое, что и ниже
+     std::uninitialized_default_construct_n(_data + _size, size - _size);
+     */
+    {
+        if constexpr (std::is_trivially_default_constructible_v<T>)
+        {
+            _size = size; // Память не трогаем
+        }
+        else
+        {
+            while (_size < size)
+            {
+                _allocator.Constructor(_data + _size);
+                ++_size;
+            }
+        }
+    }
+}
+
+// Добавление count элементов в конец без заполнения, рост емкости как у Push_Back - в 2 раза, чтобы серия вызовов выполнялась за амортизированное O(1) на элемент
+template <class T, typename Allocator>
+std::span<T> Vector<T, Allocator>::Append_Uninitialized(size_type count)
+{
+    const size_type size = _size;
+    if (_size + count > _capacity)
+        Reserve(std::max(_size + count, _capacity * 2));
+    Resize_Default_Init(_size + count);
+    return std::span<T>(_data + size, count);
+}
+
+template <class T, typename Allocator>
+Vector<T, Allocator>::size_type Vector<T, Allocator>::Capacity() const noexcept
 {
     return _capacity;
 }
 
-template <class T>
-void Vector<T>::Reserve(size_type capacity)
+template <class T, typename Allocator>
+void Vector<T, Allocator>::Reserve(size_type capacity)
 {
     if (capacity <= Capacity())
         return;
     
-    Vector_Base<T> tmp(capacity);
-    auto& tmp_size = reinterpret_cast<Vector<T>&>(tmp)._size;
+    Vector_Base<T, Allocator> tmp(capacity, _allocator);
+    auto& tmp_size = reinterpret_cast<Vector<T, Allocator>&>(tmp)._size;
     
     /*
      Делает тоже самое, что и ниже
@@ -495,13 +558,13 @@ void Vector<T>::Reserve(size_type capacity)
     tmp.Swap(*this);
 }
 
-template <class T>
-void Vector<T>::Shrink_To_Fit()
+template <class T, typename Allocator>
+void Vector<T, Allocator>::Shrink_To_Fit()
 {
     if (_capacity > _size)
     {
-        Vector_Base<T> tmp(_capacity = _size);
-        auto& tmp_size = reinterpret_cast<Vector<T>&>(tmp)._size;
+        Vector_Base<T, Allocator> tmp(_capacity = _size, _allocator);
+        auto& tmp_size = reinterpret_cast<Vector<T, Allocator>&>(tmp)._size;
         
         /*
          Делает тоже самое, что и ниже
@@ -542,34 +605,40 @@ void Vector<T>::Shrink_To_Fit()
     }
 }
 
-template <class T>
-Vector<T>::iterator Vector<T>::Data()
+template <class T, typename Allocator>
+Vector<T, Allocator>::iterator Vector<T, Allocator>::Data()
 {
     return _data;
 }
 
-template <class T>
-Vector<T>::const_iterator Vector<T>::Data() const
+template <class T, typename Allocator>
+Vector<T, Allocator>::const_iterator Vector<T, Allocator>::Data() const
 {
     return _data;
 }
 
-template <class T>
-void Vector<T>::Fill(const value_type& value)
+template <class T, typename Allocator>
+void Vector<T, Allocator>::Fill(const value_type& value)
 {
     for (size_type i = 0; i < _size; ++i)
         _data[i] = value;
 }
 
-template <class T>
-void Vector<T>::Clear()
+template <class T, typename Allocator>
+void Vector<T, Allocator>::Clear()
 {
     Destroy();
 }
 
-template <class T>
+template <class T, typename Allocator>
+Allocator Vector<T, Allocator>::Get_Allocator() const noexcept
+{
+    return _allocator;
+}
+
+template <class T, typename Allocator>
 template <typename ...Args>
-Vector<T>::iterator Vector<T>::Emplace(Vector<T>::const_iterator it, Args&& ...args)
+Vector<T, Allocator>::iterator Vector<T, Allocator>::Emplace(Vector<T, Allocator>::const_iterator it, Args&& ...args)
 {
     size_type index = static_cast<size_type>(it - Begin());
     
@@ -579,9 +648,9 @@ Vector<T>::iterator Vector<T>::Emplace(Vector<T>::const_iterator it, Args&& ...a
     }
     if (_size == Capacity())
     {
-        Vector_Base<T> tmp(_size * 2 + 1); // +1 потому что может быть 0
-        auto& tmp_size = reinterpret_cast<Vector<T>&>(tmp)._size;
-        new (tmp + index) T(std::forward<Args>(args)...);
+        Vector_Base<T, Allocator> tmp(_size * 2 + 1, _allocator); // +1 потому что может быть 0
+        auto& tmp_size = reinterpret_cast<Vector<T, Allocator>&>(tmp)._size;
+        _allocator.Constructor(tmp + index, std::forward<Args>(args)...);
         // Делает тоже самое, что и ниже
         /*
          if constexpr (std::is_nothrow_move_constructible_v<T> || !std::is_copy_constructible_v<T>)
@@ -672,14 +741,14 @@ Vector<T>::iterator Vector<T>::Emplace(Vector<T>::const_iterator it, Args&& ...a
     return Begin() + index;
 }
 
-template <class T>
-Vector<T>::iterator Vector<T>::Insert(Vector<T>::const_iterator it, const T& value)
+template <class T, typename Allocator>
+Vector<T, Allocator>::iterator Vector<T, Allocator>::Insert(Vector<T, Allocator>::const_iterator it, const T& value)
 {
     return Emplace(it, value);
 }
 
-template <class T>
-Vector<T>::iterator Vector<T>::Erase(Vector<T>::const_iterator it)
+template <class T, typename Allocator>
+Vector<T, Allocator>::iterator Vector<T, Allocator>::Erase(Vector<T, Allocator>::const_iterator it)
 {
     if (Empty())
         throw std::range_error("Vector is empty");
@@ -690,79 +759,79 @@ Vector<T>::iterator Vector<T>::Erase(Vector<T>::const_iterator it)
     --_size;
     if (_size == 0)
     {
-        operator delete(_data);
+        _allocator.Deallocate(_data);
         _data = nullptr;
         _capacity = 0;
     }
     return Begin() + index;
 }
 
-template <class T>
-Vector<T>::iterator Vector<T>::Erase(Vector<T>::const_iterator begin, Vector<T>::const_iterator end)
+template <class T, typename Allocator>
+Vector<T, Allocator>::iterator Vector<T, Allocator>::Erase(Vector<T, Allocator>::const_iterator begin, Vector<T, Allocator>::const_iterator end)
 {
     size_t index = static_cast<size_t>(end - begin);
-    auto it = Vector<T>::iterator(begin);
+    auto it = Vector<T, Allocator>::iterator(begin);
     while (index-- > 0)
         it = Erase(it);
     return it;
 }
 
-template <class T>
-Vector<T>::iterator Vector<T>::Begin()
+template <class T, typename Allocator>
+Vector<T, Allocator>::iterator Vector<T, Allocator>::Begin()
 {
     return iterator(_data);
 };
 
-template <class T>
-Vector<T>::iterator Vector<T>::End() noexcept
+template <class T, typename Allocator>
+Vector<T, Allocator>::iterator Vector<T, Allocator>::End() noexcept
 {
     return iterator(_data + _size);
 };
 
-template <class T>
-Vector<T>::const_iterator Vector<T>::Begin() const noexcept
+template <class T, typename Allocator>
+Vector<T, Allocator>::const_iterator Vector<T, Allocator>::Begin() const noexcept
 {
     return const_iterator(_data);
 };
 
-template <class T>
-Vector<T>::const_iterator Vector<T>::End() const noexcept
+template <class T, typename Allocator>
+Vector<T, Allocator>::const_iterator Vector<T, Allocator>::End() const noexcept
 {
     return const_iterator(_data + _size);
 };
 
-template <class T>
-Vector<T>::const_iterator Vector<T>::CBegin() const noexcept
+template <class T, typename Allocator>
+Vector<T, Allocator>::const_iterator Vector<T, Allocator>::CBegin() const noexcept
 {
     return Begin();
 };
 
-template <class T>
-Vector<T>::const_iterator Vector<T>::CEnd() const noexcept
+template <class T, typename Allocator>
+Vector<T, Allocator>::const_iterator Vector<T, Allocator>::CEnd() const noexcept
 {
     return End();
 };
 
-template <class T>
-Vector<T>::reverse_iterator Vector<T>::RBegin()
+template <class T, typename Allocator>
+Vector<T, Allocator>::reverse_iterator Vector<T, Allocator>::RBegin()
 {
     return reverse_iterator(&_data[0] + _size - 1);
 }
 
-template <class T>
-Vector<T>::reverse_iterator Vector<T>::REnd()
+template <class T, typename Allocator>
+Vector<T, Allocator>::reverse_iterator Vector<T, Allocator>::REnd()
 {
     return reverse_iterator(&_data[0] - 1);
 }
 
-template <class T>
-Vector<T>::const_reverse_iterator Vector<T>::CRBegin() const noexcept
+template <class T, typename Allocator>
+Vector<T, Allocator>::const_reverse_iterator Vector<T, Allocator>::CRBegin() const noexcept
 {
     return const_reverse_iterator(&_data[0] + _size - 1);
 }
 
-template <class T>
-Vector<T>::const_reverse_iterator Vector<T>::CREnd() const noexcept
+template <class T, typename Allocator>
+Vector<T, Allocator>::const_reverse_iterator Vector<T, Allocator>::CREnd() const noexcept
 {
     return const_reverse_iterator(&_data[0] - 1);
 }
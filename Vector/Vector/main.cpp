@@ -1,3 +1,10 @@
+#include "Arena_Allocator.h"
+#include "Huge_Page_Allocator.h"
+#include "Parallel_Algorithms.h"
+#include "Pool_Allocator.h"
+#include "Segmented_Vector.h"
+#include "SoA_Vector.h"
+#include "Timer.h"
 #include "VectorBool.h"
 
 #include <vector>
@@ -66,6 +73,21 @@ private:
 };
 
 
+// Обработка одного "запроса": несколько временных Vector, которые растут через Push_Back
+template <class Allocator>
+size_t Request(const Allocator& allocator, size_t vectors, size_t elements)
+{
+    size_t sum = 0;
+    for (size_t i = 0; i < vectors; ++i)
+    {
+        Vector<int, Allocator> vector(allocator);
+        for (size_t j = 0; j < elements; ++j)
+            vector.Push_Back(int(j));
+        sum += vector.Size();
+    }
+    return sum;
+}
+
 int main()
 {
     // Vector
@@ -183,6 +205,279 @@ int main()
         examples_copy.Swap(examples_move);
     }
     
+    // Allocators
+    {
+        static constexpr size_t requests = 2000;
+        static constexpr size_t vectors = 16;
+        static constexpr size_t elements = 256;
+        
+        Timer timer;
+        size_t sum = 0;
+        
+        timer.start();
+        for (size_t i = 0; i < requests; ++i)
+            sum += Request(Allocator<int>(), vectors, elements);
+        timer.stop();
+        std::cout << "Allocator: " << timer.elapsedMilliseconds() << " ms" << std::endl;
+        
+        Arena arena;
+        timer.start();
+        for (size_t i = 0; i < requests; ++i)
+        {
+            sum += Request(Arena_Allocator<int>(arena), vectors, elements);
+            arena.Reset(); // вся память запроса освобождается разом
+        }
+        timer.stop();
+        std::cout << "Arena_Allocator: " << timer.elapsedMilliseconds() << " ms" << std::endl;
+        
+        timer.start();
+        for (size_t i = 0; i < requests; ++i)
+            sum += Request(Pool_Allocator<int>(), vectors, elements);
+        timer.stop();
+        std::cout << "Pool_Allocator: " << timer.elapsedMilliseconds() << " ms" << std::endl;
+        
+        // Huge pages выигрывают на больших буферах со случайным доступом
+        static constexpr size_t huge_size = 64 * 1024 * 1024 / sizeof(int);
+        static constexpr size_t accesses = 1 << 22;
+        auto random_access = [&timer](const auto& vector, const std::string& name)
+        {
+            size_t sum = 0, index = 0;
+            timer.start();
+            for (size_t i = 0; i < accesses; ++i)
+            {
+                index = (index * 1103515245 + 12345) % huge_size;
+                sum += vector[index];
+            }
+            timer.stop();
+            std::cout << name << " random access: " << timer.elapsedMilliseconds() << " ms" << std::endl;
+            return sum;
+        };
+        sum += random_access(Vector<int>(huge_size), "Allocator");
+        sum += random_access(Vector<int, Huge_Page_Allocator<int>>(huge_size), "Huge_Page_Allocator");
+        std::cout << "sum: " << sum << std::endl;
+        
+        // Rebind: аллокатор для другого типа с той же ареной
+        using Rebind_Allocator = Arena_Allocator<int>::Rebind<double>::other;
+        Rebind_Allocator rebind = Arena_Allocator<int>(arena);
+        Vector<double, Arena_Allocator<double>> doubles(rebind);
+        doubles.Push_Back(1.0);
+    }
+    
+    // Parallel algorithms
+    {
+        static constexpr size_t size = 1 << 22;
+        
+        std::cout << "threads: " << parallel::Threads(size) << std::endl;
+        Timer timer;
+        Vector<int> input(size);
+        Vector<int> output(size);
+        
+        timer.start();
+        std::fill(input.Begin(), input.End(), 1);
+        timer.stop();
+        std::cout << "std::fill: " << timer.elapsedMilliseconds() << " ms" << std::endl;
+        timer.start();
+        Parallel_Fill(input, 1);
+        timer.stop();
+        std::cout << "Parallel_Fill: " << timer.elapsedMilliseconds() << " ms" << std::endl;
+        
+        auto square = [](int value) { return value * value; };
+        timer.start();
+        std::transform(input.Begin(), input.End(), output.Begin(), square);
+        timer.stop();
+        std::cout << "std::transform: " << timer.elapsedMilliseconds() << " ms" << std::endl;
+        timer.start();
+        Parallel_Transform(input, output, square);
+        timer.stop();
+        std::cout << "Parallel_Transform: " << timer.elapsedMilliseconds() << " ms" << std::endl;
+        
+        Parallel_For(output, [](int& value) { ++value; });
+        timer.start();
+        [[maybe_unused]] auto sum1 = std::accumulate(output.Begin(), output.End(), size_t(0));
+        timer.stop();
+        std::cout << "std::accumulate: " << timer.elapsedMilliseconds() << " ms" << std::endl;
+        timer.start();
+        [[maybe_unused]] auto sum2 = Parallel_Reduce(output, size_t(0));
+        timer.stop();
+        std::cout << "Parallel_Reduce: " << timer.elapsedMilliseconds() << " ms, equal: " << (sum1 == sum2) << std::endl;
+        
+        for (size_t i = 0; i < size; ++i)
+            input[i] = output[i] = int((i * 2654435761u) % size);
+        timer.start();
+        std::sort(input.Begin(), input.End());
+        timer.stop();
+        std::cout << "std::sort: " << timer.elapsedMilliseconds() << " ms" << std::endl;
+        timer.start();
+        Parallel_Sort(output);
+        timer.stop();
+        std::cout << "Parallel_Sort: " << timer.elapsedMilliseconds() << " ms, equal: " << (input == output) << std::endl;
+    }
+    
+    // Resize_Default_Init
+    {
+        static constexpr size_t size = 256 * 1024 * 1024;
+        static constexpr size_t chunk_size = 64 * 1024;
+        
+        Timer timer;
+        // Эмуляция read: данные копируются в буфер и перезаписывают его полностью
+        auto read = [](std::span<char> span) { std::fill(span.begin(), span.end(), 'a'); };
+        {
+            timer.start();
+            Vector<char> buffer;
+            buffer.Resize(size); // Заполнение нулями + запись данных = 2 прохода по памяти
+            read(std::span<char>(buffer.Data(), buffer.Size()));
+            timer.stop();
+            std::cout << "Resize + read: " << timer.elapsedMilliseconds() << " ms" << std::endl;
+        }
+        {
+            timer.start();
+            Vector<char> buffer;
+            buffer.Resize_Default_Init(size); // Только запись данных = 1 проход по памяти
+            read(std::span<char>(buffer.Data(), buffer.Size()));
+            timer.stop();
+            std::cout << "Resize_Default_Init + read: " << timer.elapsedMilliseconds() << " ms" << std::endl;
+        }
+        {
+            timer.start();
+            Vector<char> buffer;
+            buffer.Reserve(size); // Размер полезной нагрузки известен из заголовка
+            for (size_t i = 0; i < size / chunk_size; ++i)
+                read(buffer.Append_Uninitialized(chunk_size)); // Декодирование по частям
+            timer.stop();
+            std::cout << "Append_Uninitialized + read: " << timer.elapsedMilliseconds() << " ms" << std::endl;
+        }
+    }
+    
+    // SoA_Vector
+    {
+        using namespace tuple::third_implementation;
+        
+        SoA_Vector<int, std::string, double> soa;
+        soa.Push_Back(Make_Tuple(3, std::string("three"), 3.0));
+        soa.Emplace_Back(1, "one", 1.0);
+        soa.Emplace_Back(2, "two", 2.0);
+        Get<2>(soa[2]) *= 10; // proxy-ссылка на строку
+        soa.Sort_By<0>();
+        std::cout << "SoA_Vector: ";
+        for (size_t i = 0; i < soa.Size(); ++i)
+            std::cout << "(" << Get<0>(soa[i]) << ", " << Get<1>(soa[i]) << ", " << Get<2>(soa[i]) << ") ";
+        std::cout << std::endl;
+        
+        struct Particle
+        {
+            float x, y, z;
+            float vx, vy, vz;
+            double mass;
+            int id;
+        };
+        
+        static constexpr size_t size = 1 << 22;
+        static constexpr size_t repeats = 10;
+        
+        Vector<Particle> aos;
+        SoA_Vector<float, float, float, float, float, float, double, int> particles;
+        aos.Reserve(size);
+        particles.Reserve(size);
+        for (size_t i = 0; i < size; ++i)
+        {
+            const float value = float(i % 1000);
+            aos.Push_Back(Particle{value, value, value, 1.f, 1.f, 1.f, 1.0, int(i)});
+            particles.Emplace_Back(value, value, value, 1.f, 1.f, 1.f, 1.0, int(i));
+        }
+        
+        Timer timer;
+        long long sum1 = 0, sum2 = 0;
+        timer.start();
+        for (size_t repeat = 0; repeat < repeats; ++repeat)
+            for (size_t i = 0; i < size; ++i)
+                sum1 += aos[i].id; // В кэш загружается вся структура Particle (40 байт) ради 4 байт
+        timer.stop();
+        std::cout << "AoS scan: " << timer.elapsedMilliseconds() << " ms" << std::endl;
+        
+        timer.start();
+        for (size_t repeat = 0; repeat < repeats; ++repeat)
+            for (int id : particles.Column<7>())
+                sum2 += id; // Столбец id лежит подряд
+        timer.stop();
+        std::cout << "SoA scan: " << timer.elapsedMilliseconds() << " ms, equal: " << (sum1 == sum2) << std::endl;
+        
+        timer.start();
+        for (size_t i = 0; i < size; ++i)
+            aos[i].x += aos[i].vx;
+        timer.stop();
+        std::cout << "AoS update: " << timer.elapsedMilliseconds() << " ms" << std::endl;
+        
+        timer.start();
+        {
+            auto x = particles.Column<0>();
+            auto vx = particles.Column<3>();
+            for (size_t i = 0; i < size; ++i)
+                x[i] += vx[i]; // Автовекторизация: x[i..i+7] += vx[i..i+7]
+        }
+        timer.stop();
+        std::cout << "SoA update: " << timer.elapsedMilliseconds() << " ms" << std::endl;
+    }
+    
+    // Segmented_Vector
+    {
+        static constexpr size_t size = 1 << 23;
+        static constexpr size_t accesses = 1 << 22;
+        
+        Timer timer;
+        Vector<size_t> vector;
+        timer.start();
+        for (size_t i = 0; i < size; ++i)
+            vector.Push_Back(i); // При росте все элементы копируются в новый буфер
+        timer.stop();
+        std::cout << "Vector append: " << timer.elapsedMilliseconds() << " ms" << std::endl;
+        
+        Segmented_Vector<size_t> segmented;
+        timer.start();
+        for (size_t i = 0; i < size; ++i)
+            segmented.Push_Back(i); // Выделяется только новый чанк
+        timer.stop();
+        std::cout << "Segmented_Vector append: " << timer.elapsedMilliseconds() << " ms" << std::endl;
+        
+        auto random_access = [&timer](auto& container, const std::string& name)
+        {
+            size_t sum = 0, index = 0;
+            timer.start();
+            for (size_t i = 0; i < accesses; ++i)
+            {
+                index = (index * 1103515245 + 12345) % size;
+                sum += container[index];
+            }
+            timer.stop();
+            std::cout << name << " random access: " << timer.elapsedMilliseconds() << " ms" << std::endl;
+            return sum;
+        };
+        const auto sum1 = random_access(vector, "Vector");
+        const auto sum2 = random_access(segmented, "Segmented_Vector");
+        std::cout << "equal: " << (sum1 == sum2) << std::endl;
+        
+        // Один писатель и читатель без блокировок: ссылка на элемент не инвалидируется при росте
+        Segmented_Vector<size_t> log;
+        const size_t& first = log.Emplace_Back(0);
+        std::jthread reader([&log]()
+        {
+            size_t read = 0;
+            while (read < size)
+            {
+                for (size_t size = log.Size(); read < size; ++read)
+                {
+                    if (log[read] != read)
+                        std::cout << "Segmented_Vector: wrong value" << std::endl;
+                }
+            }
+        });
+        for (size_t i = 1; i < size; ++i)
+            log.Emplace_Back(i);
+        reader.join();
+        std::cout << "Segmented_Vector: first: " << first << ", chunks: " << log.Chunks();
+        log.Release_Front(size / 2); // Освобождение старых записей
+        std::cout << ", after Release_Front: " << log.Chunks() << ", front: " << log.Front() << std::endl;
+    }
+    
     // massive
     {
         using namespace massive;